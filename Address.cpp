@@ -0,0 +1,229 @@
+// Bitcoin address encodings
+#include "Address.h"
+#include "SHA256.h"
+#include "RIPEMD160.h"
+#include <string.h>
+#include <vector>
+using namespace std;
+
+static const char base58[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static const char bech32[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+void hash160(const uint8_t *data, size_t len, uint8_t out[20])
+{
+	uint8_t sha[32];
+	computeSHA256(data, len, sha);
+	computeRIPEMD160(sha, 32, out);
+}
+
+// Base58 by repeated division of the byte string
+static string encodeBase58(const uint8_t *data, size_t len)
+{
+	size_t zeros = 0;
+	while (zeros < len && data[zeros] == 0)
+		zeros++;
+	vector<uint8_t> digits(len * 138 / 100 + 1, 0);
+	size_t used = 0;
+	for (size_t i=zeros; i<len; i++)
+	{
+		int carry = data[i];
+		size_t j = 0;
+		for (; j<used || carry; j++)
+		{
+			carry += 256 * digits[j];
+			digits[j] = carry % 58;
+			carry /= 58;
+		}
+		used = j;
+	}
+	string out(zeros, '1');
+	for (size_t i=used; i-- > 0;)
+		out += base58[digits[i]];
+	return out;
+}
+
+string base58Check(const uint8_t *payload, size_t len)
+{
+	vector<uint8_t> buf(payload, payload + len);
+	uint8_t sha[32];
+	computeSHA256(payload, len, sha);
+	computeSHA256(sha, 32, sha);
+	buf.insert(buf.end(), sha, sha + 4);
+	return encodeBase58(buf.data(), buf.size());
+}
+
+int decodeBase58Check(const string &str, uint8_t *out, size_t max)
+{
+	size_t zeros = 0;
+	while (zeros < str.size() && str[zeros] == '1')
+		zeros++;
+	vector<uint8_t> bytes(str.size() * 733 / 1000 + 1, 0);
+	size_t used = 0;
+	for (size_t i=zeros; i<str.size(); i++)
+	{
+		const char *p = strchr(base58, str[i]);
+		if (p == NULL || *p == 0)
+			return -1;
+		int carry = p - base58;
+		size_t j = 0;
+		for (; j<used || carry; j++)
+		{
+			carry += 58 * bytes[j];
+			bytes[j] = carry & 255;
+			carry >>= 8;
+		}
+		used = j;
+	}
+	vector<uint8_t> buf(zeros, 0);
+	for (size_t i=used; i-- > 0;)
+		buf.push_back(bytes[i]);
+	if (buf.size() < 4 || buf.size() - 4 > max)
+		return -1;
+	size_t len = buf.size() - 4;
+	uint8_t sha[32];
+	computeSHA256(buf.data(), len, sha);
+	computeSHA256(sha, 32, sha);
+	if (memcmp(sha, buf.data() + len, 4) != 0)
+		return -1;
+	memcpy(out, buf.data(), len);
+	return len;
+}
+
+static uint32_t bech32Polymod(const vector<uint8_t> &values)
+{
+	static const uint32_t gen[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+	uint32_t chk = 1;
+	for (size_t i=0; i<values.size(); i++)
+	{
+		uint8_t top = chk >> 25;
+		chk = ((chk & 0x1ffffff) << 5) ^ values[i];
+		for (int j=0; j<5; j++)
+			if ((top >> j) & 1)
+				chk ^= gen[j];
+	}
+	return chk;
+}
+
+string segwitAddr(const char *hrp, int version, const uint8_t *program, size_t len)
+{
+	// Data part: version followed by the program regrouped in 5 bit words
+	vector<uint8_t> data(1, version);
+	uint32_t acc = 0;
+	int bits = 0;
+	for (size_t i=0; i<len; i++)
+	{
+		acc = (acc << 8) | program[i];
+		bits += 8;
+		while (bits >= 5)
+		{
+			bits -= 5;
+			data.push_back((acc >> bits) & 31);
+		}
+	}
+	if (bits)
+		data.push_back((acc << (5 - bits)) & 31);
+
+	// Checksum over the expanded hrp, the data and six zeros (bech32 for v0, bech32m after)
+	size_t hrpLen = strlen(hrp);
+	vector<uint8_t> values;
+	for (size_t i=0; i<hrpLen; i++)
+		values.push_back(hrp[i] >> 5);
+	values.push_back(0);
+	for (size_t i=0; i<hrpLen; i++)
+		values.push_back(hrp[i] & 31);
+	values.insert(values.end(), data.begin(), data.end());
+	values.insert(values.end(), 6, 0);
+	uint32_t constant = version == 0 ? 1 : 0x2bc830a3;
+	uint32_t mod = bech32Polymod(values) ^ constant;
+
+	string out = string(hrp) + "1";
+	for (size_t i=0; i<data.size(); i++)
+		out += bech32[data[i]];
+	for (int i=0; i<6; i++)
+		out += bech32[(mod >> (5 * (5 - i))) & 31];
+	return out;
+}
+
+int decodeSegwitAddr(const char *hrp, const string &addr, int &version, uint8_t *program, size_t max)
+{
+	// Lower case only (mixed case is invalid, upper case is rare in dumps)
+	size_t hrpLen = strlen(hrp);
+	if (addr.size() < hrpLen + 8 || addr.size() > 90 || addr.compare(0, hrpLen, hrp) != 0 || addr[hrpLen] != '1')
+		return -1;
+	vector<uint8_t> values;
+	for (size_t i=0; i<hrpLen; i++)
+		values.push_back(hrp[i] >> 5);
+	values.push_back(0);
+	for (size_t i=0; i<hrpLen; i++)
+		values.push_back(hrp[i] & 31);
+	vector<uint8_t> data;
+	for (size_t i=hrpLen+1; i<addr.size(); i++)
+	{
+		const char *p = strchr(bech32, addr[i]);
+		if (p == NULL || *p == 0)
+			return -1;
+		data.push_back(p - bech32);
+	}
+	values.insert(values.end(), data.begin(), data.end());
+	version = data[0];
+	uint32_t constant = version == 0 ? 1 : 0x2bc830a3;
+	if (version > 16 || bech32Polymod(values) != constant)
+		return -1;
+
+	// Regroup the 5 bit words between the version and the checksum into bytes
+	uint32_t acc = 0;
+	int bits = 0;
+	size_t len = 0;
+	for (size_t i=1; i+6<data.size(); i++)
+	{
+		acc = (acc << 5) | data[i];
+		bits += 5;
+		if (bits >= 8)
+		{
+			bits -= 8;
+			if (len == max)
+				return -1;
+			program[len++] = (acc >> bits) & 255;
+		}
+	}
+	if (bits >= 5 || ((acc << (8 - bits)) & 255) || len < 2 || len > 40)
+		return -1;
+	return len;
+}
+
+string addrP2PKH(const uint8_t pub[33])
+{
+	uint8_t payload[21];
+	payload[0] = 0x00;
+	hash160(pub, 33, payload + 1);
+	return base58Check(payload, 21);
+}
+
+string addrP2SHP2WPKH(const uint8_t pub[33])
+{
+	// redeemScript = OP_0 <20 byte key hash>
+	uint8_t script[22];
+	script[0] = 0x00;
+	script[1] = 0x14;
+	hash160(pub, 33, script + 2);
+	uint8_t payload[21];
+	payload[0] = 0x05;
+	hash160(script, 22, payload + 1);
+	return base58Check(payload, 21);
+}
+
+string addrP2WPKH(const uint8_t pub[33])
+{
+	uint8_t keyHash[20];
+	hash160(pub, 33, keyHash);
+	return segwitAddr("bc", 0, keyHash, 20);
+}
+
+string wifCompressed(const uint8_t sk[32])
+{
+	uint8_t payload[34];
+	payload[0] = 0x80;
+	memcpy(payload + 1, sk, 32);
+	payload[33] = 0x01;
+	return base58Check(payload, 34);
+}
@@ -0,0 +1,34 @@
+#ifndef ADDRESS_H
+
+#define ADDRESS_H
+
+// Bitcoin address encodings working on raw bytes: hash160, Base58Check and Bech32 (BIP173).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// ripemd160(sha256(x))
+void hash160(const uint8_t *data, size_t len, uint8_t out[20]);
+
+// Base58 of payload || first 4 bytes of sha256(sha256(payload))
+std::string base58Check(const uint8_t *payload, size_t len);
+
+// Decode Base58Check into out (at most max bytes). Returns the payload length, or -1 if invalid.
+int decodeBase58Check(const std::string &str, uint8_t *out, size_t max);
+
+// Segwit address for a witness program, e.g. hrp "bc", version 0 and a 20 byte key hash
+std::string segwitAddr(const char *hrp, int version, const uint8_t *program, size_t len);
+
+// Decode a segwit address with the given hrp. Returns the program length, or -1 if invalid.
+int decodeSegwitAddr(const char *hrp, const std::string &addr, int &version, uint8_t *program, size_t max);
+
+// Addresses of a compressed public key
+std::string addrP2PKH(const uint8_t pub[33]);       // 1...
+std::string addrP2SHP2WPKH(const uint8_t pub[33]);  // 3... as printed by main()
+std::string addrP2WPKH(const uint8_t pub[33]);      // bc1q...
+
+// Private key in Wallet Import Format (compressed)
+std::string wifCompressed(const uint8_t sk[32]);
+
+#endif
@@ -3,2067 +3,414 @@
 
 // Words used by BIP39
 // Author: Saulo Fonseca <fonseca@astrotown.de>
+#include <array>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include "SHA256.h"
 using namespace std;
-	
-string getWord(int idx)
+
+// English wordlist, sorted. Every word is unique in its first 4 letters.
+constexpr string_view bip39Words[2048] = {
+	"abandon", "ability", "able", "about", "above", "absent", "absorb", "abstract",
+	"absurd", "abuse", "access", "accident", "account", "accuse", "achieve", "acid",
+	"acoustic", "acquire", "across", "act", "action", "actor", "actress", "actual",
+	"adapt", "add", "addict", "address", "adjust", "admit", "adult", "advance",
+	"advice", "aerobic", "affair", "afford", "afraid", "again", "age", "agent",
+	"agree", "ahead", "aim", "air", "airport", "aisle", "alarm", "album",
+	"alcohol", "alert", "alien", "all", "alley", "allow", "almost", "alone",
+	"alpha", "already", "also", "alter", "always", "amateur", "amazing", "among",
+	"amount", "amused", "analyst", "anchor", "ancient", "anger", "angle", "angry",
+	"animal", "ankle", "announce", "annual", "another", "answer", "antenna", "antique",
+	"anxiety", "any", "apart", "apology", "appear", "apple", "approve", "april",
+	"arch", "arctic", "area", "arena", "argue", "arm", "armed", "armor",
+	"army", "around", "arrange", "arrest", "arrive", "arrow", "art", "artefact",
+	"artist", "artwork", "ask", "aspect", "assault", "asset", "assist", "assume",
+	"asthma", "athlete", "atom", "attack", "attend", "attitude", "attract", "auction",
+	"audit", "august", "aunt", "author", "auto", "autumn", "average", "avocado",
+	"avoid", "awake", "aware", "away", "awesome", "awful", "awkward", "axis",
+	"baby", "bachelor", "bacon", "badge", "bag", "balance", "balcony", "ball",
+	"bamboo", "banana", "banner", "bar", "barely", "bargain", "barrel", "base",
+	"basic", "basket", "battle", "beach", "bean", "beauty", "because", "become",
+	"beef", "before", "begin", "behave", "behind", "believe", "below", "belt",
+	"bench", "benefit", "best", "betray", "better", "between", "beyond", "bicycle",
+	"bid", "bike", "bind", "biology", "bird", "birth", "bitter", "black",
+	"blade", "blame", "blanket", "blast", "bleak", "bless", "blind", "blood",
+	"blossom", "blouse", "blue", "blur", "blush", "board", "boat", "body",
+	"boil", "bomb", "bone", "bonus", "book", "boost", "border", "boring",
+	"borrow", "boss", "bottom", "bounce", "box", "boy", "bracket", "brain",
+	"brand", "brass", "brave", "bread", "breeze", "brick", "bridge", "brief",
+	"bright", "bring", "brisk", "broccoli", "broken", "bronze", "broom", "brother",
+	"brown", "brush", "bubble", "buddy", "budget", "buffalo", "build", "bulb",
+	"bulk", "bullet", "bundle", "bunker", "burden", "burger", "burst", "bus",
+	"business", "busy", "butter", "buyer", "buzz", "cabbage", "cabin", "cable",
+	"cactus", "cage", "cake", "call", "calm", "camera", "camp", "can",
+	"canal", "cancel", "candy", "cannon", "canoe", "canvas", "canyon", "capable",
+	"capital", "captain", "car", "carbon", "card", "cargo", "carpet", "carry",
+	"cart", "case", "cash", "casino", "castle", "casual", "cat", "catalog",
+	"catch", "category", "cattle", "caught", "cause", "caution", "cave", "ceiling",
+	"celery", "cement", "census", "century", "cereal", "certain", "chair", "chalk",
+	"champion", "change", "chaos", "chapter", "charge", "chase", "chat", "cheap",
+	"check", "cheese", "chef", "cherry", "chest", "chicken", "chief", "child",
+	"chimney", "choice", "choose", "chronic", "chuckle", "chunk", "churn", "cigar",
+	"cinnamon", "circle", "citizen", "city", "civil", "claim", "clap", "clarify",
+	"claw", "clay", "clean", "clerk", "clever", "click", "client", "cliff",
+	"climb", "clinic", "clip", "clock", "clog", "close", "cloth", "cloud",
+	"clown", "club", "clump", "cluster", "clutch", "coach", "coast", "coconut",
+	"code", "coffee", "coil", "coin", "collect", "color", "column", "combine",
+	"come", "comfort", "comic", "common", "company", "concert", "conduct", "confirm",
+	"congress", "connect", "consider", "control", "convince", "cook", "cool", "copper",
+	"copy", "coral", "core", "corn", "correct", "cost", "cotton", "couch",
+	"country", "couple", "course", "cousin", "cover", "coyote", "crack", "cradle",
+	"craft", "cram", "crane", "crash", "crater", "crawl", "crazy", "cream",
+	"credit", "creek", "crew", "cricket", "crime", "crisp", "critic", "crop",
+	"cross", "crouch", "crowd", "crucial", "cruel", "cruise", "crumble", "crunch",
+	"crush", "cry", "crystal", "cube", "culture", "cup", "cupboard", "curious",
+	"current", "curtain", "curve", "cushion", "custom", "cute", "cycle", "dad",
+	"damage", "damp", "dance", "danger", "daring", "dash", "daughter", "dawn",
+	"day", "deal", "debate", "debris", "decade", "december", "decide", "decline",
+	"decorate", "decrease", "deer", "defense", "define", "defy", "degree", "delay",
+	"deliver", "demand", "demise", "denial", "dentist", "deny", "depart", "depend",
+	"deposit", "depth", "deputy", "derive", "describe", "desert", "design", "desk",
+	"despair", "destroy", "detail", "detect", "develop", "device", "devote", "diagram",
+	"dial", "diamond", "diary", "dice", "diesel", "diet", "differ", "digital",
+	"dignity", "dilemma", "dinner", "dinosaur", "direct", "dirt", "disagree", "discover",
+	"disease", "dish", "dismiss", "disorder", "display", "distance", "divert", "divide",
+	"divorce", "dizzy", "doctor", "document", "dog", "doll", "dolphin", "domain",
+	"donate", "donkey", "donor", "door", "dose", "double", "dove", "draft",
+	"dragon", "drama", "drastic", "draw", "dream", "dress", "drift", "drill",
+	"drink", "drip", "drive", "drop", "drum", "dry", "duck", "dumb",
+	"dune", "during", "dust", "dutch", "duty", "dwarf", "dynamic", "eager",
+	"eagle", "early", "earn", "earth", "easily", "east", "easy", "echo",
+	"ecology", "economy", "edge", "edit", "educate", "effort", "egg", "eight",
+	"either", "elbow", "elder", "electric", "elegant", "element", "elephant", "elevator",
+	"elite", "else", "embark", "embody", "embrace", "emerge", "emotion", "employ",
+	"empower", "empty", "enable", "enact", "end", "endless", "endorse", "enemy",
+	"energy", "enforce", "engage", "engine", "enhance", "enjoy", "enlist", "enough",
+	"enrich", "enroll", "ensure", "enter", "entire", "entry", "envelope", "episode",
+	"equal", "equip", "era", "erase", "erode", "erosion", "error", "erupt",
+	"escape", "essay", "essence", "estate", "eternal", "ethics", "evidence", "evil",
+	"evoke", "evolve", "exact", "example", "excess", "exchange", "excite", "exclude",
+	"excuse", "execute", "exercise", "exhaust", "exhibit", "exile", "exist", "exit",
+	"exotic", "expand", "expect", "expire", "explain", "expose", "express", "extend",
+	"extra", "eye", "eyebrow", "fabric", "face", "faculty", "fade", "faint",
+	"faith", "fall", "false", "fame", "family", "famous", "fan", "fancy",
+	"fantasy", "farm", "fashion", "fat", "fatal", "father", "fatigue", "fault",
+	"favorite", "feature", "february", "federal", "fee", "feed", "feel", "female",
+	"fence", "festival", "fetch", "fever", "few", "fiber", "fiction", "field",
+	"figure", "file", "film", "filter", "final", "find", "fine", "finger",
+	"finish", "fire", "firm", "first", "fiscal", "fish", "fit", "fitness",
+	"fix", "flag", "flame", "flash", "flat", "flavor", "flee", "flight",
+	"flip", "float", "flock", "floor", "flower", "fluid", "flush", "fly",
+	"foam", "focus", "fog", "foil", "fold", "follow", "food", "foot",
+	"force", "forest", "forget", "fork", "fortune", "forum", "forward", "fossil",
+	"foster", "found", "fox", "fragile", "frame", "frequent", "fresh", "friend",
+	"fringe", "frog", "front", "frost", "frown", "frozen", "fruit", "fuel",
+	"fun", "funny", "furnace", "fury", "future", "gadget", "gain", "galaxy",
+	"gallery", "game", "gap", "garage", "garbage", "garden", "garlic", "garment",
+	"gas", "gasp", "gate", "gather", "gauge", "gaze", "general", "genius",
+	"genre", "gentle", "genuine", "gesture", "ghost", "giant", "gift", "giggle",
+	"ginger", "giraffe", "girl", "give", "glad", "glance", "glare", "glass",
+	"glide", "glimpse", "globe", "gloom", "glory", "glove", "glow", "glue",
+	"goat", "goddess", "gold", "good", "goose", "gorilla", "gospel", "gossip",
+	"govern", "gown", "grab", "grace", "grain", "grant", "grape", "grass",
+	"gravity", "great", "green", "grid", "grief", "grit", "grocery", "group",
+	"grow", "grunt", "guard", "guess", "guide", "guilt", "guitar", "gun",
+	"gym", "habit", "hair", "half", "hammer", "hamster", "hand", "happy",
+	"harbor", "hard", "harsh", "harvest", "hat", "have", "hawk", "hazard",
+	"head", "health", "heart", "heavy", "hedgehog", "height", "hello", "helmet",
+	"help", "hen", "hero", "hidden", "high", "hill", "hint", "hip",
+	"hire", "history", "hobby", "hockey", "hold", "hole", "holiday", "hollow",
+	"home", "honey", "hood", "hope", "horn", "horror", "horse", "hospital",
+	"host", "hotel", "hour", "hover", "hub", "huge", "human", "humble",
+	"humor", "hundred", "hungry", "hunt", "hurdle", "hurry", "hurt", "husband",
+	"hybrid", "ice", "icon", "idea", "identify", "idle", "ignore", "ill",
+	"illegal", "illness", "image", "imitate", "immense", "immune", "impact", "impose",
+	"improve", "impulse", "inch", "include", "income", "increase", "index", "indicate",
+	"indoor", "industry", "infant", "inflict", "inform", "inhale", "inherit", "initial",
+	"inject", "injury", "inmate", "inner", "innocent", "input", "inquiry", "insane",
+	"insect", "inside", "inspire", "install", "intact", "interest", "into", "invest",
+	"invite", "involve", "iron", "island", "isolate", "issue", "item", "ivory",
+	"jacket", "jaguar", "jar", "jazz", "jealous", "jeans", "jelly", "jewel",
+	"job", "join", "joke", "journey", "joy", "judge", "juice", "jump",
+	"jungle", "junior", "junk", "just", "kangaroo", "keen", "keep", "ketchup",
+	"key", "kick", "kid", "kidney", "kind", "kingdom", "kiss", "kit",
+	"kitchen", "kite", "kitten", "kiwi", "knee", "knife", "knock", "know",
+	"lab", "label", "labor", "ladder", "lady", "lake", "lamp", "language",
+	"laptop", "large", "later", "latin", "laugh", "laundry", "lava", "law",
+	"lawn", "lawsuit", "layer", "lazy", "leader", "leaf", "learn", "leave",
+	"lecture", "left", "leg", "legal", "legend", "leisure", "lemon", "lend",
+	"length", "lens", "leopard", "lesson", "letter", "level", "liar", "liberty",
+	"library", "license", "life", "lift", "light", "like", "limb", "limit",
+	"link", "lion", "liquid", "list", "little", "live", "lizard", "load",
+	"loan", "lobster", "local", "lock", "logic", "lonely", "long", "loop",
+	"lottery", "loud", "lounge", "love", "loyal", "lucky", "luggage", "lumber",
+	"lunar", "lunch", "luxury", "lyrics", "machine", "mad", "magic", "magnet",
+	"maid", "mail", "main", "major", "make", "mammal", "man", "manage",
+	"mandate", "mango", "mansion", "manual", "maple", "marble", "march", "margin",
+	"marine", "market", "marriage", "mask", "mass", "master", "match", "material",
+	"math", "matrix", "matter", "maximum", "maze", "meadow", "mean", "measure",
+	"meat", "mechanic", "medal", "media", "melody", "melt", "member", "memory",
+	"mention", "menu", "mercy", "merge", "merit", "merry", "mesh", "message",
+	"metal", "method", "middle", "midnight", "milk", "million", "mimic", "mind",
+	"minimum", "minor", "minute", "miracle", "mirror", "misery", "miss", "mistake",
+	"mix", "mixed", "mixture", "mobile", "model", "modify", "mom", "moment",
+	"monitor", "monkey", "monster", "month", "moon", "moral", "more", "morning",
+	"mosquito", "mother", "motion", "motor", "mountain", "mouse", "move", "movie",
+	"much", "muffin", "mule", "multiply", "muscle", "museum", "mushroom", "music",
+	"must", "mutual", "myself", "mystery", "myth", "naive", "name", "napkin",
+	"narrow", "nasty", "nation", "nature", "near", "neck", "need", "negative",
+	"neglect", "neither", "nephew", "nerve", "nest", "net", "network", "neutral",
+	"never", "news", "next", "nice", "night", "noble", "noise", "nominee",
+	"noodle", "normal", "north", "nose", "notable", "note", "nothing", "notice",
+	"novel", "now", "nuclear", "number", "nurse", "nut", "oak", "obey",
+	"object", "oblige", "obscure", "observe", "obtain", "obvious", "occur", "ocean",
+	"october", "odor", "off", "offer", "office", "often", "oil", "okay",
+	"old", "olive", "olympic", "omit", "once", "one", "onion", "online",
+	"only", "open", "opera", "opinion", "oppose", "option", "orange", "orbit",
+	"orchard", "order", "ordinary", "organ", "orient", "original", "orphan", "ostrich",
+	"other", "outdoor", "outer", "output", "outside", "oval", "oven", "over",
+	"own", "owner", "oxygen", "oyster", "ozone", "pact", "paddle", "page",
+	"pair", "palace", "palm", "panda", "panel", "panic", "panther", "paper",
+	"parade", "parent", "park", "parrot", "party", "pass", "patch", "path",
+	"patient", "patrol", "pattern", "pause", "pave", "payment", "peace", "peanut",
+	"pear", "peasant", "pelican", "pen", "penalty", "pencil", "people", "pepper",
+	"perfect", "permit", "person", "pet", "phone", "photo", "phrase", "physical",
+	"piano", "picnic", "picture", "piece", "pig", "pigeon", "pill", "pilot",
+	"pink", "pioneer", "pipe", "pistol", "pitch", "pizza", "place", "planet",
+	"plastic", "plate", "play", "please", "pledge", "pluck", "plug", "plunge",
+	"poem", "poet", "point", "polar", "pole", "police", "pond", "pony",
+	"pool", "popular", "portion", "position", "possible", "post", "potato", "pottery",
+	"poverty", "powder", "power", "practice", "praise", "predict", "prefer", "prepare",
+	"present", "pretty", "prevent", "price", "pride", "primary", "print", "priority",
+	"prison", "private", "prize", "problem", "process", "produce", "profit", "program",
+	"project", "promote", "proof", "property", "prosper", "protect", "proud", "provide",
+	"public", "pudding", "pull", "pulp", "pulse", "pumpkin", "punch", "pupil",
+	"puppy", "purchase", "purity", "purpose", "purse", "push", "put", "puzzle",
+	"pyramid", "quality", "quantum", "quarter", "question", "quick", "quit", "quiz",
+	"quote", "rabbit", "raccoon", "race", "rack", "radar", "radio", "rail",
+	"rain", "raise", "rally", "ramp", "ranch", "random", "range", "rapid",
+	"rare", "rate", "rather", "raven", "raw", "razor", "ready", "real",
+	"reason", "rebel", "rebuild", "recall", "receive", "recipe", "record", "recycle",
+	"reduce", "reflect", "reform", "refuse", "region", "regret", "regular", "reject",
+	"relax", "release", "relief", "rely", "remain", "remember", "remind", "remove",
+	"render", "renew", "rent", "reopen", "repair", "repeat", "replace", "report",
+	"require", "rescue", "resemble", "resist", "resource", "response", "result", "retire",
+	"retreat", "return", "reunion", "reveal", "review", "reward", "rhythm", "rib",
+	"ribbon", "rice", "rich", "ride", "ridge", "rifle", "right", "rigid",
+	"ring", "riot", "ripple", "risk", "ritual", "rival", "river", "road",
+	"roast", "robot", "robust", "rocket", "romance", "roof", "rookie", "room",
+	"rose", "rotate", "rough", "round", "route", "royal", "rubber", "rude",
+	"rug", "rule", "run", "runway", "rural", "sad", "saddle", "sadness",
+	"safe", "sail", "salad", "salmon", "salon", "salt", "salute", "same",
+	"sample", "sand", "satisfy", "satoshi", "sauce", "sausage", "save", "say",
+	"scale", "scan", "scare", "scatter", "scene", "scheme", "school", "science",
+	"scissors", "scorpion", "scout", "scrap", "screen", "script", "scrub", "sea",
+	"search", "season", "seat", "second", "secret", "section", "security", "seed",
+	"seek", "segment", "select", "sell", "seminar", "senior", "sense", "sentence",
+	"series", "service", "session", "settle", "setup", "seven", "shadow", "shaft",
+	"shallow", "share", "shed", "shell", "sheriff", "shield", "shift", "shine",
+	"ship", "shiver", "shock", "shoe", "shoot", "shop", "short", "shoulder",
+	"shove", "shrimp", "shrug", "shuffle", "shy", "sibling", "sick", "side",
+	"siege", "sight", "sign", "silent", "silk", "silly", "silver", "similar",
+	"simple", "since", "sing", "siren", "sister", "situate", "six", "size",
+	"skate", "sketch", "ski", "skill", "skin", "skirt", "skull", "slab",
+	"slam", "sleep", "slender", "slice", "slide", "slight", "slim", "slogan",
+	"slot", "slow", "slush", "small", "smart", "smile", "smoke", "smooth",
+	"snack", "snake", "snap", "sniff", "snow", "soap", "soccer", "social",
+	"sock", "soda", "soft", "solar", "soldier", "solid", "solution", "solve",
+	"someone", "song", "soon", "sorry", "sort", "soul", "sound", "soup",
+	"source", "south", "space", "spare", "spatial", "spawn", "speak", "special",
+	"speed", "spell", "spend", "sphere", "spice", "spider", "spike", "spin",
+	"spirit", "split", "spoil", "sponsor", "spoon", "sport", "spot", "spray",
+	"spread", "spring", "spy", "square", "squeeze", "squirrel", "stable", "stadium",
+	"staff", "stage", "stairs", "stamp", "stand", "start", "state", "stay",
+	"steak", "steel", "stem", "step", "stereo", "stick", "still", "sting",
+	"stock", "stomach", "stone", "stool", "story", "stove", "strategy", "street",
+	"strike", "strong", "struggle", "student", "stuff", "stumble", "style", "subject",
+	"submit", "subway", "success", "such", "sudden", "suffer", "sugar", "suggest",
+	"suit", "summer", "sun", "sunny", "sunset", "super", "supply", "supreme",
+	"sure", "surface", "surge", "surprise", "surround", "survey", "suspect", "sustain",
+	"swallow", "swamp", "swap", "swarm", "swear", "sweet", "swift", "swim",
+	"swing", "switch", "sword", "symbol", "symptom", "syrup", "system", "table",
+	"tackle", "tag", "tail", "talent", "talk", "tank", "tape", "target",
+	"task", "taste", "tattoo", "taxi", "teach", "team", "tell", "ten",
+	"tenant", "tennis", "tent", "term", "test", "text", "thank", "that",
+	"theme", "then", "theory", "there", "they", "thing", "this", "thought",
+	"three", "thrive", "throw", "thumb", "thunder", "ticket", "tide", "tiger",
+	"tilt", "timber", "time", "tiny", "tip", "tired", "tissue", "title",
+	"toast", "tobacco", "today", "toddler", "toe", "together", "toilet", "token",
+	"tomato", "tomorrow", "tone", "tongue", "tonight", "tool", "tooth", "top",
+	"topic", "topple", "torch", "tornado", "tortoise", "toss", "total", "tourist",
+	"toward", "tower", "town", "toy", "track", "trade", "traffic", "tragic",
+	"train", "transfer", "trap", "trash", "travel", "tray", "treat", "tree",
+	"trend", "trial", "tribe", "trick", "trigger", "trim", "trip", "trophy",
+	"trouble", "truck", "true", "truly", "trumpet", "trust", "truth", "try",
+	"tube", "tuition", "tumble", "tuna", "tunnel", "turkey", "turn", "turtle",
+	"twelve", "twenty", "twice", "twin", "twist", "two", "type", "typical",
+	"ugly", "umbrella", "unable", "unaware", "uncle", "uncover", "under", "undo",
+	"unfair", "unfold", "unhappy", "uniform", "unique", "unit", "universe", "unknown",
+	"unlock", "until", "unusual", "unveil", "update", "upgrade", "uphold", "upon",
+	"upper", "upset", "urban", "urge", "usage", "use", "used", "useful",
+	"useless", "usual", "utility", "vacant", "vacuum", "vague", "valid", "valley",
+	"valve", "van", "vanish", "vapor", "various", "vast", "vault", "vehicle",
+	"velvet", "vendor", "venture", "venue", "verb", "verify", "version", "very",
+	"vessel", "veteran", "viable", "vibrant", "vicious", "victory", "video", "view",
+	"village", "vintage", "violin", "virtual", "virus", "visa", "visit", "visual",
+	"vital", "vivid", "vocal", "voice", "void", "volcano", "volume", "vote",
+	"voyage", "wage", "wagon", "wait", "walk", "wall", "walnut", "want",
+	"warfare", "warm", "warrior", "wash", "wasp", "waste", "water", "wave",
+	"way", "wealth", "weapon", "wear", "weasel", "weather", "web", "wedding",
+	"weekend", "weird", "welcome", "west", "wet", "whale", "what", "wheat",
+	"wheel", "when", "where", "whip", "whisper", "wide", "width", "wife",
+	"wild", "will", "win", "window", "wine", "wing", "wink", "winner",
+	"winter", "wire", "wisdom", "wise", "wish", "witness", "wolf", "woman",
+	"wonder", "wood", "wool", "word", "work", "world", "worry", "worth",
+	"wrap", "wreck", "wrestle", "wrist", "write", "wrong", "yard", "year",
+	"yellow", "you", "young", "youth", "zebra", "zero", "zone", "zoo"
+};
+
+// Pack up to the first 4 letters of a word into 20 bits
+constexpr uint32_t bip39Prefix(string_view word)
+{
+	uint32_t key = 0;
+	for (size_t i=0; i<4; i++)
+		key = (key << 5) | (i < word.size() ? (word[i] & 31) : 0);
+	return key;
+}
+
+constexpr size_t bip39Slot(uint32_t key)
 {
-	static bool added = false;
-	static vector<string> bip;
-	if (!added)
+	return (key * 2654435761u) >> 20; // 12 bits
+}
+
+// Open addressing table from 4-letter prefix to word index, built at compile time
+constexpr array<uint16_t,4096> bip39BuildIndex()
+{
+	array<uint16_t,4096> table {};
+	for (size_t i=0; i<table.size(); i++)
+		table[i] = 0xffff;
+	for (uint16_t idx=0; idx<2048; idx++)
 	{
-		bip.push_back("abandon");
-		bip.push_back("ability");
-		bip.push_back("able");
-		bip.push_back("about");
-		bip.push_back("above");
-		bip.push_back("absent");
-		bip.push_back("absorb");
-		bip.push_back("abstract");
-		bip.push_back("absurd");
-		bip.push_back("abuse");
-		bip.push_back("access");
-		bip.push_back("accident");
-		bip.push_back("account");
-		bip.push_back("accuse");
-		bip.push_back("achieve");
-		bip.push_back("acid");
-		bip.push_back("acoustic");
-		bip.push_back("acquire");
-		bip.push_back("across");
-		bip.push_back("act");
-		bip.push_back("action");
-		bip.push_back("actor");
-		bip.push_back("actress");
-		bip.push_back("actual");
-		bip.push_back("adapt");
-		bip.push_back("add");
-		bip.push_back("addict");
-		bip.push_back("address");
-		bip.push_back("adjust");
-		bip.push_back("admit");
-		bip.push_back("adult");
-		bip.push_back("advance");
-		bip.push_back("advice");
-		bip.push_back("aerobic");
-		bip.push_back("affair");
-		bip.push_back("afford");
-		bip.push_back("afraid");
-		bip.push_back("again");
-		bip.push_back("age");
-		bip.push_back("agent");
-		bip.push_back("agree");
-		bip.push_back("ahead");
-		bip.push_back("aim");
-		bip.push_back("air");
-		bip.push_back("airport");
-		bip.push_back("aisle");
-		bip.push_back("alarm");
-		bip.push_back("album");
-		bip.push_back("alcohol");
-		bip.push_back("alert");
-		bip.push_back("alien");
-		bip.push_back("all");
-		bip.push_back("alley");
-		bip.push_back("allow");
-		bip.push_back("almost");
-		bip.push_back("alone");
-		bip.push_back("alpha");
-		bip.push_back("already");
-		bip.push_back("also");
-		bip.push_back("alter");
-		bip.push_back("always");
-		bip.push_back("amateur");
-		bip.push_back("amazing");
-		bip.push_back("among");
-		bip.push_back("amount");
-		bip.push_back("amused");
-		bip.push_back("analyst");
-		bip.push_back("anchor");
-		bip.push_back("ancient");
-		bip.push_back("anger");
-		bip.push_back("angle");
-		bip.push_back("angry");
-		bip.push_back("animal");
-		bip.push_back("ankle");
-		bip.push_back("announce");
-		bip.push_back("annual");
-		bip.push_back("another");
-		bip.push_back("answer");
-		bip.push_back("antenna");
-		bip.push_back("antique");
-		bip.push_back("anxiety");
-		bip.push_back("any");
-		bip.push_back("apart");
-		bip.push_back("apology");
-		bip.push_back("appear");
-		bip.push_back("apple");
-		bip.push_back("approve");
-		bip.push_back("april");
-		bip.push_back("arch");
-		bip.push_back("arctic");
-		bip.push_back("area");
-		bip.push_back("arena");
-		bip.push_back("argue");
-		bip.push_back("arm");
-		bip.push_back("armed");
-		bip.push_back("armor");
-		bip.push_back("army");
-		bip.push_back("around");
-		bip.push_back("arrange");
-		bip.push_back("arrest");
-		bip.push_back("arrive");
-		bip.push_back("arrow");
-		bip.push_back("art");
-		bip.push_back("artefact");
-		bip.push_back("artist");
-		bip.push_back("artwork");
-		bip.push_back("ask");
-		bip.push_back("aspect");
-		bip.push_back("assault");
-		bip.push_back("asset");
-		bip.push_back("assist");
-		bip.push_back("assume");
-		bip.push_back("asthma");
-		bip.push_back("athlete");
-		bip.push_back("atom");
-		bip.push_back("attack");
-		bip.push_back("attend");
-		bip.push_back("attitude");
-		bip.push_back("attract");
-		bip.push_back("auction");
-		bip.push_back("audit");
-		bip.push_back("august");
-		bip.push_back("aunt");
-		bip.push_back("author");
-		bip.push_back("auto");
-		bip.push_back("autumn");
-		bip.push_back("average");
-		bip.push_back("avocado");
-		bip.push_back("avoid");
-		bip.push_back("awake");
-		bip.push_back("aware");
-		bip.push_back("away");
-		bip.push_back("awesome");
-		bip.push_back("awful");
-		bip.push_back("awkward");
-		bip.push_back("axis");
-		bip.push_back("baby");
-		bip.push_back("bachelor");
-		bip.push_back("bacon");
-		bip.push_back("badge");
-		bip.push_back("bag");
-		bip.push_back("balance");
-		bip.push_back("balcony");
-		bip.push_back("ball");
-		bip.push_back("bamboo");
-		bip.push_back("banana");
-		bip.push_back("banner");
-		bip.push_back("bar");
-		bip.push_back("barely");
-		bip.push_back("bargain");
-		bip.push_back("barrel");
-		bip.push_back("base");
-		bip.push_back("basic");
-		bip.push_back("basket");
-		bip.push_back("battle");
-		bip.push_back("beach");
-		bip.push_back("bean");
-		bip.push_back("beauty");
-		bip.push_back("because");
-		bip.push_back("become");
-		bip.push_back("beef");
-		bip.push_back("before");
-		bip.push_back("begin");
-		bip.push_back("behave");
-		bip.push_back("behind");
-		bip.push_back("believe");
-		bip.push_back("below");
-		bip.push_back("belt");
-		bip.push_back("bench");
-		bip.push_back("benefit");
-		bip.push_back("best");
-		bip.push_back("betray");
-		bip.push_back("better");
-		bip.push_back("between");
-		bip.push_back("beyond");
-		bip.push_back("bicycle");
-		bip.push_back("bid");
-		bip.push_back("bike");
-		bip.push_back("bind");
-		bip.push_back("biology");
-		bip.push_back("bird");
-		bip.push_back("birth");
-		bip.push_back("bitter");
-		bip.push_back("black");
-		bip.push_back("blade");
-		bip.push_back("blame");
-		bip.push_back("blanket");
-		bip.push_back("blast");
-		bip.push_back("bleak");
-		bip.push_back("bless");
-		bip.push_back("blind");
-		bip.push_back("blood");
-		bip.push_back("blossom");
-		bip.push_back("blouse");
-		bip.push_back("blue");
-		bip.push_back("blur");
-		bip.push_back("blush");
-		bip.push_back("board");
-		bip.push_back("boat");
-		bip.push_back("body");
-		bip.push_back("boil");
-		bip.push_back("bomb");
-		bip.push_back("bone");
-		bip.push_back("bonus");
-		bip.push_back("book");
-		bip.push_back("boost");
-		bip.push_back("border");
-		bip.push_back("boring");
-		bip.push_back("borrow");
-		bip.push_back("boss");
-		bip.push_back("bottom");
-		bip.push_back("bounce");
-		bip.push_back("box");
-		bip.push_back("boy");
-		bip.push_back("bracket");
-		bip.push_back("brain");
-		bip.push_back("brand");
-		bip.push_back("brass");
-		bip.push_back("brave");
-		bip.push_back("bread");
-		bip.push_back("breeze");
-		bip.push_back("brick");
-		bip.push_back("bridge");
-		bip.push_back("brief");
-		bip.push_back("bright");
-		bip.push_back("bring");
-		bip.push_back("brisk");
-		bip.push_back("broccoli");
-		bip.push_back("broken");
-		bip.push_back("bronze");
-		bip.push_back("broom");
-		bip.push_back("brother");
-		bip.push_back("brown");
-		bip.push_back("brush");
-		bip.push_back("bubble");
-		bip.push_back("buddy");
-		bip.push_back("budget");
-		bip.push_back("buffalo");
-		bip.push_back("build");
-		bip.push_back("bulb");
-		bip.push_back("bulk");
-		bip.push_back("bullet");
-		bip.push_back("bundle");
-		bip.push_back("bunker");
-		bip.push_back("burden");
-		bip.push_back("burger");
-		bip.push_back("burst");
-		bip.push_back("bus");
-		bip.push_back("business");
-		bip.push_back("busy");
-		bip.push_back("butter");
-		bip.push_back("buyer");
-		bip.push_back("buzz");
-		bip.push_back("cabbage");
-		bip.push_back("cabin");
-		bip.push_back("cable");
-		bip.push_back("cactus");
-		bip.push_back("cage");
-		bip.push_back("cake");
-		bip.push_back("call");
-		bip.push_back("calm");
-		bip.push_back("camera");
-		bip.push_back("camp");
-		bip.push_back("can");
-		bip.push_back("canal");
-		bip.push_back("cancel");
-		bip.push_back("candy");
-		bip.push_back("cannon");
-		bip.push_back("canoe");
-		bip.push_back("canvas");
-		bip.push_back("canyon");
-		bip.push_back("capable");
-		bip.push_back("capital");
-		bip.push_back("captain");
-		bip.push_back("car");
-		bip.push_back("carbon");
-		bip.push_back("card");
-		bip.push_back("cargo");
-		bip.push_back("carpet");
-		bip.push_back("carry");
-		bip.push_back("cart");
-		bip.push_back("case");
-		bip.push_back("cash");
-		bip.push_back("casino");
-		bip.push_back("castle");
-		bip.push_back("casual");
-		bip.push_back("cat");
-		bip.push_back("catalog");
-		bip.push_back("catch");
-		bip.push_back("category");
-		bip.push_back("cattle");
-		bip.push_back("caught");
-		bip.push_back("cause");
-		bip.push_back("caution");
-		bip.push_back("cave");
-		bip.push_back("ceiling");
-		bip.push_back("celery");
-		bip.push_back("cement");
-		bip.push_back("census");
-		bip.push_back("century");
-		bip.push_back("cereal");
-		bip.push_back("certain");
-		bip.push_back("chair");
-		bip.push_back("chalk");
-		bip.push_back("champion");
-		bip.push_back("change");
-		bip.push_back("chaos");
-		bip.push_back("chapter");
-		bip.push_back("charge");
-		bip.push_back("chase");
-		bip.push_back("chat");
-		bip.push_back("cheap");
-		bip.push_back("check");
-		bip.push_back("cheese");
-		bip.push_back("chef");
-		bip.push_back("cherry");
-		bip.push_back("chest");
-		bip.push_back("chicken");
-		bip.push_back("chief");
-		bip.push_back("child");
-		bip.push_back("chimney");
-		bip.push_back("choice");
-		bip.push_back("choose");
-		bip.push_back("chronic");
-		bip.push_back("chuckle");
-		bip.push_back("chunk");
-		bip.push_back("churn");
-		bip.push_back("cigar");
-		bip.push_back("cinnamon");
-		bip.push_back("circle");
-		bip.push_back("citizen");
-		bip.push_back("city");
-		bip.push_back("civil");
-		bip.push_back("claim");
-		bip.push_back("clap");
-		bip.push_back("clarify");
-		bip.push_back("claw");
-		bip.push_back("clay");
-		bip.push_back("clean");
-		bip.push_back("clerk");
-		bip.push_back("clever");
-		bip.push_back("click");
-		bip.push_back("client");
-		bip.push_back("cliff");
-		bip.push_back("climb");
-		bip.push_back("clinic");
-		bip.push_back("clip");
-		bip.push_back("clock");
-		bip.push_back("clog");
-		bip.push_back("close");
-		bip.push_back("cloth");
-		bip.push_back("cloud");
-		bip.push_back("clown");
-		bip.push_back("club");
-		bip.push_back("clump");
-		bip.push_back("cluster");
-		bip.push_back("clutch");
-		bip.push_back("coach");
-		bip.push_back("coast");
-		bip.push_back("coconut");
-		bip.push_back("code");
-		bip.push_back("coffee");
-		bip.push_back("coil");
-		bip.push_back("coin");
-		bip.push_back("collect");
-		bip.push_back("color");
-		bip.push_back("column");
-		bip.push_back("combine");
-		bip.push_back("come");
-		bip.push_back("comfort");
-		bip.push_back("comic");
-		bip.push_back("common");
-		bip.push_back("company");
-		bip.push_back("concert");
-		bip.push_back("conduct");
-		bip.push_back("confirm");
-		bip.push_back("congress");
-		bip.push_back("connect");
-		bip.push_back("consider");
-		bip.push_back("control");
-		bip.push_back("convince");
-		bip.push_back("cook");
-		bip.push_back("cool");
-		bip.push_back("copper");
-		bip.push_back("copy");
-		bip.push_back("coral");
-		bip.push_back("core");
-		bip.push_back("corn");
-		bip.push_back("correct");
-		bip.push_back("cost");
-		bip.push_back("cotton");
-		bip.push_back("couch");
-		bip.push_back("country");
-		bip.push_back("couple");
-		bip.push_back("course");
-		bip.push_back("cousin");
-		bip.push_back("cover");
-		bip.push_back("coyote");
-		bip.push_back("crack");
-		bip.push_back("cradle");
-		bip.push_back("craft");
-		bip.push_back("cram");
-		bip.push_back("crane");
-		bip.push_back("crash");
-		bip.push_back("crater");
-		bip.push_back("crawl");
-		bip.push_back("crazy");
-		bip.push_back("cream");
-		bip.push_back("credit");
-		bip.push_back("creek");
-		bip.push_back("crew");
-		bip.push_back("cricket");
-		bip.push_back("crime");
-		bip.push_back("crisp");
-		bip.push_back("critic");
-		bip.push_back("crop");
-		bip.push_back("cross");
-		bip.push_back("crouch");
-		bip.push_back("crowd");
-		bip.push_back("crucial");
-		bip.push_back("cruel");
-		bip.push_back("cruise");
-		bip.push_back("crumble");
-		bip.push_back("crunch");
-		bip.push_back("crush");
-		bip.push_back("cry");
-		bip.push_back("crystal");
-		bip.push_back("cube");
-		bip.push_back("culture");
-		bip.push_back("cup");
-		bip.push_back("cupboard");
-		bip.push_back("curious");
-		bip.push_back("current");
-		bip.push_back("curtain");
-		bip.push_back("curve");
-		bip.push_back("cushion");
-		bip.push_back("custom");
-		bip.push_back("cute");
-		bip.push_back("cycle");
-		bip.push_back("dad");
-		bip.push_back("damage");
-		bip.push_back("damp");
-		bip.push_back("dance");
-		bip.push_back("danger");
-		bip.push_back("daring");
-		bip.push_back("dash");
-		bip.push_back("daughter");
-		bip.push_back("dawn");
-		bip.push_back("day");
-		bip.push_back("deal");
-		bip.push_back("debate");
-		bip.push_back("debris");
-		bip.push_back("decade");
-		bip.push_back("december");
-		bip.push_back("decide");
-		bip.push_back("decline");
-		bip.push_back("decorate");
-		bip.push_back("decrease");
-		bip.push_back("deer");
-		bip.push_back("defense");
-		bip.push_back("define");
-		bip.push_back("defy");
-		bip.push_back("degree");
-		bip.push_back("delay");
-		bip.push_back("deliver");
-		bip.push_back("demand");
-		bip.push_back("demise");
-		bip.push_back("denial");
-		bip.push_back("dentist");
-		bip.push_back("deny");
-		bip.push_back("depart");
-		bip.push_back("depend");
-		bip.push_back("deposit");
-		bip.push_back("depth");
-		bip.push_back("deputy");
-		bip.push_back("derive");
-		bip.push_back("describe");
-		bip.push_back("desert");
-		bip.push_back("design");
-		bip.push_back("desk");
-		bip.push_back("despair");
-		bip.push_back("destroy");
-		bip.push_back("detail");
-		bip.push_back("detect");
-		bip.push_back("develop");
-		bip.push_back("device");
-		bip.push_back("devote");
-		bip.push_back("diagram");
-		bip.push_back("dial");
-		bip.push_back("diamond");
-		bip.push_back("diary");
-		bip.push_back("dice");
-		bip.push_back("diesel");
-		bip.push_back("diet");
-		bip.push_back("differ");
-		bip.push_back("digital");
-		bip.push_back("dignity");
-		bip.push_back("dilemma");
-		bip.push_back("dinner");
-		bip.push_back("dinosaur");
-		bip.push_back("direct");
-		bip.push_back("dirt");
-		bip.push_back("disagree");
-		bip.push_back("discover");
-		bip.push_back("disease");
-		bip.push_back("dish");
-		bip.push_back("dismiss");
-		bip.push_back("disorder");
-		bip.push_back("display");
-		bip.push_back("distance");
-		bip.push_back("divert");
-		bip.push_back("divide");
-		bip.push_back("divorce");
-		bip.push_back("dizzy");
-		bip.push_back("doctor");
-		bip.push_back("document");
-		bip.push_back("dog");
-		bip.push_back("doll");
-		bip.push_back("dolphin");
-		bip.push_back("domain");
-		bip.push_back("donate");
-		bip.push_back("donkey");
-		bip.push_back("donor");
-		bip.push_back("door");
-		bip.push_back("dose");
-		bip.push_back("double");
-		bip.push_back("dove");
-		bip.push_back("draft");
-		bip.push_back("dragon");
-		bip.push_back("drama");
-		bip.push_back("drastic");
-		bip.push_back("draw");
-		bip.push_back("dream");
-		bip.push_back("dress");
-		bip.push_back("drift");
-		bip.push_back("drill");
-		bip.push_back("drink");
-		bip.push_back("drip");
-		bip.push_back("drive");
-		bip.push_back("drop");
-		bip.push_back("drum");
-		bip.push_back("dry");
-		bip.push_back("duck");
-		bip.push_back("dumb");
-		bip.push_back("dune");
-		bip.push_back("during");
-		bip.push_back("dust");
-		bip.push_back("dutch");
-		bip.push_back("duty");
-		bip.push_back("dwarf");
-		bip.push_back("dynamic");
-		bip.push_back("eager");
-		bip.push_back("eagle");
-		bip.push_back("early");
-		bip.push_back("earn");
-		bip.push_back("earth");
-		bip.push_back("easily");
-		bip.push_back("east");
-		bip.push_back("easy");
-		bip.push_back("echo");
-		bip.push_back("ecology");
-		bip.push_back("economy");
-		bip.push_back("edge");
-		bip.push_back("edit");
-		bip.push_back("educate");
-		bip.push_back("effort");
-		bip.push_back("egg");
-		bip.push_back("eight");
-		bip.push_back("either");
-		bip.push_back("elbow");
-		bip.push_back("elder");
-		bip.push_back("electric");
-		bip.push_back("elegant");
-		bip.push_back("element");
-		bip.push_back("elephant");
-		bip.push_back("elevator");
-		bip.push_back("elite");
-		bip.push_back("else");
-		bip.push_back("embark");
-		bip.push_back("embody");
-		bip.push_back("embrace");
-		bip.push_back("emerge");
-		bip.push_back("emotion");
-		bip.push_back("employ");
-		bip.push_back("empower");
-		bip.push_back("empty");
-		bip.push_back("enable");
-		bip.push_back("enact");
-		bip.push_back("end");
-		bip.push_back("endless");
-		bip.push_back("endorse");
-		bip.push_back("enemy");
-		bip.push_back("energy");
-		bip.push_back("enforce");
-		bip.push_back("engage");
-		bip.push_back("engine");
-		bip.push_back("enhance");
-		bip.push_back("enjoy");
-		bip.push_back("enlist");
-		bip.push_back("enough");
-		bip.push_back("enrich");
-		bip.push_back("enroll");
-		bip.push_back("ensure");
-		bip.push_back("enter");
-		bip.push_back("entire");
-		bip.push_back("entry");
-		bip.push_back("envelope");
-		bip.push_back("episode");
-		bip.push_back("equal");
-		bip.push_back("equip");
-		bip.push_back("era");
-		bip.push_back("erase");
-		bip.push_back("erode");
-		bip.push_back("erosion");
-		bip.push_back("error");
-		bip.push_back("erupt");
-		bip.push_back("escape");
-		bip.push_back("essay");
-		bip.push_back("essence");
-		bip.push_back("estate");
-		bip.push_back("eternal");
-		bip.push_back("ethics");
-		bip.push_back("evidence");
-		bip.push_back("evil");
-		bip.push_back("evoke");
-		bip.push_back("evolve");
-		bip.push_back("exact");
-		bip.push_back("example");
-		bip.push_back("excess");
-		bip.push_back("exchange");
-		bip.push_back("excite");
-		bip.push_back("exclude");
-		bip.push_back("excuse");
-		bip.push_back("execute");
-		bip.push_back("exercise");
-		bip.push_back("exhaust");
-		bip.push_back("exhibit");
-		bip.push_back("exile");
-		bip.push_back("exist");
-		bip.push_back("exit");
-		bip.push_back("exotic");
-		bip.push_back("expand");
-		bip.push_back("expect");
-		bip.push_back("expire");
-		bip.push_back("explain");
-		bip.push_back("expose");
-		bip.push_back("express");
-		bip.push_back("extend");
-		bip.push_back("extra");
-		bip.push_back("eye");
-		bip.push_back("eyebrow");
-		bip.push_back("fabric");
-		bip.push_back("face");
-		bip.push_back("faculty");
-		bip.push_back("fade");
-		bip.push_back("faint");
-		bip.push_back("faith");
-		bip.push_back("fall");
-		bip.push_back("false");
-		bip.push_back("fame");
-		bip.push_back("family");
-		bip.push_back("famous");
-		bip.push_back("fan");
-		bip.push_back("fancy");
-		bip.push_back("fantasy");
-		bip.push_back("farm");
-		bip.push_back("fashion");
-		bip.push_back("fat");
-		bip.push_back("fatal");
-		bip.push_back("father");
-		bip.push_back("fatigue");
-		bip.push_back("fault");
-		bip.push_back("favorite");
-		bip.push_back("feature");
-		bip.push_back("february");
-		bip.push_back("federal");
-		bip.push_back("fee");
-		bip.push_back("feed");
-		bip.push_back("feel");
-		bip.push_back("female");
-		bip.push_back("fence");
-		bip.push_back("festival");
-		bip.push_back("fetch");
-		bip.push_back("fever");
-		bip.push_back("few");
-		bip.push_back("fiber");
-		bip.push_back("fiction");
-		bip.push_back("field");
-		bip.push_back("figure");
-		bip.push_back("file");
-		bip.push_back("film");
-		bip.push_back("filter");
-		bip.push_back("final");
-		bip.push_back("find");
-		bip.push_back("fine");
-		bip.push_back("finger");
-		bip.push_back("finish");
-		bip.push_back("fire");
-		bip.push_back("firm");
-		bip.push_back("first");
-		bip.push_back("fiscal");
-		bip.push_back("fish");
-		bip.push_back("fit");
-		bip.push_back("fitness");
-		bip.push_back("fix");
-		bip.push_back("flag");
-		bip.push_back("flame");
-		bip.push_back("flash");
-		bip.push_back("flat");
-		bip.push_back("flavor");
-		bip.push_back("flee");
-		bip.push_back("flight");
-		bip.push_back("flip");
-		bip.push_back("float");
-		bip.push_back("flock");
-		bip.push_back("floor");
-		bip.push_back("flower");
-		bip.push_back("fluid");
-		bip.push_back("flush");
-		bip.push_back("fly");
-		bip.push_back("foam");
-		bip.push_back("focus");
-		bip.push_back("fog");
-		bip.push_back("foil");
-		bip.push_back("fold");
-		bip.push_back("follow");
-		bip.push_back("food");
-		bip.push_back("foot");
-		bip.push_back("force");
-		bip.push_back("forest");
-		bip.push_back("forget");
-		bip.push_back("fork");
-		bip.push_back("fortune");
-		bip.push_back("forum");
-		bip.push_back("forward");
-		bip.push_back("fossil");
-		bip.push_back("foster");
-		bip.push_back("found");
-		bip.push_back("fox");
-		bip.push_back("fragile");
-		bip.push_back("frame");
-		bip.push_back("frequent");
-		bip.push_back("fresh");
-		bip.push_back("friend");
-		bip.push_back("fringe");
-		bip.push_back("frog");
-		bip.push_back("front");
-		bip.push_back("frost");
-		bip.push_back("frown");
-		bip.push_back("frozen");
-		bip.push_back("fruit");
-		bip.push_back("fuel");
-		bip.push_back("fun");
-		bip.push_back("funny");
-		bip.push_back("furnace");
-		bip.push_back("fury");
-		bip.push_back("future");
-		bip.push_back("gadget");
-		bip.push_back("gain");
-		bip.push_back("galaxy");
-		bip.push_back("gallery");
-		bip.push_back("game");
-		bip.push_back("gap");
-		bip.push_back("garage");
-		bip.push_back("garbage");
-		bip.push_back("garden");
-		bip.push_back("garlic");
-		bip.push_back("garment");
-		bip.push_back("gas");
-		bip.push_back("gasp");
-		bip.push_back("gate");
-		bip.push_back("gather");
-		bip.push_back("gauge");
-		bip.push_back("gaze");
-		bip.push_back("general");
-		bip.push_back("genius");
-		bip.push_back("genre");
-		bip.push_back("gentle");
-		bip.push_back("genuine");
-		bip.push_back("gesture");
-		bip.push_back("ghost");
-		bip.push_back("giant");
-		bip.push_back("gift");
-		bip.push_back("giggle");
-		bip.push_back("ginger");
-		bip.push_back("giraffe");
-		bip.push_back("girl");
-		bip.push_back("give");
-		bip.push_back("glad");
-		bip.push_back("glance");
-		bip.push_back("glare");
-		bip.push_back("glass");
-		bip.push_back("glide");
-		bip.push_back("glimpse");
-		bip.push_back("globe");
-		bip.push_back("gloom");
-		bip.push_back("glory");
-		bip.push_back("glove");
-		bip.push_back("glow");
-		bip.push_back("glue");
-		bip.push_back("goat");
-		bip.push_back("goddess");
-		bip.push_back("gold");
-		bip.push_back("good");
-		bip.push_back("goose");
-		bip.push_back("gorilla");
-		bip.push_back("gospel");
-		bip.push_back("gossip");
-		bip.push_back("govern");
-		bip.push_back("gown");
-		bip.push_back("grab");
-		bip.push_back("grace");
-		bip.push_back("grain");
-		bip.push_back("grant");
-		bip.push_back("grape");
-		bip.push_back("grass");
-		bip.push_back("gravity");
-		bip.push_back("great");
-		bip.push_back("green");
-		bip.push_back("grid");
-		bip.push_back("grief");
-		bip.push_back("grit");
-		bip.push_back("grocery");
-		bip.push_back("group");
-		bip.push_back("grow");
-		bip.push_back("grunt");
-		bip.push_back("guard");
-		bip.push_back("guess");
-		bip.push_back("guide");
-		bip.push_back("guilt");
-		bip.push_back("guitar");
-		bip.push_back("gun");
-		bip.push_back("gym");
-		bip.push_back("habit");
-		bip.push_back("hair");
-		bip.push_back("half");
-		bip.push_back("hammer");
-		bip.push_back("hamster");
-		bip.push_back("hand");
-		bip.push_back("happy");
-		bip.push_back("harbor");
-		bip.push_back("hard");
-		bip.push_back("harsh");
-		bip.push_back("harvest");
-		bip.push_back("hat");
-		bip.push_back("have");
-		bip.push_back("hawk");
-		bip.push_back("hazard");
-		bip.push_back("head");
-		bip.push_back("health");
-		bip.push_back("heart");
-		bip.push_back("heavy");
-		bip.push_back("hedgehog");
-		bip.push_back("height");
-		bip.push_back("hello");
-		bip.push_back("helmet");
-		bip.push_back("help");
-		bip.push_back("hen");
-		bip.push_back("hero");
-		bip.push_back("hidden");
-		bip.push_back("high");
-		bip.push_back("hill");
-		bip.push_back("hint");
-		bip.push_back("hip");
-		bip.push_back("hire");
-		bip.push_back("history");
-		bip.push_back("hobby");
-		bip.push_back("hockey");
-		bip.push_back("hold");
-		bip.push_back("hole");
-		bip.push_back("holiday");
-		bip.push_back("hollow");
-		bip.push_back("home");
-		bip.push_back("honey");
-		bip.push_back("hood");
-		bip.push_back("hope");
-		bip.push_back("horn");
-		bip.push_back("horror");
-		bip.push_back("horse");
-		bip.push_back("hospital");
-		bip.push_back("host");
-		bip.push_back("hotel");
-		bip.push_back("hour");
-		bip.push_back("hover");
-		bip.push_back("hub");
-		bip.push_back("huge");
-		bip.push_back("human");
-		bip.push_back("humble");
-		bip.push_back("humor");
-		bip.push_back("hundred");
-		bip.push_back("hungry");
-		bip.push_back("hunt");
-		bip.push_back("hurdle");
-		bip.push_back("hurry");
-		bip.push_back("hurt");
-		bip.push_back("husband");
-		bip.push_back("hybrid");
-		bip.push_back("ice");
-		bip.push_back("icon");
-		bip.push_back("idea");
-		bip.push_back("identify");
-		bip.push_back("idle");
-		bip.push_back("ignore");
-		bip.push_back("ill");
-		bip.push_back("illegal");
-		bip.push_back("illness");
-		bip.push_back("image");
-		bip.push_back("imitate");
-		bip.push_back("immense");
-		bip.push_back("immune");
-		bip.push_back("impact");
-		bip.push_back("impose");
-		bip.push_back("improve");
-		bip.push_back("impulse");
-		bip.push_back("inch");
-		bip.push_back("include");
-		bip.push_back("income");
-		bip.push_back("increase");
-		bip.push_back("index");
-		bip.push_back("indicate");
-		bip.push_back("indoor");
-		bip.push_back("industry");
-		bip.push_back("infant");
-		bip.push_back("inflict");
-		bip.push_back("inform");
-		bip.push_back("inhale");
-		bip.push_back("inherit");
-		bip.push_back("initial");
-		bip.push_back("inject");
-		bip.push_back("injury");
-		bip.push_back("inmate");
-		bip.push_back("inner");
-		bip.push_back("innocent");
-		bip.push_back("input");
-		bip.push_back("inquiry");
-		bip.push_back("insane");
-		bip.push_back("insect");
-		bip.push_back("inside");
-		bip.push_back("inspire");
-		bip.push_back("install");
-		bip.push_back("intact");
-		bip.push_back("interest");
-		bip.push_back("into");
-		bip.push_back("invest");
-		bip.push_back("invite");
-		bip.push_back("involve");
-		bip.push_back("iron");
-		bip.push_back("island");
-		bip.push_back("isolate");
-		bip.push_back("issue");
-		bip.push_back("item");
-		bip.push_back("ivory");
-		bip.push_back("jacket");
-		bip.push_back("jaguar");
-		bip.push_back("jar");
-		bip.push_back("jazz");
-		bip.push_back("jealous");
-		bip.push_back("jeans");
-		bip.push_back("jelly");
-		bip.push_back("jewel");
-		bip.push_back("job");
-		bip.push_back("join");
-		bip.push_back("joke");
-		bip.push_back("journey");
-		bip.push_back("joy");
-		bip.push_back("judge");
-		bip.push_back("juice");
-		bip.push_back("jump");
-		bip.push_back("jungle");
-		bip.push_back("junior");
-		bip.push_back("junk");
-		bip.push_back("just");
-		bip.push_back("kangaroo");
-		bip.push_back("keen");
-		bip.push_back("keep");
-		bip.push_back("ketchup");
-		bip.push_back("key");
-		bip.push_back("kick");
-		bip.push_back("kid");
-		bip.push_back("kidney");
-		bip.push_back("kind");
-		bip.push_back("kingdom");
-		bip.push_back("kiss");
-		bip.push_back("kit");
-		bip.push_back("kitchen");
-		bip.push_back("kite");
-		bip.push_back("kitten");
-		bip.push_back("kiwi");
-		bip.push_back("knee");
-		bip.push_back("knife");
-		bip.push_back("knock");
-		bip.push_back("know");
-		bip.push_back("lab");
-		bip.push_back("label");
-		bip.push_back("labor");
-		bip.push_back("ladder");
-		bip.push_back("lady");
-		bip.push_back("lake");
-		bip.push_back("lamp");
-		bip.push_back("language");
-		bip.push_back("laptop");
-		bip.push_back("large");
-		bip.push_back("later");
-		bip.push_back("latin");
-		bip.push_back("laugh");
-		bip.push_back("laundry");
-		bip.push_back("lava");
-		bip.push_back("law");
-		bip.push_back("lawn");
-		bip.push_back("lawsuit");
-		bip.push_back("layer");
-		bip.push_back("lazy");
-		bip.push_back("leader");
-		bip.push_back("leaf");
-		bip.push_back("learn");
-		bip.push_back("leave");
-		bip.push_back("lecture");
-		bip.push_back("left");
-		bip.push_back("leg");
-		bip.push_back("legal");
-		bip.push_back("legend");
-		bip.push_back("leisure");
-		bip.push_back("lemon");
-		bip.push_back("lend");
-		bip.push_back("length");
-		bip.push_back("lens");
-		bip.push_back("leopard");
-		bip.push_back("lesson");
-		bip.push_back("letter");
-		bip.push_back("level");
-		bip.push_back("liar");
-		bip.push_back("liberty");
-		bip.push_back("library");
-		bip.push_back("license");
-		bip.push_back("life");
-		bip.push_back("lift");
-		bip.push_back("light");
-		bip.push_back("like");
-		bip.push_back("limb");
-		bip.push_back("limit");
-		bip.push_back("link");
-		bip.push_back("lion");
-		bip.push_back("liquid");
-		bip.push_back("list");
-		bip.push_back("little");
-		bip.push_back("live");
-		bip.push_back("lizard");
-		bip.push_back("load");
-		bip.push_back("loan");
-		bip.push_back("lobster");
-		bip.push_back("local");
-		bip.push_back("lock");
-		bip.push_back("logic");
-		bip.push_back("lonely");
-		bip.push_back("long");
-		bip.push_back("loop");
-		bip.push_back("lottery");
-		bip.push_back("loud");
-		bip.push_back("lounge");
-		bip.push_back("love");
-		bip.push_back("loyal");
-		bip.push_back("lucky");
-		bip.push_back("luggage");
-		bip.push_back("lumber");
-		bip.push_back("lunar");
-		bip.push_back("lunch");
-		bip.push_back("luxury");
-		bip.push_back("lyrics");
-		bip.push_back("machine");
-		bip.push_back("mad");
-		bip.push_back("magic");
-		bip.push_back("magnet");
-		bip.push_back("maid");
-		bip.push_back("mail");
-		bip.push_back("main");
-		bip.push_back("major");
-		bip.push_back("make");
-		bip.push_back("mammal");
-		bip.push_back("man");
-		bip.push_back("manage");
-		bip.push_back("mandate");
-		bip.push_back("mango");
-		bip.push_back("mansion");
-		bip.push_back("manual");
-		bip.push_back("maple");
-		bip.push_back("marble");
-		bip.push_back("march");
-		bip.push_back("margin");
-		bip.push_back("marine");
-		bip.push_back("market");
-		bip.push_back("marriage");
-		bip.push_back("mask");
-		bip.push_back("mass");
-		bip.push_back("master");
-		bip.push_back("match");
-		bip.push_back("material");
-		bip.push_back("math");
-		bip.push_back("matrix");
-		bip.push_back("matter");
-		bip.push_back("maximum");
-		bip.push_back("maze");
-		bip.push_back("meadow");
-		bip.push_back("mean");
-		bip.push_back("measure");
-		bip.push_back("meat");
-		bip.push_back("mechanic");
-		bip.push_back("medal");
-		bip.push_back("media");
-		bip.push_back("melody");
-		bip.push_back("melt");
-		bip.push_back("member");
-		bip.push_back("memory");
-		bip.push_back("mention");
-		bip.push_back("menu");
-		bip.push_back("mercy");
-		bip.push_back("merge");
-		bip.push_back("merit");
-		bip.push_back("merry");
-		bip.push_back("mesh");
-		bip.push_back("message");
-		bip.push_back("metal");
-		bip.push_back("method");
-		bip.push_back("middle");
-		bip.push_back("midnight");
-		bip.push_back("milk");
-		bip.push_back("million");
-		bip.push_back("mimic");
-		bip.push_back("mind");
-		bip.push_back("minimum");
-		bip.push_back("minor");
-		bip.push_back("minute");
-		bip.push_back("miracle");
-		bip.push_back("mirror");
-		bip.push_back("misery");
-		bip.push_back("miss");
-		bip.push_back("mistake");
-		bip.push_back("mix");
-		bip.push_back("mixed");
-		bip.push_back("mixture");
-		bip.push_back("mobile");
-		bip.push_back("model");
-		bip.push_back("modify");
-		bip.push_back("mom");
-		bip.push_back("moment");
-		bip.push_back("monitor");
-		bip.push_back("monkey");
-		bip.push_back("monster");
-		bip.push_back("month");
-		bip.push_back("moon");
-		bip.push_back("moral");
-		bip.push_back("more");
-		bip.push_back("morning");
-		bip.push_back("mosquito");
-		bip.push_back("mother");
-		bip.push_back("motion");
-		bip.push_back("motor");
-		bip.push_back("mountain");
-		bip.push_back("mouse");
-		bip.push_back("move");
-		bip.push_back("movie");
-		bip.push_back("much");
-		bip.push_back("muffin");
-		bip.push_back("mule");
-		bip.push_back("multiply");
-		bip.push_back("muscle");
-		bip.push_back("museum");
-		bip.push_back("mushroom");
-		bip.push_back("music");
-		bip.push_back("must");
-		bip.push_back("mutual");
-		bip.push_back("myself");
-		bip.push_back("mystery");
-		bip.push_back("myth");
-		bip.push_back("naive");
-		bip.push_back("name");
-		bip.push_back("napkin");
-		bip.push_back("narrow");
-		bip.push_back("nasty");
-		bip.push_back("nation");
-		bip.push_back("nature");
-		bip.push_back("near");
-		bip.push_back("neck");
-		bip.push_back("need");
-		bip.push_back("negative");
-		bip.push_back("neglect");
-		bip.push_back("neither");
-		bip.push_back("nephew");
-		bip.push_back("nerve");
-		bip.push_back("nest");
-		bip.push_back("net");
-		bip.push_back("network");
-		bip.push_back("neutral");
-		bip.push_back("never");
-		bip.push_back("news");
-		bip.push_back("next");
-		bip.push_back("nice");
-		bip.push_back("night");
-		bip.push_back("noble");
-		bip.push_back("noise");
-		bip.push_back("nominee");
-		bip.push_back("noodle");
-		bip.push_back("normal");
-		bip.push_back("north");
-		bip.push_back("nose");
-		bip.push_back("notable");
-		bip.push_back("note");
-		bip.push_back("nothing");
-		bip.push_back("notice");
-		bip.push_back("novel");
-		bip.push_back("now");
-		bip.push_back("nuclear");
-		bip.push_back("number");
-		bip.push_back("nurse");
-		bip.push_back("nut");
-		bip.push_back("oak");
-		bip.push_back("obey");
-		bip.push_back("object");
-		bip.push_back("oblige");
-		bip.push_back("obscure");
-		bip.push_back("observe");
-		bip.push_back("obtain");
-		bip.push_back("obvious");
-		bip.push_back("occur");
-		bip.push_back("ocean");
-		bip.push_back("october");
-		bip.push_back("odor");
-		bip.push_back("off");
-		bip.push_back("offer");
-		bip.push_back("office");
-		bip.push_back("often");
-		bip.push_back("oil");
-		bip.push_back("okay");
-		bip.push_back("old");
-		bip.push_back("olive");
-		bip.push_back("olympic");
-		bip.push_back("omit");
-		bip.push_back("once");
-		bip.push_back("one");
-		bip.push_back("onion");
-		bip.push_back("online");
-		bip.push_back("only");
-		bip.push_back("open");
-		bip.push_back("opera");
-		bip.push_back("opinion");
-		bip.push_back("oppose");
-		bip.push_back("option");
-		bip.push_back("orange");
-		bip.push_back("orbit");
-		bip.push_back("orchard");
-		bip.push_back("order");
-		bip.push_back("ordinary");
-		bip.push_back("organ");
-		bip.push_back("orient");
-		bip.push_back("original");
-		bip.push_back("orphan");
-		bip.push_back("ostrich");
-		bip.push_back("other");
-		bip.push_back("outdoor");
-		bip.push_back("outer");
-		bip.push_back("output");
-		bip.push_back("outside");
-		bip.push_back("oval");
-		bip.push_back("oven");
-		bip.push_back("over");
-		bip.push_back("own");
-		bip.push_back("owner");
-		bip.push_back("oxygen");
-		bip.push_back("oyster");
-		bip.push_back("ozone");
-		bip.push_back("pact");
-		bip.push_back("paddle");
-		bip.push_back("page");
-		bip.push_back("pair");
-		bip.push_back("palace");
-		bip.push_back("palm");
-		bip.push_back("panda");
-		bip.push_back("panel");
-		bip.push_back("panic");
-		bip.push_back("panther");
-		bip.push_back("paper");
-		bip.push_back("parade");
-		bip.push_back("parent");
-		bip.push_back("park");
-		bip.push_back("parrot");
-		bip.push_back("party");
-		bip.push_back("pass");
-		bip.push_back("patch");
-		bip.push_back("path");
-		bip.push_back("patient");
-		bip.push_back("patrol");
-		bip.push_back("pattern");
-		bip.push_back("pause");
-		bip.push_back("pave");
-		bip.push_back("payment");
-		bip.push_back("peace");
-		bip.push_back("peanut");
-		bip.push_back("pear");
-		bip.push_back("peasant");
-		bip.push_back("pelican");
-		bip.push_back("pen");
-		bip.push_back("penalty");
-		bip.push_back("pencil");
-		bip.push_back("people");
-		bip.push_back("pepper");
-		bip.push_back("perfect");
-		bip.push_back("permit");
-		bip.push_back("person");
-		bip.push_back("pet");
-		bip.push_back("phone");
-		bip.push_back("photo");
-		bip.push_back("phrase");
-		bip.push_back("physical");
-		bip.push_back("piano");
-		bip.push_back("picnic");
-		bip.push_back("picture");
-		bip.push_back("piece");
-		bip.push_back("pig");
-		bip.push_back("pigeon");
-		bip.push_back("pill");
-		bip.push_back("pilot");
-		bip.push_back("pink");
-		bip.push_back("pioneer");
-		bip.push_back("pipe");
-		bip.push_back("pistol");
-		bip.push_back("pitch");
-		bip.push_back("pizza");
-		bip.push_back("place");
-		bip.push_back("planet");
-		bip.push_back("plastic");
-		bip.push_back("plate");
-		bip.push_back("play");
-		bip.push_back("please");
-		bip.push_back("pledge");
-		bip.push_back("pluck");
-		bip.push_back("plug");
-		bip.push_back("plunge");
-		bip.push_back("poem");
-		bip.push_back("poet");
-		bip.push_back("point");
-		bip.push_back("polar");
-		bip.push_back("pole");
-		bip.push_back("police");
-		bip.push_back("pond");
-		bip.push_back("pony");
-		bip.push_back("pool");
-		bip.push_back("popular");
-		bip.push_back("portion");
-		bip.push_back("position");
-		bip.push_back("possible");
-		bip.push_back("post");
-		bip.push_back("potato");
-		bip.push_back("pottery");
-		bip.push_back("poverty");
-		bip.push_back("powder");
-		bip.push_back("power");
-		bip.push_back("practice");
-		bip.push_back("praise");
-		bip.push_back("predict");
-		bip.push_back("prefer");
-		bip.push_back("prepare");
-		bip.push_back("present");
-		bip.push_back("pretty");
-		bip.push_back("prevent");
-		bip.push_back("price");
-		bip.push_back("pride");
-		bip.push_back("primary");
-		bip.push_back("print");
-		bip.push_back("priority");
-		bip.push_back("prison");
-		bip.push_back("private");
-		bip.push_back("prize");
-		bip.push_back("problem");
-		bip.push_back("process");
-		bip.push_back("produce");
-		bip.push_back("profit");
-		bip.push_back("program");
-		bip.push_back("project");
-		bip.push_back("promote");
-		bip.push_back("proof");
-		bip.push_back("property");
-		bip.push_back("prosper");
-		bip.push_back("protect");
-		bip.push_back("proud");
-		bip.push_back("provide");
-		bip.push_back("public");
-		bip.push_back("pudding");
-		bip.push_back("pull");
-		bip.push_back("pulp");
-		bip.push_back("pulse");
-		bip.push_back("pumpkin");
-		bip.push_back("punch");
-		bip.push_back("pupil");
-		bip.push_back("puppy");
-		bip.push_back("purchase");
-		bip.push_back("purity");
-		bip.push_back("purpose");
-		bip.push_back("purse");
-		bip.push_back("push");
-		bip.push_back("put");
-		bip.push_back("puzzle");
-		bip.push_back("pyramid");
-		bip.push_back("quality");
-		bip.push_back("quantum");
-		bip.push_back("quarter");
-		bip.push_back("question");
-		bip.push_back("quick");
-		bip.push_back("quit");
-		bip.push_back("quiz");
-		bip.push_back("quote");
-		bip.push_back("rabbit");
-		bip.push_back("raccoon");
-		bip.push_back("race");
-		bip.push_back("rack");
-		bip.push_back("radar");
-		bip.push_back("radio");
-		bip.push_back("rail");
-		bip.push_back("rain");
-		bip.push_back("raise");
-		bip.push_back("rally");
-		bip.push_back("ramp");
-		bip.push_back("ranch");
-		bip.push_back("random");
-		bip.push_back("range");
-		bip.push_back("rapid");
-		bip.push_back("rare");
-		bip.push_back("rate");
-		bip.push_back("rather");
-		bip.push_back("raven");
-		bip.push_back("raw");
-		bip.push_back("razor");
-		bip.push_back("ready");
-		bip.push_back("real");
-		bip.push_back("reason");
-		bip.push_back("rebel");
-		bip.push_back("rebuild");
-		bip.push_back("recall");
-		bip.push_back("receive");
-		bip.push_back("recipe");
-		bip.push_back("record");
-		bip.push_back("recycle");
-		bip.push_back("reduce");
-		bip.push_back("reflect");
-		bip.push_back("reform");
-		bip.push_back("refuse");
-		bip.push_back("region");
-		bip.push_back("regret");
-		bip.push_back("regular");
-		bip.push_back("reject");
-		bip.push_back("relax");
-		bip.push_back("release");
-		bip.push_back("relief");
-		bip.push_back("rely");
-		bip.push_back("remain");
-		bip.push_back("remember");
-		bip.push_back("remind");
-		bip.push_back("remove");
-		bip.push_back("render");
-		bip.push_back("renew");
-		bip.push_back("rent");
-		bip.push_back("reopen");
-		bip.push_back("repair");
-		bip.push_back("repeat");
-		bip.push_back("replace");
-		bip.push_back("report");
-		bip.push_back("require");
-		bip.push_back("rescue");
-		bip.push_back("resemble");
-		bip.push_back("resist");
-		bip.push_back("resource");
-		bip.push_back("response");
-		bip.push_back("result");
-		bip.push_back("retire");
-		bip.push_back("retreat");
-		bip.push_back("return");
-		bip.push_back("reunion");
-		bip.push_back("reveal");
-		bip.push_back("review");
-		bip.push_back("reward");
-		bip.push_back("rhythm");
-		bip.push_back("rib");
-		bip.push_back("ribbon");
-		bip.push_back("rice");
-		bip.push_back("rich");
-		bip.push_back("ride");
-		bip.push_back("ridge");
-		bip.push_back("rifle");
-		bip.push_back("right");
-		bip.push_back("rigid");
-		bip.push_back("ring");
-		bip.push_back("riot");
-		bip.push_back("ripple");
-		bip.push_back("risk");
-		bip.push_back("ritual");
-		bip.push_back("rival");
-		bip.push_back("river");
-		bip.push_back("road");
-		bip.push_back("roast");
-		bip.push_back("robot");
-		bip.push_back("robust");
-		bip.push_back("rocket");
-		bip.push_back("romance");
-		bip.push_back("roof");
-		bip.push_back("rookie");
-		bip.push_back("room");
-		bip.push_back("rose");
-		bip.push_back("rotate");
-		bip.push_back("rough");
-		bip.push_back("round");
-		bip.push_back("route");
-		bip.push_back("royal");
-		bip.push_back("rubber");
-		bip.push_back("rude");
-		bip.push_back("rug");
-		bip.push_back("rule");
-		bip.push_back("run");
-		bip.push_back("runway");
-		bip.push_back("rural");
-		bip.push_back("sad");
-		bip.push_back("saddle");
-		bip.push_back("sadness");
-		bip.push_back("safe");
-		bip.push_back("sail");
-		bip.push_back("salad");
-		bip.push_back("salmon");
-		bip.push_back("salon");
-		bip.push_back("salt");
-		bip.push_back("salute");
-		bip.push_back("same");
-		bip.push_back("sample");
-		bip.push_back("sand");
-		bip.push_back("satisfy");
-		bip.push_back("satoshi");
-		bip.push_back("sauce");
-		bip.push_back("sausage");
-		bip.push_back("save");
-		bip.push_back("say");
-		bip.push_back("scale");
-		bip.push_back("scan");
-		bip.push_back("scare");
-		bip.push_back("scatter");
-		bip.push_back("scene");
-		bip.push_back("scheme");
-		bip.push_back("school");
-		bip.push_back("science");
-		bip.push_back("scissors");
-		bip.push_back("scorpion");
-		bip.push_back("scout");
-		bip.push_back("scrap");
-		bip.push_back("screen");
-		bip.push_back("script");
-		bip.push_back("scrub");
-		bip.push_back("sea");
-		bip.push_back("search");
-		bip.push_back("season");
-		bip.push_back("seat");
-		bip.push_back("second");
-		bip.push_back("secret");
-		bip.push_back("section");
-		bip.push_back("security");
-		bip.push_back("seed");
-		bip.push_back("seek");
-		bip.push_back("segment");
-		bip.push_back("select");
-		bip.push_back("sell");
-		bip.push_back("seminar");
-		bip.push_back("senior");
-		bip.push_back("sense");
-		bip.push_back("sentence");
-		bip.push_back("series");
-		bip.push_back("service");
-		bip.push_back("session");
-		bip.push_back("settle");
-		bip.push_back("setup");
-		bip.push_back("seven");
-		bip.push_back("shadow");
-		bip.push_back("shaft");
-		bip.push_back("shallow");
-		bip.push_back("share");
-		bip.push_back("shed");
-		bip.push_back("shell");
-		bip.push_back("sheriff");
-		bip.push_back("shield");
-		bip.push_back("shift");
-		bip.push_back("shine");
-		bip.push_back("ship");
-		bip.push_back("shiver");
-		bip.push_back("shock");
-		bip.push_back("shoe");
-		bip.push_back("shoot");
-		bip.push_back("shop");
-		bip.push_back("short");
-		bip.push_back("shoulder");
-		bip.push_back("shove");
-		bip.push_back("shrimp");
-		bip.push_back("shrug");
-		bip.push_back("shuffle");
-		bip.push_back("shy");
-		bip.push_back("sibling");
-		bip.push_back("sick");
-		bip.push_back("side");
-		bip.push_back("siege");
-		bip.push_back("sight");
-		bip.push_back("sign");
-		bip.push_back("silent");
-		bip.push_back("silk");
-		bip.push_back("silly");
-		bip.push_back("silver");
-		bip.push_back("similar");
-		bip.push_back("simple");
-		bip.push_back("since");
-		bip.push_back("sing");
-		bip.push_back("siren");
-		bip.push_back("sister");
-		bip.push_back("situate");
-		bip.push_back("six");
-		bip.push_back("size");
-		bip.push_back("skate");
-		bip.push_back("sketch");
-		bip.push_back("ski");
-		bip.push_back("skill");
-		bip.push_back("skin");
-		bip.push_back("skirt");
-		bip.push_back("skull");
-		bip.push_back("slab");
-		bip.push_back("slam");
-		bip.push_back("sleep");
-		bip.push_back("slender");
-		bip.push_back("slice");
-		bip.push_back("slide");
-		bip.push_back("slight");
-		bip.push_back("slim");
-		bip.push_back("slogan");
-		bip.push_back("slot");
-		bip.push_back("slow");
-		bip.push_back("slush");
-		bip.push_back("small");
-		bip.push_back("smart");
-		bip.push_back("smile");
-		bip.push_back("smoke");
-		bip.push_back("smooth");
-		bip.push_back("snack");
-		bip.push_back("snake");
-		bip.push_back("snap");
-		bip.push_back("sniff");
-		bip.push_back("snow");
-		bip.push_back("soap");
-		bip.push_back("soccer");
-		bip.push_back("social");
-		bip.push_back("sock");
-		bip.push_back("soda");
-		bip.push_back("soft");
-		bip.push_back("solar");
-		bip.push_back("soldier");
-		bip.push_back("solid");
-		bip.push_back("solution");
-		bip.push_back("solve");
-		bip.push_back("someone");
-		bip.push_back("song");
-		bip.push_back("soon");
-		bip.push_back("sorry");
-		bip.push_back("sort");
-		bip.push_back("soul");
-		bip.push_back("sound");
-		bip.push_back("soup");
-		bip.push_back("source");
-		bip.push_back("south");
-		bip.push_back("space");
-		bip.push_back("spare");
-		bip.push_back("spatial");
-		bip.push_back("spawn");
-		bip.push_back("speak");
-		bip.push_back("special");
-		bip.push_back("speed");
-		bip.push_back("spell");
-		bip.push_back("spend");
-		bip.push_back("sphere");
-		bip.push_back("spice");
-		bip.push_back("spider");
-		bip.push_back("spike");
-		bip.push_back("spin");
-		bip.push_back("spirit");
-		bip.push_back("split");
-		bip.push_back("spoil");
-		bip.push_back("sponsor");
-		bip.push_back("spoon");
-		bip.push_back("sport");
-		bip.push_back("spot");
-		bip.push_back("spray");
-		bip.push_back("spread");
-		bip.push_back("spring");
-		bip.push_back("spy");
-		bip.push_back("square");
-		bip.push_back("squeeze");
-		bip.push_back("squirrel");
-		bip.push_back("stable");
-		bip.push_back("stadium");
-		bip.push_back("staff");
-		bip.push_back("stage");
-		bip.push_back("stairs");
-		bip.push_back("stamp");
-		bip.push_back("stand");
-		bip.push_back("start");
-		bip.push_back("state");
-		bip.push_back("stay");
-		bip.push_back("steak");
-		bip.push_back("steel");
-		bip.push_back("stem");
-		bip.push_back("step");
-		bip.push_back("stereo");
-		bip.push_back("stick");
-		bip.push_back("still");
-		bip.push_back("sting");
-		bip.push_back("stock");
-		bip.push_back("stomach");
-		bip.push_back("stone");
-		bip.push_back("stool");
-		bip.push_back("story");
-		bip.push_back("stove");
-		bip.push_back("strategy");
-		bip.push_back("street");
-		bip.push_back("strike");
-		bip.push_back("strong");
-		bip.push_back("struggle");
-		bip.push_back("student");
-		bip.push_back("stuff");
-		bip.push_back("stumble");
-		bip.push_back("style");
-		bip.push_back("subject");
-		bip.push_back("submit");
-		bip.push_back("subway");
-		bip.push_back("success");
-		bip.push_back("such");
-		bip.push_back("sudden");
-		bip.push_back("suffer");
-		bip.push_back("sugar");
-		bip.push_back("suggest");
-		bip.push_back("suit");
-		bip.push_back("summer");
-		bip.push_back("sun");
-		bip.push_back("sunny");
-		bip.push_back("sunset");
-		bip.push_back("super");
-		bip.push_back("supply");
-		bip.push_back("supreme");
-		bip.push_back("sure");
-		bip.push_back("surface");
-		bip.push_back("surge");
-		bip.push_back("surprise");
-		bip.push_back("surround");
-		bip.push_back("survey");
-		bip.push_back("suspect");
-		bip.push_back("sustain");
-		bip.push_back("swallow");
-		bip.push_back("swamp");
-		bip.push_back("swap");
-		bip.push_back("swarm");
-		bip.push_back("swear");
-		bip.push_back("sweet");
-		bip.push_back("swift");
-		bip.push_back("swim");
-		bip.push_back("swing");
-		bip.push_back("switch");
-		bip.push_back("sword");
-		bip.push_back("symbol");
-		bip.push_back("symptom");
-		bip.push_back("syrup");
-		bip.push_back("system");
-		bip.push_back("table");
-		bip.push_back("tackle");
-		bip.push_back("tag");
-		bip.push_back("tail");
-		bip.push_back("talent");
-		bip.push_back("talk");
-		bip.push_back("tank");
-		bip.push_back("tape");
-		bip.push_back("target");
-		bip.push_back("task");
-		bip.push_back("taste");
-		bip.push_back("tattoo");
-		bip.push_back("taxi");
-		bip.push_back("teach");
-		bip.push_back("team");
-		bip.push_back("tell");
-		bip.push_back("ten");
-		bip.push_back("tenant");
-		bip.push_back("tennis");
-		bip.push_back("tent");
-		bip.push_back("term");
-		bip.push_back("test");
-		bip.push_back("text");
-		bip.push_back("thank");
-		bip.push_back("that");
-		bip.push_back("theme");
-		bip.push_back("then");
-		bip.push_back("theory");
-		bip.push_back("there");
-		bip.push_back("they");
-		bip.push_back("thing");
-		bip.push_back("this");
-		bip.push_back("thought");
-		bip.push_back("three");
-		bip.push_back("thrive");
-		bip.push_back("throw");
-		bip.push_back("thumb");
-		bip.push_back("thunder");
-		bip.push_back("ticket");
-		bip.push_back("tide");
-		bip.push_back("tiger");
-		bip.push_back("tilt");
-		bip.push_back("timber");
-		bip.push_back("time");
-		bip.push_back("tiny");
-		bip.push_back("tip");
-		bip.push_back("tired");
-		bip.push_back("tissue");
-		bip.push_back("title");
-		bip.push_back("toast");
-		bip.push_back("tobacco");
-		bip.push_back("today");
-		bip.push_back("toddler");
-		bip.push_back("toe");
-		bip.push_back("together");
-		bip.push_back("toilet");
-		bip.push_back("token");
-		bip.push_back("tomato");
-		bip.push_back("tomorrow");
-		bip.push_back("tone");
-		bip.push_back("tongue");
-		bip.push_back("tonight");
-		bip.push_back("tool");
-		bip.push_back("tooth");
-		bip.push_back("top");
-		bip.push_back("topic");
-		bip.push_back("topple");
-		bip.push_back("torch");
-		bip.push_back("tornado");
-		bip.push_back("tortoise");
-		bip.push_back("toss");
-		bip.push_back("total");
-		bip.push_back("tourist");
-		bip.push_back("toward");
-		bip.push_back("tower");
-		bip.push_back("town");
-		bip.push_back("toy");
-		bip.push_back("track");
-		bip.push_back("trade");
-		bip.push_back("traffic");
-		bip.push_back("tragic");
-		bip.push_back("train");
-		bip.push_back("transfer");
-		bip.push_back("trap");
-		bip.push_back("trash");
-		bip.push_back("travel");
-		bip.push_back("tray");
-		bip.push_back("treat");
-		bip.push_back("tree");
-		bip.push_back("trend");
-		bip.push_back("trial");
-		bip.push_back("tribe");
-		bip.push_back("trick");
-		bip.push_back("trigger");
-		bip.push_back("trim");
-		bip.push_back("trip");
-		bip.push_back("trophy");
-		bip.push_back("trouble");
-		bip.push_back("truck");
-		bip.push_back("true");
-		bip.push_back("truly");
-		bip.push_back("trumpet");
-		bip.push_back("trust");
-		bip.push_back("truth");
-		bip.push_back("try");
-		bip.push_back("tube");
-		bip.push_back("tuition");
-		bip.push_back("tumble");
-		bip.push_back("tuna");
-		bip.push_back("tunnel");
-		bip.push_back("turkey");
-		bip.push_back("turn");
-		bip.push_back("turtle");
-		bip.push_back("twelve");
-		bip.push_back("twenty");
-		bip.push_back("twice");
-		bip.push_back("twin");
-		bip.push_back("twist");
-		bip.push_back("two");
-		bip.push_back("type");
-		bip.push_back("typical");
-		bip.push_back("ugly");
-		bip.push_back("umbrella");
-		bip.push_back("unable");
-		bip.push_back("unaware");
-		bip.push_back("uncle");
-		bip.push_back("uncover");
-		bip.push_back("under");
-		bip.push_back("undo");
-		bip.push_back("unfair");
-		bip.push_back("unfold");
-		bip.push_back("unhappy");
-		bip.push_back("uniform");
-		bip.push_back("unique");
-		bip.push_back("unit");
-		bip.push_back("universe");
-		bip.push_back("unknown");
-		bip.push_back("unlock");
-		bip.push_back("until");
-		bip.push_back("unusual");
-		bip.push_back("unveil");
-		bip.push_back("update");
-		bip.push_back("upgrade");
-		bip.push_back("uphold");
-		bip.push_back("upon");
-		bip.push_back("upper");
-		bip.push_back("upset");
-		bip.push_back("urban");
-		bip.push_back("urge");
-		bip.push_back("usage");
-		bip.push_back("use");
-		bip.push_back("used");
-		bip.push_back("useful");
-		bip.push_back("useless");
-		bip.push_back("usual");
-		bip.push_back("utility");
-		bip.push_back("vacant");
-		bip.push_back("vacuum");
-		bip.push_back("vague");
-		bip.push_back("valid");
-		bip.push_back("valley");
-		bip.push_back("valve");
-		bip.push_back("van");
-		bip.push_back("vanish");
-		bip.push_back("vapor");
-		bip.push_back("various");
-		bip.push_back("vast");
-		bip.push_back("vault");
-		bip.push_back("vehicle");
-		bip.push_back("velvet");
-		bip.push_back("vendor");
-		bip.push_back("venture");
-		bip.push_back("venue");
-		bip.push_back("verb");
-		bip.push_back("verify");
-		bip.push_back("version");
-		bip.push_back("very");
-		bip.push_back("vessel");
-		bip.push_back("veteran");
-		bip.push_back("viable");
-		bip.push_back("vibrant");
-		bip.push_back("vicious");
-		bip.push_back("victory");
-		bip.push_back("video");
-		bip.push_back("view");
-		bip.push_back("village");
-		bip.push_back("vintage");
-		bip.push_back("violin");
-		bip.push_back("virtual");
-		bip.push_back("virus");
-		bip.push_back("visa");
-		bip.push_back("visit");
-		bip.push_back("visual");
-		bip.push_back("vital");
-		bip.push_back("vivid");
-		bip.push_back("vocal");
-		bip.push_back("voice");
-		bip.push_back("void");
-		bip.push_back("volcano");
-		bip.push_back("volume");
-		bip.push_back("vote");
-		bip.push_back("voyage");
-		bip.push_back("wage");
-		bip.push_back("wagon");
-		bip.push_back("wait");
-		bip.push_back("walk");
-		bip.push_back("wall");
-		bip.push_back("walnut");
-		bip.push_back("want");
-		bip.push_back("warfare");
-		bip.push_back("warm");
-		bip.push_back("warrior");
-		bip.push_back("wash");
-		bip.push_back("wasp");
-		bip.push_back("waste");
-		bip.push_back("water");
-		bip.push_back("wave");
-		bip.push_back("way");
-		bip.push_back("wealth");
-		bip.push_back("weapon");
-		bip.push_back("wear");
-		bip.push_back("weasel");
-		bip.push_back("weather");
-		bip.push_back("web");
-		bip.push_back("wedding");
-		bip.push_back("weekend");
-		bip.push_back("weird");
-		bip.push_back("welcome");
-		bip.push_back("west");
-		bip.push_back("wet");
-		bip.push_back("whale");
-		bip.push_back("what");
-		bip.push_back("wheat");
-		bip.push_back("wheel");
-		bip.push_back("when");
-		bip.push_back("where");
-		bip.push_back("whip");
-		bip.push_back("whisper");
-		bip.push_back("wide");
-		bip.push_back("width");
-		bip.push_back("wife");
-		bip.push_back("wild");
-		bip.push_back("will");
-		bip.push_back("win");
-		bip.push_back("window");
-		bip.push_back("wine");
-		bip.push_back("wing");
-		bip.push_back("wink");
-		bip.push_back("winner");
-		bip.push_back("winter");
-		bip.push_back("wire");
-		bip.push_back("wisdom");
-		bip.push_back("wise");
-		bip.push_back("wish");
-		bip.push_back("witness");
-		bip.push_back("wolf");
-		bip.push_back("woman");
-		bip.push_back("wonder");
-		bip.push_back("wood");
-		bip.push_back("wool");
-		bip.push_back("word");
-		bip.push_back("work");
-		bip.push_back("world");
-		bip.push_back("worry");
-		bip.push_back("worth");
-		bip.push_back("wrap");
-		bip.push_back("wreck");
-		bip.push_back("wrestle");
-		bip.push_back("wrist");
-		bip.push_back("write");
-		bip.push_back("wrong");
-		bip.push_back("yard");
-		bip.push_back("year");
-		bip.push_back("yellow");
-		bip.push_back("you");
-		bip.push_back("young");
-		bip.push_back("youth");
-		bip.push_back("zebra");
-		bip.push_back("zero");
-		bip.push_back("zone");
-		bip.push_back("zoo");
-		added = true;
+		size_t slot = bip39Slot(bip39Prefix(bip39Words[idx]));
+		while (table[slot] != 0xffff)
+			slot = (slot + 1) & 4095;
+		table[slot] = idx;
 	}
-	return bip[idx];
+	return table;
+}
+constexpr array<uint16_t,4096> bip39Index = bip39BuildIndex();
+
+inline string getWord(int idx)
+{
+	return string(bip39Words[idx]);
+}
+
+// Index of a word (or of its unique 4 letter abbreviation), -1 if it is not in the list
+inline int getIndex(string_view word)
+{
+	if (word.size() < 3 || word.size() > 8)
+		return -1;
+	uint32_t key = bip39Prefix(word);
+	for (size_t slot = bip39Slot(key); bip39Index[slot] != 0xffff; slot = (slot + 1) & 4095)
+	{
+		string_view candidate = bip39Words[bip39Index[slot]];
+		if (bip39Prefix(candidate) != key)
+			continue;
+		if (candidate == word || (word.size() == 4 && candidate.size() > 4))
+			return bip39Index[slot];
+		return -1;
+	}
+	return -1;
 }
-#endif
 
+// Split 256 bits of entropy plus the 8 bit checksum into 24 word indexes
+inline void toBIP39Indexes(const uint8_t entropy[32], uint16_t idx[24])
+{
+	uint8_t bits[33];
+	memcpy(bits, entropy, 32);
+	computeSHA256(entropy, 32, bits + 32); // Checksum is the first byte of the hash
+	uint32_t acc = 0;
+	int accBits = 0, pos = 0;
+	for (int i=0; i<24; i++)
+	{
+		while (accBits < 11)
+		{
+			acc = (acc << 8) | bits[pos++];
+			accBits += 8;
+		}
+		accBits -= 11;
+		idx[i] = (acc >> accBits) & 2047;
+	}
+}
+
+// Write the 24 word mnemonic separated by single spaces, no allocation.
+// dest needs room for 24*9 characters; returns the length written (without terminating zero).
+inline size_t toBIP39(const uint8_t entropy[32], char *dest)
+{
+	uint16_t idx[24];
+	toBIP39Indexes(entropy, idx);
+	size_t len = 0;
+	for (int i=0; i<24; i++)
+	{
+		if (i > 0)
+			dest[len++] = ' ';
+		string_view word = bip39Words[idx[i]];
+		memcpy(dest + len, word.data(), word.size());
+		len += word.size();
+	}
+	return len;
+}
+
+// Recover the entropy from a mnemonic, no allocation.
+// Without length only 24 word mnemonics are accepted; with it 12, 15, 18, 21 or 24 words
+// are accepted and the entropy size in bytes (16 to 32) is stored there.
+// Returns 0 on success, -1 for an unknown word or wrong word count and -2 for a bad checksum.
+inline int fromBIP39(string_view mnemonic, uint8_t entropy[32], size_t *length = nullptr)
+{
+	uint8_t bits[33] = {0};
+	uint32_t acc = 0;
+	int accBits = 0, pos = 0, words = 0;
+	size_t i = 0;
+	while (i < mnemonic.size())
+	{
+		// Words may be separated by any run of white space
+		while (i < mnemonic.size() && isspace((unsigned char)mnemonic[i]))
+			i++;
+		size_t start = i;
+		while (i < mnemonic.size() && !isspace((unsigned char)mnemonic[i]))
+			i++;
+		if (start == i)
+			break;
+		int idx = getIndex(mnemonic.substr(start, i - start));
+		if (idx < 0 || words == 24)
+			return -1;
+		words++;
+		acc = (acc << 11) | idx;
+		accBits += 11;
+		while (accBits >= 8)
+		{
+			accBits -= 8;
+			bits[pos++] = (acc >> accBits) & 255;
+		}
+	}
+	if (accBits > 0)
+		bits[pos] = (acc << (8 - accBits)) & 255;
+	if (length == nullptr ? words != 24 : (words < 12 || words % 3 != 0))
+		return -1;
+
+	// Entropy is 32 bits for every 3 words, the checksum one bit for every 32 bits of entropy
+	size_t len = words / 3 * 4;
+	int checksumBits = len / 4;
+	uint8_t hash[32];
+	computeSHA256(bits, len, hash);
+	if ((hash[0] >> (8 - checksumBits)) != (bits[len] >> (8 - checksumBits)))
+		return -2;
+	memcpy(entropy, bits, len);
+	if (length != nullptr)
+		*length = len;
+	return 0;
+}
+#endif
@@ -0,0 +1,15 @@
+#ifndef CHAINENGINE_H
+
+#define CHAINENGINE_H
+
+// The cw_engine of chainwallet.h as the command line drives it. Not part of the C API.
+//
+// The command line needs every hash of the chain for transcripts, traces and printing, so the engine
+// steps with an observer called after each hash. Without one it runs the same loop as cw_engine_step.
+
+#include "chainwallet.h"
+#include <functional>
+
+int cwEngineStep(cw_engine *engine, uint64_t maxHashes, const std::function<void(const uint8_t *)> *observer);
+
+#endif
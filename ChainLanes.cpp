@@ -0,0 +1,73 @@
+// Multi-lane chains
+#include "ChainLanes.h"
+#include "SHA256.h"
+#include <string.h>
+using namespace std;
+
+void laneStart(const uint8_t passwordHash[32], uint32_t lane, uint8_t out[32])
+{
+	uint8_t index[4] = {(uint8_t)(lane >> 24), (uint8_t)(lane >> 16), (uint8_t)(lane >> 8), (uint8_t)lane};
+	sha256_ctx_t sc;
+	sha256_init(&sc);
+	sha256_update(&sc, "ChainWallet lane", 16);
+	sha256_update(&sc, index, 4);
+	sha256_update(&sc, passwordHash, 32);
+	sha256_finalize(&sc, out);
+}
+
+uint64_t laneLength(uint64_t total, uint32_t k, uint32_t lane)
+{
+	return total / k + (lane < total % k ? 1 : 0);
+}
+
+ChainLanes::ChainLanes(const uint8_t passwordHash[32], uint64_t total, uint32_t k)
+	: ends(32 * k), progress(k), running(k)
+{
+	for (uint32_t i=0; i<k; i++)
+	{
+		laneStart(passwordHash, i, &ends[32 * i]);
+		progress[i] = 0;
+	}
+	for (uint32_t i=0; i<k; i++)
+		threads.push_back(thread(&ChainLanes::run, this, i, laneLength(total, k, i)));
+}
+
+ChainLanes::~ChainLanes()
+{
+	for (size_t i=0; i<threads.size(); i++)
+		if (threads[i].joinable())
+			threads[i].join();
+}
+
+void ChainLanes::run(uint32_t lane, uint64_t length)
+{
+	// Same loop as the single chain, on a local copy of the state
+	uint8_t hashBuf[32], src[32];
+	memcpy(hashBuf, &ends[32 * lane], 32);
+	for (uint64_t j=1; j<length; j++)
+	{
+		memcpy(src, hashBuf, 32);
+		computeSHA256(src, 32, hashBuf);
+		if ((j & 0xffff) == 0)
+			progress[lane].store(j, memory_order_relaxed);
+	}
+	memcpy(&ends[32 * lane], hashBuf, 32);
+	progress[lane].store(length, memory_order_relaxed);
+	running--;
+}
+
+uint64_t ChainLanes::done() const
+{
+	uint64_t sum = 0;
+	for (size_t i=0; i<progress.size(); i++)
+		sum += progress[i].load(memory_order_relaxed);
+	return sum;
+}
+
+void ChainLanes::key(uint8_t out[32])
+{
+	for (size_t i=0; i<threads.size(); i++)
+		if (threads[i].joinable())
+			threads[i].join();
+	computeSHA256(ends.data(), ends.size(), out);
+}
@@ -0,0 +1,46 @@
+#ifndef CHAINLANES_H
+
+#define CHAINLANES_H
+
+// Multi-lane chains: the B^N hashes of a wallet are split over K independent sub-chains that run
+// on their own threads. Lane i starts at sha256("ChainWallet lane" || i || sha256(password)) and
+// the key is sha256 of all K end states in lane order.
+//
+// This trades the strictly sequential chain for K times less wall time, so K is part of the wallet
+// and recovering it needs the same K.
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Start state of a lane
+void laneStart(const uint8_t passwordHash[32], uint32_t lane, uint8_t out[32]);
+
+// Hashes of a lane, start state included. The first total % k lanes take one more.
+uint64_t laneLength(uint64_t total, uint32_t k, uint32_t lane);
+
+class ChainLanes
+{
+public:
+	// Starts the k threads
+	ChainLanes(const uint8_t passwordHash[32], uint64_t total, uint32_t k);
+	~ChainLanes();
+
+	// Hashes done so far, updated by the lanes every 64K hashes
+	uint64_t done() const;
+	bool finished() const { return running == 0; }
+
+	// Wait for all lanes and get the key
+	void key(uint8_t out[32]);
+
+private:
+	void run(uint32_t lane, uint64_t length);
+
+	std::vector<uint8_t> ends;	// 32 bytes per lane
+	std::vector<std::atomic<uint64_t>> progress;
+	std::atomic<uint32_t> running;
+	std::vector<std::thread> threads;
+};
+
+#endif
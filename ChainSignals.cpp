@@ -0,0 +1,49 @@
+// Signal handlers of the chain loop
+#include "ChainSignals.h"
+#include <signal.h>
+#include <unistd.h>
+using namespace std;
+
+atomic<int> chainSignals(0);
+atomic<bool> chainVerbose(false);
+
+static const int handled[] = {SIGINT, SIGTERM, SIGUSR1, SIGUSR2};
+static struct sigaction previous[4];
+
+static void onSignal(int sig)
+{
+	switch (sig)
+	{
+	case SIGINT:
+	case SIGTERM:
+		// Asked twice: the checkpoint is not wanted any more
+		if (chainSignals.fetch_or(CHAIN_STOP) & CHAIN_STOP)
+			_exit(128 + sig);
+		break;
+	case SIGUSR1:
+		chainSignals.fetch_or(CHAIN_STATUS);
+		break;
+	case SIGUSR2:
+		chainVerbose.store(!chainVerbose.load());
+		chainSignals.fetch_or(CHAIN_VERBOSE);
+		break;
+	}
+}
+
+void installChainSignals()
+{
+	static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_BOOL_LOCK_FREE == 2, "signal handlers need lock free atomics");
+	chainSignals.store(0);
+	struct sigaction sa;
+	sa.sa_handler = onSignal;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_flags = SA_RESTART;
+	for (int i=0; i<4; i++)
+		sigaction(handled[i], &sa, &previous[i]);
+}
+
+void restoreChainSignals()
+{
+	for (int i=0; i<4; i++)
+		sigaction(handled[i], &previous[i], NULL);
+}
@@ -0,0 +1,28 @@
+#ifndef CHAINSIGNALS_H
+
+#define CHAINSIGNALS_H
+
+// Control of a running chain by signals.
+//
+// The handlers only set bits in an atomic word, which is async-signal-safe. The hash loop looks at the
+// word once per block of hashes, where it already stores its progress, so the hashes themselves cost
+// nothing more.
+//
+//	SIGINT, SIGTERM		finish the block, save a checkpoint and exit (a second one exits at once)
+//	SIGUSR1				print the iteration, rate and remaining time now
+//	SIGUSR2				turn a progress line every second on or off
+
+#include <atomic>
+
+#define CHAIN_STOP		1
+#define CHAIN_STATUS	2
+#define CHAIN_VERBOSE	4	// Verbose mode changed
+
+extern std::atomic<int> chainSignals;	// Pending CHAIN_* bits
+extern std::atomic<bool> chainVerbose;
+
+// Install the handlers while a chain runs, and put back the previous ones
+void installChainSignals();
+void restoreChainSignals();
+
+#endif
@@ -0,0 +1,277 @@
+// C API of libchainwallet, see chainwallet.h
+#include "chainwallet.h"
+#include "ChainEngine.h"
+#include "Address.h"
+#include "BIP39.hpp"
+#include "HMAC.h"
+#include "Hex.h"
+#include "Kryptonite.h"
+#include "SHA256.h"
+#include "Secp256k1.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <string.h>
+
+using namespace std;
+
+#define CW_BLOCK 4096	// Hashes between progress stores and cancel checks
+
+struct cw_engine
+{
+	mutex stepping;			// Held by start, resume, step and state
+	uint8_t hash[32];
+	atomic<uint64_t> total;	// Atomic because poll reads it without the lock
+	atomic<uint64_t> done;
+	atomic<int> state;
+	atomic<bool> cancel;
+};
+
+struct cw_krypt
+{
+	KryptKey key;
+};
+
+// Order of the secp256k1 group, big endian
+static const uint8_t curveOrder[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+	0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+};
+
+// Copy a string into a caller's buffer
+static int copyOut(const string &str, char *out, size_t size)
+{
+	if (str.size() >= size)
+		return CW_ESPACE;
+	memcpy(out, str.c_str(), str.size() + 1);
+	return CW_OK;
+}
+
+const char *cw_version(void)
+{
+	return "1.0";
+}
+
+const char *cw_sha256_autotune(const char *cacheFile)
+{
+	return sha256_kernel_name(sha256_autotune(cacheFile));
+}
+
+cw_engine *cw_engine_new(void)
+{
+	cw_engine *engine = new (nothrow) cw_engine;
+	if (engine == NULL)
+		return NULL;
+	memset(engine->hash, 0, 32);
+	engine->total.store(0);
+	engine->done = 0;
+	engine->state = CW_IDLE;
+	engine->cancel = false;
+	return engine;
+}
+
+void cw_engine_free(cw_engine *engine)
+{
+	delete engine;
+}
+
+int cw_engine_start(cw_engine *engine, const void *password, size_t len, unsigned b, unsigned n)
+{
+	if (engine == NULL || (password == NULL && len > 0) || len > UINT32_MAX || b == 0)
+		return CW_EINVAL;
+
+	// B^N must fit in 64 bits
+	uint64_t total = 1;
+	for (unsigned i=0; i<n; i++)
+	{
+		if (total > UINT64_MAX / b)
+			return CW_ERANGE;
+		total *= b;
+	}
+	uint8_t hash[32];
+	computeSHA256(password, len, hash);
+	return cw_engine_resume(engine, hash, 1, total);
+}
+
+int cw_engine_resume(cw_engine *engine, const uint8_t state[32], uint64_t done, uint64_t total)
+{
+	if (engine == NULL || state == NULL || done == 0 || done > total)
+		return CW_EINVAL;
+	unique_lock<mutex> lock(engine->stepping, try_to_lock);
+	if (!lock.owns_lock())
+		return CW_EBUSY;
+	memcpy(engine->hash, state, 32);
+	engine->total.store(total);
+	engine->cancel.store(false);
+	engine->done.store(done);
+	engine->state.store(done == total ? CW_FINISHED : CW_RUNNING);
+	return CW_OK;
+}
+
+int cw_engine_step(cw_engine *engine, uint64_t maxHashes)
+{
+	return cwEngineStep(engine, maxHashes, NULL);
+}
+
+int cwEngineStep(cw_engine *engine, uint64_t maxHashes, const function<void(const uint8_t *)> *observer)
+{
+	if (engine == NULL)
+		return CW_EINVAL;
+	unique_lock<mutex> lock(engine->stepping, try_to_lock);
+	if (!lock.owns_lock())
+		return CW_EBUSY;
+	int state = engine->state.load();
+	if (state != CW_RUNNING)
+		return state == CW_IDLE ? CW_ESTATE : state;
+
+	// Blocks of hashes with a relaxed store and a cancel check in between
+	uint64_t done = engine->done.load(memory_order_relaxed);
+	uint64_t left = engine->total.load(memory_order_relaxed) - done;
+	if (maxHashes > 0 && maxHashes < left)
+		left = maxHashes;
+	uint8_t src[32];
+	while (left > 0)
+	{
+		if (engine->cancel.load(memory_order_relaxed))
+		{
+			engine->state.store(CW_CANCELLED);
+			return CW_CANCELLED;
+		}
+		uint64_t block = left < CW_BLOCK ? left : CW_BLOCK;
+		if (observer)
+			for (uint64_t i=0; i<block; i++)
+			{
+				memcpy(src, engine->hash, 32);
+				computeSHA256(src, 32, engine->hash);
+				(*observer)(engine->hash);
+			}
+		else
+			for (uint64_t i=0; i<block; i++)
+			{
+				memcpy(src, engine->hash, 32);
+				computeSHA256(src, 32, engine->hash);
+			}
+		done += block;
+		left -= block;
+		engine->done.store(done, memory_order_relaxed);
+	}
+	if (done == engine->total.load(memory_order_relaxed))
+		engine->state.store(CW_FINISHED);
+	return engine->state.load();
+}
+
+int cw_engine_poll(const cw_engine *engine, cw_progress *progress)
+{
+	if (engine == NULL)
+		return CW_EINVAL;
+	int state = engine->state.load();
+	if (progress)
+	{
+		progress->state = state;
+		progress->done = engine->done.load(memory_order_relaxed);
+		progress->total = engine->total.load();
+	}
+	return state;
+}
+
+void cw_engine_cancel(cw_engine *engine)
+{
+	if (engine)
+		engine->cancel.store(true);
+}
+
+int cw_engine_state(cw_engine *engine, uint8_t state[32], uint64_t *done)
+{
+	if (engine == NULL || state == NULL)
+		return CW_EINVAL;
+	unique_lock<mutex> lock(engine->stepping, try_to_lock);
+	if (!lock.owns_lock())
+		return CW_EBUSY;
+	if (engine->state.load() == CW_IDLE)
+		return CW_ESTATE;
+	memcpy(state, engine->hash, 32);
+	if (done)
+		*done = engine->done.load();
+	return CW_OK;
+}
+
+int cw_derive_keys(const uint8_t state[32], cw_keys *keys)
+{
+	if (state == NULL || keys == NULL)
+		return CW_EINVAL;
+
+	// The chain end is below 2N, so one subtraction reduces it
+	uint8_t sk[32];
+	memcpy(sk, state, 32);
+	if (memcmp(sk, curveOrder, 32) >= 0)
+	{
+		int borrow = 0;
+		for (int i=31; i>=0; i--)
+		{
+			int d = sk[i] - curveOrder[i] - borrow;
+			borrow = d < 0;
+			sk[i] = (uint8_t)d;
+		}
+	}
+	if (!ecSeckeyValid(sk))
+		return CW_EINVAL;
+
+	uint8_t pub[33];
+	ecPubkey(sk, pub);
+	hexEncode(sk, 32, keys->privateKey);
+	keys->privateKey[64] = 0;
+	hexEncode(pub, 33, keys->publicKey);
+	keys->publicKey[66] = 0;
+	copyOut(wifCompressed(sk), keys->wif, sizeof(keys->wif));
+	copyOut(addrP2PKH(pub), keys->p2pkh, sizeof(keys->p2pkh));
+	copyOut(addrP2SHP2WPKH(pub), keys->p2shP2wpkh, sizeof(keys->p2shP2wpkh));
+	copyOut(addrP2WPKH(pub), keys->p2wpkh, sizeof(keys->p2wpkh));
+	size_t len = toBIP39(sk, keys->mnemonic);
+	keys->mnemonic[len] = 0;
+	mnemonicToSeed(string(keys->mnemonic, len), "", keys->seed);
+	return CW_OK;
+}
+
+int cw_address(const uint8_t pub[33], int type, char *out, size_t size)
+{
+	if (pub == NULL || out == NULL || (pub[0] != 2 && pub[0] != 3))
+		return CW_EINVAL;
+	switch (type)
+	{
+	case CW_ADDR_P2PKH:
+		return copyOut(addrP2PKH(pub), out, size);
+	case CW_ADDR_P2SH_P2WPKH:
+		return copyOut(addrP2SHP2WPKH(pub), out, size);
+	case CW_ADDR_P2WPKH:
+		return copyOut(addrP2WPKH(pub), out, size);
+	}
+	return CW_EINVAL;
+}
+
+cw_krypt *cw_krypt_new(const void *password, size_t len)
+{
+	if (password == NULL && len > 0)
+		return NULL;
+	cw_krypt *key = new (nothrow) cw_krypt;
+	if (key)
+		kryptKey(key->key, len > 0 ? string((const char *)password, len) : string());
+	return key;
+}
+
+void cw_krypt_free(cw_krypt *key)
+{
+	delete key;
+}
+
+void cw_krypt_apply(const cw_krypt *key, uint64_t offset, const void *source, void *destination, size_t len)
+{
+	kryptApply(key->key, offset, (const uint8_t *)source, (uint8_t *)destination, len);
+}
+
+int cw_krypt_file(const cw_krypt *key, const char *input, const char *output)
+{
+	if (key == NULL || input == NULL || output == NULL)
+		return CW_EINVAL;
+	int r = kryptFile(key->key, input, output);
+	return r == 0 ? CW_OK : r == -2 ? CW_EEXIST : CW_EIO;
+}
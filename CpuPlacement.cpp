@@ -0,0 +1,226 @@
+// CPU affinity, scheduling policy and memory locking of the hash thread
+#include "CpuPlacement.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+using namespace std;
+
+static bool placed = false;
+static bool lockMemory = false;
+static bool resetNice = false;	// The helpers inherited a raised priority
+static pid_t hashThread = 0;
+static cpu_set_t helperSet;		// CPUs left for the other threads
+
+static pid_t threadId()
+{
+	return (pid_t)syscall(SYS_gettid);
+}
+
+// "0-3,8,10-11" as in /sys/devices/system/cpu
+static vector<int> parseCpuList(const string &list)
+{
+	vector<int> cpus;
+	stringstream in(list);
+	string part;
+	while (getline(in, part, ','))
+	{
+		int a, b;
+		int n = sscanf(part.c_str(), "%d-%d", &a, &b);
+		if (n == 1)
+			b = a;
+		if (n < 1 || b < a)
+			continue;
+		for (int c=a; c<=b; c++)
+			cpus.push_back(c);
+	}
+	return cpus;
+}
+
+vector<int> cpuSiblings(int cpu)
+{
+	ifstream in("/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/thread_siblings_list");
+	string list;
+	vector<int> cpus;
+	if (getline(in, list))
+		cpus = parseCpuList(list);
+	if (find(cpus.begin(), cpus.end(), cpu) == cpus.end())
+		cpus.push_back(cpu);
+	return cpus;
+}
+
+// Busy jiffies of every CPU
+static vector<long long> cpuBusy()
+{
+	vector<long long> busy;
+	ifstream in("/proc/stat");
+	string line;
+	while (getline(in, line))
+	{
+		int cpu;
+		long long v[8] = {0};
+		if (sscanf(line.c_str(), "cpu%d %lld %lld %lld %lld %lld %lld %lld %lld", &cpu, &v[0], &v[1], &v[2], &v[3], &v[4],
+		           &v[5], &v[6], &v[7]) < 5)
+			continue;
+		if ((int)busy.size() <= cpu)
+			busy.resize(cpu + 1, 0);
+		busy[cpu] = v[0] + v[1] + v[2] + v[5] + v[6] + v[7];	// All but idle and iowait
+	}
+	return busy;
+}
+
+// The allowed CPU with the least load over a short sample, counting its siblings if they are to stay free
+static int idlestCpu(bool withSiblings)
+{
+	cpu_set_t allowed;
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return -1;
+	vector<long long> before = cpuBusy();
+	this_thread::sleep_for(chrono::milliseconds(250));
+	vector<long long> after = cpuBusy();
+	int best = -1;
+	long long bestLoad = LLONG_MAX;
+	for (int c=0; c<(int)after.size() && c<(int)before.size(); c++)
+	{
+		if (!CPU_ISSET(c, &allowed))
+			continue;
+		vector<int> cores = withSiblings ? cpuSiblings(c) : vector<int>(1, c);
+		long long load = 0;
+		for (size_t i=0; i<cores.size(); i++)
+			if (cores[i] < (int)after.size() && cores[i] < (int)before.size())
+				load += after[cores[i]] - before[cores[i]];
+		if (load < bestLoad)
+		{
+			best = c;
+			bestLoad = load;
+		}
+	}
+	return best;
+}
+
+bool parsePlacementOption(int argc, char **argv, int &i, CpuPlacement &placement)
+{
+	string arg = argv[i];
+	if (arg == "-S")
+		placement.avoidSiblings = true;
+	else if (arg == "-m")
+		placement.lockMemory = true;
+	else if (i+1 >= argc)
+		return false;
+	else if (arg == "-P")
+	{
+		string v = argv[++i];
+		char *end;
+		placement.cpu = v == "auto" ? -2 : (int)strtol(v.c_str(), &end, 10);
+		return v == "auto" || (*end == 0 && placement.cpu >= 0 && placement.cpu < CPU_SETSIZE);
+	}
+	else if (arg == "-s")
+	{
+		string v = argv[++i];
+		string name = v.substr(0, v.find(':'));
+		if (name == "fifo")
+			placement.policy = SCHED_FIFO;
+		else if (name == "batch")
+			placement.policy = SCHED_BATCH;
+		else if (name == "other")
+			placement.policy = SCHED_OTHER;
+		else
+			return false;
+		if (v.find(':') != string::npos)
+			placement.priority = atoi(v.c_str() + v.find(':') + 1);
+		return placement.policy != SCHED_FIFO ||
+		       (placement.priority >= sched_get_priority_min(SCHED_FIFO) && placement.priority <= sched_get_priority_max(SCHED_FIFO));
+	}
+	else if (arg == "-n")
+	{
+		placement.setNice = true;
+		placement.nice = atoi(argv[++i]);
+		return placement.nice >= -20 && placement.nice <= 19;
+	}
+	else
+		return false;
+	return true;
+}
+
+string applyPlacement(CpuPlacement &placement)
+{
+	pid_t tid = threadId();
+	if (placement.cpu == -2 && (placement.cpu = idlestCpu(placement.avoidSiblings)) < 0)
+		return "No CPU to pick from";
+
+	// Affinity of this thread only; the helpers get the rest later
+	cpu_set_t all;
+	if (sched_getaffinity(0, sizeof(all), &all) != 0)
+		return string("Unable to read the CPU affinity: ") + strerror(errno);
+	helperSet = all;
+	if (placement.cpu >= 0)
+	{
+		cpu_set_t one;
+		CPU_ZERO(&one);
+		CPU_SET(placement.cpu, &one);
+		if (sched_setaffinity(0, sizeof(one), &one) != 0)
+			return "Unable to pin to CPU " + to_string(placement.cpu) + ": " + strerror(errno);
+		vector<int> core = placement.avoidSiblings ? cpuSiblings(placement.cpu) : vector<int>(1, placement.cpu);
+		for (size_t i=0; i<core.size(); i++)
+			CPU_CLR(core[i], &helperSet);
+		if (CPU_COUNT(&helperSet) == 0)
+			helperSet = all;
+	}
+
+	if (placement.policy >= 0)
+	{
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = placement.policy == SCHED_FIFO ? placement.priority : 0;
+		if (sched_setscheduler(0, placement.policy, &param) != 0)
+			return string("Unable to set the scheduling policy: ") + strerror(errno);
+	}
+	if (placement.setNice && setpriority(PRIO_PROCESS, tid, placement.nice) != 0)
+		return "Unable to set nice " + to_string(placement.nice) + ": " + strerror(errno);
+	// Locked now so a low ulimit -l shows before the chain starts, and again by placeHelperThreads
+	if (placement.lockMemory && mlockall(MCL_CURRENT) != 0)
+		return string("Unable to lock memory (see ulimit -l): ") + strerror(errno);
+	placed = placement.cpu >= 0 || placement.policy >= 0 || placement.setNice;
+	lockMemory = placement.lockMemory;
+	resetNice = placement.setNice && placement.nice < 0;
+	hashThread = tid;
+	return "";
+}
+
+string placeHelperThreads()
+{
+	// The trace ring, the status segment and the helper stacks were mapped after applyPlacement
+	if (lockMemory && mlockall(MCL_CURRENT) != 0)
+		return string("Unable to lock memory (see ulimit -l): ") + strerror(errno);
+	if (!placed)
+		return "";
+	DIR *d = opendir("/proc/self/task");
+	if (d == NULL)
+		return "";
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL)
+	{
+		pid_t tid = atoi(e->d_name);
+		if (tid <= 0 || tid == hashThread)
+			continue;
+		sched_setaffinity(tid, sizeof(helperSet), &helperSet);
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		sched_setscheduler(tid, SCHED_OTHER, &param);
+		if (resetNice)
+			setpriority(PRIO_PROCESS, tid, 0);
+	}
+	closedir(d);
+	return "";
+}
@@ -0,0 +1,43 @@
+#ifndef CPUPLACEMENT_H
+
+#define CPUPLACEMENT_H
+
+// Where and how the hash thread of a long chain runs (Linux).
+//
+// The hash thread can be pinned to one CPU, run under SCHED_FIFO or SCHED_BATCH or a nice level, and
+// have the pages it touches locked in memory. The other threads of the process (status reporter, trace
+// writer) are then moved off that CPU and, when asked, off its SMT siblings too, so the chain has the
+// core to itself as far as this process goes. Keeping other programs off the sibling needs isolcpus or
+// a cpuset; an automatic pick prefers a core whose siblings are idle.
+
+#include <string>
+#include <vector>
+
+struct CpuPlacement
+{
+	int cpu = -1;				// -1 leaves the thread where it is, -2 picks the idlest core
+	bool avoidSiblings = false;	// Keep the SMT siblings of the CPU free of our other threads
+	int policy = -1;			// SCHED_FIFO, SCHED_BATCH, SCHED_OTHER, or -1 to leave it
+	int priority = 1;			// SCHED_FIFO priority
+	bool setNice = false;
+	int nice = 0;
+	bool lockMemory = false;	// mlockall(MCL_CURRENT) when applied and again once the chain is set up
+};
+
+// Take the placement option at argv[i] (-P cpu|auto, -S, -s fifo[:prio]|batch|other, -n nice, -m),
+// moving i past its value. Returns false if argv[i] is not one or its value is wrong.
+bool parsePlacementOption(int argc, char **argv, int &i, CpuPlacement &placement);
+
+// Apply to the calling thread, which becomes the hash thread. Returns an error message, or "" on success.
+std::string applyPlacement(CpuPlacement &placement);
+
+// Move the other threads of the process away from the hash thread's core, under SCHED_OTHER, and lock
+// the memory mapped since applyPlacement if asked to. Does nothing unless a placement was applied.
+// Call after the helper threads have started and the buffers of the chain are allocated. Returns an
+// error message, or "" on success.
+std::string placeHelperThreads();
+
+// CPUs that share a core with cpu, cpu included
+std::vector<int> cpuSiblings(int cpu);
+
+#endif
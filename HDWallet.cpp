@@ -0,0 +1,178 @@
+// BIP32 HD wallets
+#include "HDWallet.h"
+#include "HMAC.h"
+#include "Address.h"
+#include "Secp256k1.h"
+#include <string.h>
+using namespace std;
+
+static void put32(uint8_t *p, uint32_t v)
+{
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+static void fingerprint(const uint8_t pub[33], uint8_t out[4])
+{
+	uint8_t h[20];
+	hash160(pub, 33, h);
+	memcpy(out, h, 4);
+}
+
+bool hdMaster(const uint8_t *seed, size_t len, ExtKey &master)
+{
+	hmac_sha512_key_t key;
+	uint8_t I[64];
+	hmac_sha512_init(&key, "Bitcoin seed", 12);
+	hmac_sha512(&key, seed, len, I);
+	memcpy(master.key, I, 32);
+	memcpy(master.chainCode, I + 32, 32);
+	memset(I, 0, sizeof(I));
+	master.depth = 0;
+	master.child = 0;
+	memset(master.parentFingerprint, 0, 4);
+	master.hasPrivate = true;
+	return ecPubkey(master.key, master.pub);
+}
+
+bool hdChild(const ExtKey &parent, uint32_t index, ExtKey &child)
+{
+	bool hardened = (index & HD_HARDENED) != 0;
+	if (hardened && !parent.hasPrivate)
+		return false;
+
+	// Data is 0x00 || key for hardened children and the public key otherwise, followed by the index
+	uint8_t data[37];
+	if (hardened)
+	{
+		data[0] = 0;
+		memcpy(data + 1, parent.key, 32);
+	}
+	else
+	{
+		memcpy(data, parent.pub, 33);
+	}
+	put32(data + 33, index);
+
+	hmac_sha512_key_t key;
+	uint8_t I[64];
+	hmac_sha512_init(&key, parent.chainCode, 32);
+	hmac_sha512(&key, data, 37, I);
+	memset(data, 0, sizeof(data));
+
+	bool ok;
+	if (parent.hasPrivate)
+	{
+		memcpy(child.key, parent.key, 32);
+		ok = ecSeckeyTweakAdd(child.key, I) && ecPubkey(child.key, child.pub);
+	}
+	else
+	{
+		ok = ecPubkeyTweakAddBatch(parent.pub, (const uint8_t (*)[32])I, 1, (uint8_t (*)[33])child.pub);
+	}
+	memcpy(child.chainCode, I + 32, 32);
+	memset(I, 0, sizeof(I));
+	child.hasPrivate = parent.hasPrivate;
+	child.depth = parent.depth + 1;
+	child.child = index;
+	fingerprint(parent.pub, child.parentFingerprint);
+	return ok;
+}
+
+bool hdDerive(const ExtKey &key, const uint32_t *path, size_t depth, ExtKey &out)
+{
+	ExtKey cur = key;
+	for (size_t i=0; i<depth; i++)
+	{
+		ExtKey next;
+		if (!hdChild(cur, path[i], next))
+			return false;
+		cur = next;
+	}
+	out = cur;
+	memset(&cur, 0, sizeof(cur));
+	return true;
+}
+
+bool hdChildPubBatch(const ExtKey &parent, uint32_t first, size_t count, uint8_t (*pubs)[33])
+{
+	if (first + count > HD_HARDENED || first + count < first)
+		return false;
+
+	// The chain code is the HMAC key of every child: compute its pads once
+	hmac_sha512_key_t key;
+	hmac_sha512_init(&key, parent.chainCode, 32);
+	vector<uint8_t> tweaks(32 * count);
+	uint8_t data[37], I[64];
+	memcpy(data, parent.pub, 33);
+	for (size_t i=0; i<count; i++)
+	{
+		put32(data + 33, first + i);
+		hmac_sha512(&key, data, 37, I);
+		memcpy(&tweaks[32*i], I, 32);
+	}
+	return ecPubkeyTweakAddBatch(parent.pub, (const uint8_t (*)[32])tweaks.data(), count, pubs);
+}
+
+string hdSerializePub(const ExtKey &key, uint32_t version)
+{
+	uint8_t buf[78];
+	put32(buf, version);
+	buf[4] = key.depth;
+	memcpy(buf + 5, key.parentFingerprint, 4);
+	put32(buf + 9, key.child);
+	memcpy(buf + 13, key.chainCode, 32);
+	memcpy(buf + 45, key.pub, 33);
+	return base58Check(buf, 78);
+}
+
+bool hdAccount(const uint8_t seed[64], HDScheme scheme, uint32_t account, size_t count, HDAccount &out)
+{
+	uint32_t purpose, version;
+	string (*encode)(const uint8_t *);
+	switch (scheme)
+	{
+	case HD_BIP44:
+		purpose = 44;
+		version = 0x0488b21e;
+		encode = addrP2PKH;
+		break;
+	case HD_BIP49:
+		purpose = 49;
+		version = 0x049d7cb2;
+		encode = addrP2SHP2WPKH;
+		break;
+	default:
+		purpose = 84;
+		version = 0x04b24746;
+		encode = addrP2WPKH;
+		break;
+	}
+
+	// m/purpose'/0'/account' is the only private derivation; the rest uses the account public key
+	ExtKey master, acct, chain;
+	uint32_t path[3] = {purpose | HD_HARDENED, 0 | HD_HARDENED, account | HD_HARDENED};
+	bool ok = hdMaster(seed, 64, master) && hdDerive(master, path, 3, acct);
+	memset(&master, 0, sizeof(master));
+	if (!ok)
+		return false;
+	memset(acct.key, 0, 32);
+	acct.hasPrivate = false;
+
+	out.path = "m/" + to_string(purpose) + "'/0'/" + to_string(account) + "'";
+	out.xpub = hdSerializePub(acct, version);
+	out.receive.clear();
+	out.change.clear();
+	vector<uint8_t> pubs(33 * count);
+	for (uint32_t c=0; c<2; c++)
+	{
+		vector<string> &list = c == 0 ? out.receive : out.change;
+		if (!hdChild(acct, c, chain) || !hdChildPubBatch(chain, 0, count, (uint8_t (*)[33])pubs.data()))
+			return false;
+		for (size_t i=0; i<count; i++)
+			list.push_back(encode(&pubs[33*i]));
+	}
+	return true;
+}
@@ -0,0 +1,63 @@
+#ifndef HDWALLET_H
+
+#define HDWALLET_H
+
+// BIP32 hierarchical deterministic keys and the BIP44/BIP49/BIP84 account layouts.
+//
+// https://github.com/bitcoin/bips/blob/master/bip-0032.mediawiki
+// https://github.com/bitcoin/bips/blob/master/bip-0084.mediawiki
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define HD_HARDENED 0x80000000u
+
+struct ExtKey
+{
+	uint8_t depth;
+	uint8_t parentFingerprint[4];
+	uint32_t child;
+	uint8_t chainCode[32];
+	uint8_t key[32];   // Private key, valid if hasPrivate
+	uint8_t pub[33];   // Compressed public key
+	bool hasPrivate;
+};
+
+// Master key from a BIP39 seed
+bool hdMaster(const uint8_t *seed, size_t len, ExtKey &master);
+
+// Private (or, for non hardened indexes, public) child
+bool hdChild(const ExtKey &parent, uint32_t index, ExtKey &child);
+
+// Follow a path of indexes from key
+bool hdDerive(const ExtKey &key, const uint32_t *path, size_t depth, ExtKey &out);
+
+// Public keys of children first..first+count-1 of parent (non hardened).
+// All children share the parent's HMAC-SHA512 midstate and one field inversion.
+bool hdChildPubBatch(const ExtKey &parent, uint32_t first, size_t count, uint8_t (*pubs)[33]);
+
+// Base58Check serialization of the public part with the given version bytes
+std::string hdSerializePub(const ExtKey &key, uint32_t version);
+
+// Account layouts: purpose, address type and SLIP-132 version of the account public key
+enum HDScheme
+{
+	HD_BIP44,	// m/44'/0'/0'  P2PKH        xpub
+	HD_BIP49,	// m/49'/0'/0'  P2SH-P2WPKH  ypub
+	HD_BIP84	// m/84'/0'/0'  P2WPKH       zpub
+};
+
+struct HDAccount
+{
+	std::string path;
+	std::string xpub;
+	std::vector<std::string> receive;
+	std::vector<std::string> change;
+};
+
+// Account public key and the first count receive and change addresses
+bool hdAccount(const uint8_t seed[64], HDScheme scheme, uint32_t account, size_t count, HDAccount &out);
+
+#endif
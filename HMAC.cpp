@@ -0,0 +1,284 @@
+// HMAC-SHA512, PBKDF2 and BIP39 seeds
+#include "HMAC.h"
+#include "SHA512.hpp"
+#include <string.h>
+using namespace std;
+using namespace sw;
+
+// Big endian bytes to words and back
+static inline uint64_t load64(const uint8_t *p)
+{
+	uint64_t x = 0;
+	for (int i=0; i<8; i++)
+		x = (x << 8) | p[i];
+	return x;
+}
+
+static inline void store64(uint8_t *p, uint64_t x)
+{
+	for (int i=7; i>=0; i--)
+	{
+		p[i] = (uint8_t)x;
+		x >>= 8;
+	}
+}
+
+void hmac_sha512_init(hmac_sha512_key_t *key, const void *secret, size_t len)
+{
+	uint8_t block[128];
+	uint64_t words[16];
+
+	// Keys longer than a block are hashed first
+	memset(block, 0, sizeof(block));
+	if (len > sizeof(block))
+	{
+		sha512 h;
+		h.update(secret, len);
+		h.final_bytes(block);
+	}
+	else
+	{
+		memcpy(block, secret, len);
+	}
+
+	memcpy(key->inner, sha512::iv(), sizeof(key->inner));
+	memcpy(key->outer, sha512::iv(), sizeof(key->outer));
+	for (int i=0; i<16; i++)
+		words[i] = load64(block + 8*i) ^ 0x3636363636363636ULL;
+	sha512::compress(key->inner, words);
+	for (int i=0; i<16; i++)
+		words[i] = load64(block + 8*i) ^ 0x5c5c5c5c5c5c5c5cULL;
+	sha512::compress(key->outer, words);
+
+	memset(block, 0, sizeof(block));
+	memset(words, 0, sizeof(words));
+}
+
+// Hash data after a one block prefix whose chaining value is state
+static void finishFromState(const uint64_t state[8], const void *data, size_t len, uint64_t out[8])
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint64_t words[16];
+	uint8_t block[256];
+	memcpy(out, state, 8*sizeof(uint64_t));
+
+	size_t total = len + 128;
+	while (len >= 128)
+	{
+		for (int i=0; i<16; i++)
+			words[i] = load64(p + 8*i);
+		sha512::compress(out, words);
+		p += 128;
+		len -= 128;
+	}
+
+	// Padding: 0x80, zeros and the 128 bit length in bits
+	size_t n = (len < 112) ? 128 : 256;
+	memset(block, 0, n);
+	memcpy(block, p, len);
+	block[len] = 0x80;
+	store64(block + n - 8, (uint64_t)total << 3);
+	store64(block + n - 16, (uint64_t)(total >> 61));
+	for (size_t b=0; b<n; b+=128)
+	{
+		for (int i=0; i<16; i++)
+			words[i] = load64(block + b + 8*i);
+		sha512::compress(out, words);
+	}
+}
+
+void hmac_sha512(const hmac_sha512_key_t *key, const void *data, size_t len, uint8_t mac[64])
+{
+	uint64_t inner[8], outer[8];
+	uint8_t innerHash[64];
+	finishFromState(key->inner, data, len, inner);
+	for (int i=0; i<8; i++)
+		store64(innerHash + 8*i, inner[i]);
+	finishFromState(key->outer, innerHash, 64, outer);
+	for (int i=0; i<8; i++)
+		store64(mac + 8*i, outer[i]);
+}
+
+// Message words for a 64 byte message after one block of pad: U || 0x80 || zeros || length 1536 bits
+static inline void padBlock(uint64_t block[16])
+{
+	block[8] = 0x8000000000000000ULL;
+	for (int i=9; i<15; i++)
+		block[i] = 0;
+	block[15] = (128 + 64) * 8;
+}
+
+// Rounds 2..iterations of PBKDF2 on one lane; u holds U_1 and t the running xor
+static void pbkdf2Rounds(const hmac_sha512_key_t *key, uint64_t u[8], uint64_t t[8], uint32_t iterations)
+{
+	uint64_t block[16], state[8];
+	padBlock(block);
+	for (uint32_t r=1; r<iterations; r++)
+	{
+		memcpy(block, u, 64);
+		memcpy(state, key->inner, 64);
+		sha512::compress(state, block);
+		memcpy(block, state, 64);
+		memcpy(u, key->outer, 64);
+		sha512::compress(u, block);
+		for (int i=0; i<8; i++)
+			t[i] ^= u[i];
+	}
+}
+
+// U_1 = HMAC(password, salt || INT(1))
+static void pbkdf2First(const hmac_sha512_key_t *key, const void *salt, size_t saltLen, uint64_t u[8])
+{
+	uint8_t mac[64];
+	vector<uint8_t> msg((const uint8_t *)salt, (const uint8_t *)salt + saltLen);
+	msg.push_back(0);
+	msg.push_back(0);
+	msg.push_back(0);
+	msg.push_back(1);
+	hmac_sha512(key, msg.data(), msg.size(), mac);
+	for (int i=0; i<8; i++)
+		u[i] = load64(mac + 8*i);
+}
+
+void pbkdf2_hmac_sha512(const void *password, size_t passwordLen, const void *salt, size_t saltLen,
+                        uint32_t iterations, uint8_t out[64])
+{
+	hmac_sha512_key_t key;
+	uint64_t u[8], t[8];
+	hmac_sha512_init(&key, password, passwordLen);
+	pbkdf2First(&key, salt, saltLen, u);
+	memcpy(t, u, sizeof(t));
+	pbkdf2Rounds(&key, u, t, iterations);
+	for (int i=0; i<8; i++)
+		store64(out + 8*i, t[i]);
+	memset(&key, 0, sizeof(key));
+}
+
+void mnemonicToSeed(const string &mnemonic, const string &passphrase, uint8_t seed[64])
+{
+	string salt = "mnemonic" + passphrase;
+	pbkdf2_hmac_sha512(mnemonic.data(), mnemonic.size(), salt.data(), salt.size(), 2048, seed);
+}
+
+// Four SHA-512 compressions side by side, one per vector lane
+typedef uint64_t u64x4 __attribute__((vector_size(32)));
+
+static inline __attribute__((always_inline)) void compress4(u64x4 sum[8], const u64x4 block[16])
+{
+	#define RR(x, n) ((x >> n) | (x << (64 - n)))
+	#define CH(x, y, z)  ((x & y) ^ (~x & z))
+	#define MJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
+	#define F1(x) (RR(x, 28) ^ RR(x, 34) ^ RR(x, 39))
+	#define F2(x) (RR(x, 14) ^ RR(x, 18) ^ RR(x, 41))
+	#define F3(x) (RR(x,  1) ^ RR(x,  8) ^ (x >> 7))
+	#define F4(x) (RR(x, 19) ^ RR(x, 61) ^ (x >> 6))
+	const uint64_t *k = sha512::constants();
+	u64x4 t, u, v[8], w[80];
+	for (int j=0; j<16; j++)
+		w[j] = block[j];
+	for (int j=16; j<80; j++)
+		w[j] = F4(w[j-2]) + w[j-7] + F3(w[j-15]) + w[j-16];
+	for (int j=0; j<8; j++)
+		v[j] = sum[j];
+	for (int j=0; j<80; j++)
+	{
+		t = v[7] + F2(v[4]) + CH(v[4], v[5], v[6]) + k[j] + w[j];
+		u = F1(v[0]) + MJ(v[0], v[1], v[2]);
+		v[7] = v[6]; v[6] = v[5]; v[5] = v[4]; v[4] = v[3] + t;
+		v[3] = v[2]; v[2] = v[1]; v[1] = v[0]; v[0] = t + u;
+	}
+	for (int j=0; j<8; j++)
+		sum[j] += v[j];
+	#undef RR
+	#undef CH
+	#undef MJ
+	#undef F1
+	#undef F2
+	#undef F3
+	#undef F4
+}
+
+// Rounds 2..iterations for four independent lanes
+static inline __attribute__((always_inline)) void pbkdf2Rounds4Body(const hmac_sha512_key_t *key[4], uint64_t u[4][8], uint64_t t[4][8], uint32_t iterations)
+{
+	u64x4 inner[8], outer[8], vu[8], vt[8], block[16], state[8];
+	for (int i=0; i<8; i++)
+	{
+		inner[i] = (u64x4){key[0]->inner[i], key[1]->inner[i], key[2]->inner[i], key[3]->inner[i]};
+		outer[i] = (u64x4){key[0]->outer[i], key[1]->outer[i], key[2]->outer[i], key[3]->outer[i]};
+		vu[i] = (u64x4){u[0][i], u[1][i], u[2][i], u[3][i]};
+		vt[i] = (u64x4){t[0][i], t[1][i], t[2][i], t[3][i]};
+	}
+	for (int i=8; i<16; i++)
+		block[i] = (u64x4){0, 0, 0, 0};
+	block[8]  += 0x8000000000000000ULL;
+	block[15] += (128 + 64) * 8;
+	for (uint32_t r=1; r<iterations; r++)
+	{
+		for (int i=0; i<8; i++)
+		{
+			block[i] = vu[i];
+			state[i] = inner[i];
+		}
+		compress4(state, block);
+		for (int i=0; i<8; i++)
+		{
+			block[i] = state[i];
+			vu[i] = outer[i];
+		}
+		compress4(vu, block);
+		for (int i=0; i<8; i++)
+			vt[i] ^= vu[i];
+	}
+	for (int i=0; i<8; i++)
+		for (int l=0; l<4; l++)
+			t[l][i] = vt[i][l];
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+static void pbkdf2Rounds4AVX2(const hmac_sha512_key_t *key[4], uint64_t u[4][8], uint64_t t[4][8], uint32_t iterations)
+{
+	pbkdf2Rounds4Body(key, u, t, iterations);
+}
+#endif
+
+static void pbkdf2Rounds4(const hmac_sha512_key_t *key[4], uint64_t u[4][8], uint64_t t[4][8], uint32_t iterations)
+{
+	pbkdf2Rounds4Body(key, u, t, iterations);
+}
+
+void mnemonicToSeedBatch(const vector<string> &mnemonics, const string &passphrase, uint8_t (*seeds)[64])
+{
+#if defined(__x86_64__) || defined(__i386__)
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+	string salt = "mnemonic" + passphrase;
+	size_t count = mnemonics.size();
+	size_t i = 0;
+	for (; i+4<=count; i+=4)
+	{
+		hmac_sha512_key_t keys[4];
+		const hmac_sha512_key_t *keyPtr[4];
+		uint64_t u[4][8], t[4][8];
+		for (int l=0; l<4; l++)
+		{
+			hmac_sha512_init(&keys[l], mnemonics[i+l].data(), mnemonics[i+l].size());
+			pbkdf2First(&keys[l], salt.data(), salt.size(), u[l]);
+			memcpy(t[l], u[l], sizeof(t[l]));
+			keyPtr[l] = &keys[l];
+		}
+#if defined(__x86_64__) || defined(__i386__)
+		if (avx2)
+			pbkdf2Rounds4AVX2(keyPtr, u, t, 2048);
+		else
+#endif
+			pbkdf2Rounds4(keyPtr, u, t, 2048);
+		for (int l=0; l<4; l++)
+			for (int w=0; w<8; w++)
+				store64(seeds[i+l] + 8*w, t[l][w]);
+		memset(keys, 0, sizeof(keys));
+	}
+	for (; i<count; i++)
+		mnemonicToSeed(mnemonics[i], passphrase, seeds[i]);
+}
@@ -0,0 +1,35 @@
+#ifndef HMAC_H
+
+#define HMAC_H
+
+// HMAC-SHA512 with precomputed pad midstates, PBKDF2-HMAC-SHA512 and the BIP39 mnemonic to seed derivation.
+//
+// https://en.wikipedia.org/wiki/HMAC
+// https://github.com/bitcoin/bips/blob/master/bip-0039.mediawiki#from-mnemonic-to-seed
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Chaining values after absorbing (key ^ ipad) and (key ^ opad)
+typedef struct
+{
+	uint64_t inner[8];
+	uint64_t outer[8];
+} hmac_sha512_key_t;
+
+void hmac_sha512_init(hmac_sha512_key_t *key, const void *secret, size_t len);
+void hmac_sha512(const hmac_sha512_key_t *key, const void *data, size_t len, uint8_t mac[64]);
+
+// Single block (64 byte) PBKDF2-HMAC-SHA512
+void pbkdf2_hmac_sha512(const void *password, size_t passwordLen, const void *salt, size_t saltLen,
+                        uint32_t iterations, uint8_t out[64]);
+
+// BIP39 seed: PBKDF2-HMAC-SHA512(mnemonic, "mnemonic" + passphrase, 2048)
+void mnemonicToSeed(const std::string &mnemonic, const std::string &passphrase, uint8_t seed[64]);
+
+// Same for many mnemonics. Groups of four run in the lanes of one vector register.
+void mnemonicToSeedBatch(const std::vector<std::string> &mnemonics, const std::string &passphrase, uint8_t (*seeds)[64]);
+
+#endif
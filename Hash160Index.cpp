@@ -0,0 +1,275 @@
+// Memory mapped hash160 set with a blocked Bloom filter
+#include "Hash160Index.h"
+#include "Address.h"
+#include "Hex.h"
+#include "Trace.h"
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+static const char h160Magic[8] = {'C','W','H','1','6','0','I','1'};
+
+#define DIRECTORY_SIZE 65537
+#define BLOOM_BITS_PER_KEY 16
+
+struct Hash160Header
+{
+	char magic[8];
+	uint64_t count;
+	uint64_t blocks;		// 64 byte Bloom blocks
+	uint64_t directory;		// Offsets of the parts
+	uint64_t bloom;
+	uint64_t table;
+	uint64_t reserved[2];
+};
+
+static inline uint64_t load64(const uint8_t *p)
+{
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return __builtin_bswap64(v);
+}
+
+static inline uint64_t blockOf(const Hash160 &h, uint64_t blocks)
+{
+	return (uint64_t)(((unsigned __int128)load64(h.b) * blocks) >> 64);
+}
+
+// Eight 9 bit positions within the block from bytes 8-19
+static inline void bloomBits(const Hash160 &h, unsigned bits[8])
+{
+	uint64_t a = load64(h.b + 8);
+	uint32_t b;
+	memcpy(&b, h.b + 16, 4);
+	for (int k=0; k<7; k++)
+		bits[k] = (a >> (9 * k)) & 511;
+	bits[7] = b & 511;
+}
+
+static inline bool bloomTest(const uint64_t *block, const Hash160 &h)
+{
+	unsigned bits[8];
+	bloomBits(h, bits);
+	bool in = true;
+	for (int k=0; k<8; k++)
+		in &= (block[bits[k] >> 6] >> (bits[k] & 63)) & 1;
+	return in;
+}
+
+bool writeHash160Index(vector<Hash160> &hashes, const string &path, uint64_t &unique)
+{
+	TRACE_SPAN("sort hash160");
+	auto less = [](const Hash160 &a, const Hash160 &b) { return memcmp(a.b, b.b, 20) < 0; };
+	auto equal = [](const Hash160 &a, const Hash160 &b) { return memcmp(a.b, b.b, 20) == 0; };
+	sort(hashes.begin(), hashes.end(), less);
+	hashes.erase(unique_copy(hashes.begin(), hashes.end(), hashes.begin(), equal), hashes.end());
+	unique = hashes.size();
+
+	Hash160Header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, h160Magic, 8);
+	h.count = hashes.size();
+	h.blocks = max<uint64_t>(1, (hashes.size() * BLOOM_BITS_PER_KEY + 511) / 512);
+	h.directory = sizeof(h);
+	h.bloom = (h.directory + DIRECTORY_SIZE * 8 + 63) & ~(uint64_t)63;
+	h.table = h.bloom + h.blocks * 64;
+
+	vector<uint64_t> directory(DIRECTORY_SIZE);
+	size_t r = 0;
+	for (uint32_t p=0; p<DIRECTORY_SIZE; p++)
+	{
+		while (r < hashes.size() && (uint32_t)(hashes[r].b[0] << 8 | hashes[r].b[1]) < p)
+			r++;
+		directory[p] = r;
+	}
+	vector<uint64_t> bloom(h.blocks * 8, 0);
+	for (size_t i=0; i<hashes.size(); i++)
+	{
+		uint64_t *block = &bloom[8 * blockOf(hashes[i], h.blocks)];
+		unsigned bits[8];
+		bloomBits(hashes[i], bits);
+		for (int k=0; k<8; k++)
+			block[bits[k] >> 6] |= (uint64_t)1 << (bits[k] & 63);
+	}
+
+	TRACE_SPAN("write hash160 index");
+	static const char zeros[64] = {0};
+	FILE *f = fopen(path.c_str(), "wb");
+	if (f == NULL)
+		return false;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	ok = ok && fwrite(directory.data(), 8, DIRECTORY_SIZE, f) == DIRECTORY_SIZE;
+	ok = ok && fwrite(zeros, 1, h.bloom - h.directory - DIRECTORY_SIZE * 8, f) == h.bloom - h.directory - DIRECTORY_SIZE * 8;
+	ok = ok && fwrite(bloom.data(), 8, bloom.size(), f) == bloom.size();
+	if (!hashes.empty())
+		ok = ok && fwrite(hashes.data(), sizeof(Hash160), hashes.size(), f) == hashes.size();
+	ok = (fclose(f) == 0) && ok;
+	return ok;
+}
+
+// The hash160 of one field of a dump line, if it has one
+static bool parseField(const char *s, size_t len, Hash160 &out)
+{
+	uint8_t buf[40];
+	if (len == 40)
+		return hexDecode(s, 20, out.b) == 0;
+	if (len == 50 && strncasecmp(s, "76a914", 6) == 0 && strncasecmp(s + 46, "88ac", 4) == 0)	// P2PKH script
+		return hexDecode(s + 6, 20, out.b) == 0;
+	if (len == 46 && strncasecmp(s, "a914", 4) == 0 && strncasecmp(s + 44, "87", 2) == 0)		// P2SH script
+		return hexDecode(s + 4, 20, out.b) == 0;
+	if (len == 44 && strncasecmp(s, "0014", 4) == 0)											// P2WPKH script
+		return hexDecode(s + 4, 20, out.b) == 0;
+	if (len > 3 && strncasecmp(s, "bc1", 3) == 0)
+	{
+		string addr(s, len);
+		for (size_t i=0; i<len; i++)
+			addr[i] = tolower(addr[i]);
+		int version;
+		if (decodeSegwitAddr("bc", addr, version, buf, sizeof(buf)) != 20 || version != 0)
+			return false;
+		memcpy(out.b, buf, 20);
+		return true;
+	}
+	if (len >= 26 && len <= 35 && (s[0] == '1' || s[0] == '3'))
+	{
+		if (decodeBase58Check(string(s, len), buf, sizeof(buf)) != 21 || (buf[0] != 0x00 && buf[0] != 0x05))
+			return false;
+		memcpy(out.b, buf + 1, 20);
+		return true;
+	}
+	return false;
+}
+
+bool buildHash160Index(const string &dumpPath, const string &path, Hash160Stats &stats)
+{
+	stats.lines = stats.hashes = stats.unique = 0;
+	ifstream dump(dumpPath);
+	if (!dump)
+		return false;
+	vector<Hash160> hashes;
+	{
+		TRACE_SPAN("read dump");
+		string line;
+		while (getline(dump, line))
+		{
+			stats.lines++;
+			const char *s = line.c_str();
+			while (*s)
+			{
+				size_t len = strcspn(s, ",; \t\r");
+				Hash160 h;
+				if (len > 0 && parseField(s, len, h))
+				{
+					hashes.push_back(h);
+					stats.hashes++;
+					break;
+				}
+				s += len;
+				if (*s)
+					s++;
+			}
+		}
+	}
+	return writeHash160Index(hashes, path, stats.unique);
+}
+
+bool Hash160Index::open(const string &path)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Hash160Header))
+	{
+		close(fd);
+		return false;
+	}
+	size = st.st_size;
+	map = (const uint8_t *)mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		map = NULL;
+		return false;
+	}
+
+	const Hash160Header *h = (const Hash160Header *)map;
+	bool ok = memcmp(h->magic, h160Magic, 8) == 0 && h->blocks > 0 && h->directory + DIRECTORY_SIZE * 8 <= h->bloom &&
+	          h->bloom % 64 == 0 && h->bloom <= size && h->blocks <= (size - h->bloom) / 64 &&
+	          h->table == h->bloom + h->blocks * 64 && h->count == (size - h->table) / sizeof(Hash160);
+	directory = (const uint64_t *)(map + h->directory);
+	for (int p=0; ok && p<DIRECTORY_SIZE; p++)
+		ok = directory[p] <= h->count && (p == 0 || directory[p] >= directory[p-1]);
+	if (!ok)
+	{
+		munmap((void *)map, size);
+		map = NULL;
+		return false;
+	}
+	records = h->count;
+	blocks = h->blocks;
+	bloom = (const uint64_t *)(map + h->bloom);
+	table = (const Hash160 *)(map + h->table);
+
+	// The filter is read at random and is small next to the table; fault it in now
+	madvise((void *)bloom, blocks * 64, MADV_WILLNEED);
+	return true;
+}
+
+Hash160Index::~Hash160Index()
+{
+	if (map)
+		munmap((void *)map, size);
+}
+
+bool Hash160Index::search(const Hash160 &hash) const
+{
+	unsigned p = hash.b[0] << 8 | hash.b[1];
+	uint64_t lo = directory[p], hi = directory[p+1];
+	while (lo < hi)
+	{
+		uint64_t mid = (lo + hi) / 2;
+		int c = memcmp(table[mid].b, hash.b, 20);
+		if (c < 0)
+			lo = mid + 1;
+		else if (c > 0)
+			hi = mid;
+		else
+			return true;
+	}
+	return false;
+}
+
+// Prefetch the blocks of a group of probes before testing any of them, so their cache misses overlap
+size_t Hash160Index::probe(const Hash160 *hashes, size_t n, uint8_t *found) const
+{
+	const size_t group = 16;
+	const uint64_t *block[group];
+	size_t hits = 0;
+	if (map == NULL)
+	{
+		memset(found, 0, n);
+		return 0;
+	}
+	for (size_t start=0; start<n; start+=group)
+	{
+		size_t m = min(group, n - start);
+		for (size_t i=0; i<m; i++)
+		{
+			block[i] = bloom + 8 * blockOf(hashes[start+i], blocks);
+			__builtin_prefetch(block[i]);
+		}
+		for (size_t i=0; i<m; i++)
+		{
+			found[start+i] = bloomTest(block[i], hashes[start+i]) && search(hashes[start+i]);
+			hits += found[start+i];
+		}
+	}
+	return hits;
+}
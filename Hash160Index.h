@@ -0,0 +1,61 @@
+#ifndef HASH160INDEX_H
+
+#define HASH160INDEX_H
+
+// Set of hash160s from a UTXO dump, to check derived keys for funds.
+//
+// File: a header, a directory of 65537 record numbers keyed by the first two bytes of a hash, a blocked
+// Bloom filter and the sorted table of unique 20 byte hashes. The file is memory mapped. A probe reads
+// one 64 byte Bloom block, which answers most misses from a single cache line; only the hashes that pass
+// go on to the search of their directory range, which is a few hundred records even for 80 million.
+//
+// A hash160 is uniform, so its own bytes pick the block (bytes 0-7) and the eight bits in it (bytes 8-19).
+// Key hashes (P2PKH, P2WPKH) and script hashes (P2SH) share the table.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct Hash160
+{
+	uint8_t b[20];
+};
+
+struct Hash160Stats
+{
+	uint64_t lines;		// Lines of the dump
+	uint64_t hashes;	// Lines with a hash160 in them
+	uint64_t unique;	// Records written
+};
+
+// Sort and deduplicate hashes and write them as an index
+bool writeHash160Index(std::vector<Hash160> &hashes, const std::string &path, uint64_t &unique);
+
+// Index every line of a dump with a P2PKH, P2SH or P2WPKH address, scriptPubKey or 40 hex digit hash160
+// in one of its fields (separated by commas, semicolons, tabs or spaces)
+bool buildHash160Index(const std::string &dumpPath, const std::string &path, Hash160Stats &stats);
+
+class Hash160Index
+{
+public:
+	bool open(const std::string &path);
+	~Hash160Index();
+
+	uint64_t count() const { return records; }
+
+	// found[i] = 1 if hashes[i] is in the table, else 0. Returns the hits.
+	size_t probe(const Hash160 *hashes, size_t n, uint8_t *found) const;
+
+private:
+	bool search(const Hash160 &hash) const;
+
+	const uint8_t *map = NULL;
+	size_t size = 0;
+	uint64_t records = 0, blocks = 0;
+	const uint64_t *directory = NULL;
+	const uint64_t *bloom = NULL;		// blocks * 8 words
+	const Hash160 *table = NULL;
+};
+
+#endif
@@ -0,0 +1,228 @@
+// Reference, accelerated and libcrypto hash backends
+#include "HashBackend.h"
+#include "SHA256.h"
+#include "RIPEMD160.h"
+#include "SHA512.hpp"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#ifdef CHAINWALLET_LIBCRYPTO
+// The one-shot digests of OpenSSL 3 fetch the algorithm on every call, which costs more than hashing
+// 32 bytes; the low level functions, deprecated but still exported, go straight to the assembly.
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include <openssl/ripemd.h>
+#include <openssl/sha.h>
+#endif
+using namespace std;
+using namespace sw;
+
+static bool always()
+{
+	return true;
+}
+
+static void referenceSHA512(const void *input, size_t size, uint8_t out[64])
+{
+	sha512 h;
+	h.update(input, size);
+	h.final_bytes(out);
+}
+
+#ifdef CHAINWALLET_LIBCRYPTO
+static void cryptoSHA256(const void *input, uint32_t size, uint8_t out[32])
+{
+	SHA256_CTX c;
+	SHA256_Init(&c);
+	SHA256_Update(&c, input, size);
+	SHA256_Final(out, &c);
+}
+
+static void cryptoRIPEMD160(const void *input, uint32_t size, uint8_t out[20])
+{
+	RIPEMD160_CTX c;
+	RIPEMD160_Init(&c);
+	RIPEMD160_Update(&c, input, size);
+	RIPEMD160_Final(out, &c);
+}
+
+static void cryptoSHA512(const void *input, size_t size, uint8_t out[64])
+{
+	SHA512_CTX c;
+	SHA512_Init(&c);
+	SHA512_Update(&c, input, size);
+	SHA512_Final(out, &c);
+}
+#endif
+
+static const HashBackend backends[] = {
+	{"reference", always, sha256_reference_hash, ripemd160_reference_hash, referenceSHA512},
+	{"accelerated", always, sha256_kernel_hash, ripemd160_reference_hash, referenceSHA512},
+#ifdef CHAINWALLET_LIBCRYPTO
+	{"libcrypto", always, cryptoSHA256, cryptoRIPEMD160, cryptoSHA512},
+#endif
+};
+
+#define BACKENDS ((int)(sizeof(backends) / sizeof(backends[0])))
+#define REFERENCE 0
+#define DEFAULT_BACKEND 1
+
+const HashBackend *hashBackend = &backends[DEFAULT_BACKEND];
+
+void computeSHA512(const void *input, size_t size, uint8_t out[64])
+{
+	hashBackend->sha512(input, size, out);
+}
+
+int hashBackendCount()
+{
+	return BACKENDS;
+}
+
+const HashBackend &hashBackendAt(int backend)
+{
+	return backends[backend];
+}
+
+int hashBackendFind(const char *name)
+{
+	for (int i=0; i<BACKENDS; i++)
+		if (strcmp(backends[i].name, name) == 0)
+			return i;
+	return -1;
+}
+
+int hashBackendCurrent()
+{
+	return hashBackend - backends;
+}
+
+// Digests of "abc"
+static bool knownAnswers(const HashBackend &b)
+{
+	static const uint8_t sha256abc[32] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+	};
+	static const uint8_t ripemd160abc[20] = {
+		0x8e, 0xb2, 0x08, 0xf7, 0xe0, 0x5d, 0x98, 0x7a, 0x9b, 0x04, 0x4a, 0x8e, 0x98, 0xc6, 0xb0, 0x87,
+		0xf1, 0x5a, 0x0b, 0xfc
+	};
+	static const uint8_t sha512abc[64] = {
+		0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+		0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+		0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+		0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f
+	};
+	uint8_t out[64];
+	b.sha256("abc", 3, out);
+	bool ok = memcmp(out, sha256abc, 32) == 0;
+	b.ripemd160("abc", 3, out);
+	ok = ok && memcmp(out, ripemd160abc, 20) == 0;
+	b.sha512("abc", 3, out);
+	return ok && memcmp(out, sha512abc, 64) == 0;
+}
+
+// Lengths up to 300 cover the empty message, both padding cases and inputs of several blocks
+int hashBackendMismatches(int backend, int rounds, uint64_t seed)
+{
+	if (backend < 0 || backend >= BACKENDS || !backends[backend].available())
+		return -1;
+	const HashBackend &b = backends[backend], &r = backends[REFERENCE];
+	mt19937_64 rng(seed);
+	vector<uint8_t> input(300);
+	int mismatches = 0;
+	for (int i=0; i<rounds; i++)
+	{
+		size_t len = rng() % (input.size() + 1);
+		for (size_t j=0; j<len; j++)
+			input[j] = (uint8_t)rng();
+		uint8_t x[64], y[64];
+		b.sha256(input.data(), len, x);
+		r.sha256(input.data(), len, y);
+		bool same = memcmp(x, y, 32) == 0;
+		b.ripemd160(input.data(), len, x);
+		r.ripemd160(input.data(), len, y);
+		same = same && memcmp(x, y, 20) == 0;
+		b.sha512(input.data(), len, x);
+		r.sha512(input.data(), len, y);
+		same = same && memcmp(x, y, 64) == 0;
+		mismatches += !same;
+	}
+	return mismatches;
+}
+
+bool hashBackendUsable(int backend)
+{
+	if (backend < 0 || backend >= BACKENDS || !backends[backend].available())
+		return false;
+	random_device rd;
+	return knownAnswers(backends[backend]) && hashBackendMismatches(backend, 64, ((uint64_t)rd() << 32) | rd()) == 0;
+}
+
+int hashBackendSelect(int backend)
+{
+	if (!hashBackendUsable(backend))
+		return -1;
+	hashBackend = &backends[backend];
+	return 0;
+}
+
+double hashBackendStepTime(int backend)
+{
+	const int steps = 4096;
+	uint8_t hash[32] = {0};
+	double best = 1e30;
+	for (int run=0; run<3; run++)
+	{
+		auto start = chrono::steady_clock::now();
+		for (int i=0; i<steps; i++)
+			backends[backend].sha256(hash, 32, hash);
+		double t = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / steps;
+		if (t < best)
+			best = t;
+	}
+	return best;
+}
+
+bool hashBackendFromEnvironment(string &error)
+{
+	const char *name = getenv("CHAINWALLET_HASH_BACKEND");
+	if (name == NULL || *name == 0)
+		return true;
+	if (strcmp(name, "fastest") == 0)
+	{
+		int best = -1;
+		double bestTime = 1e30;
+		for (int i=0; i<BACKENDS; i++)
+		{
+			if (!hashBackendUsable(i))
+				continue;
+			double t = hashBackendStepTime(i);
+			if (t < bestTime)
+			{
+				best = i;
+				bestTime = t;
+			}
+		}
+		if (best < 0 || hashBackendSelect(best) != 0)
+		{
+			error = "No hash backend passed its self-test";
+			return false;
+		}
+		return true;
+	}
+	int backend = hashBackendFind(name);
+	if (backend < 0)
+	{
+		error = string("Unknown hash backend ") + name;
+		return false;
+	}
+	if (hashBackendSelect(backend) != 0)
+	{
+		error = string("Hash backend ") + name + " is not available or failed its self-test";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef HASHBACKEND_H
+
+#define HASHBACKEND_H
+
+// Implementations behind computeSHA256, computeRIPEMD160 and computeSHA512.
+//
+//   reference    the portable snippets: SHA256 with the unroll-64 kernel, RIPEMD160.cpp and SHA512.hpp
+//   accelerated  SHA256 with the kernel picked by sha256_autotune (SHA extensions, BMI2...), the rest as
+//                in reference, since those have no faster in-tree version yet (default)
+//   libcrypto    OpenSSL, when it was found at build time (make NO_LIBCRYPTO=1 leaves it out)
+//
+// A backend is only selected after it gives the known digests and the same digests as the reference
+// on random inputs, so a broken library or kernel cannot slip into a chain. The streaming SHA256 API,
+// the HMAC midstates and the vector PBKDF2 stay on the in-tree code.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+struct HashBackend
+{
+	const char *name;
+	bool (*available)();
+	void (*sha256)(const void *input, uint32_t size, uint8_t out[32]);
+	void (*ripemd160)(const void *input, uint32_t size, uint8_t out[20]);
+	void (*sha512)(const void *input, size_t size, uint8_t out[64]);
+};
+
+// Selected backend. Not thread safe to change while other threads hash.
+extern const HashBackend *hashBackend;
+
+void computeSHA512(const void *input, size_t size, uint8_t out[64]);
+
+int hashBackendCount();
+const HashBackend &hashBackendAt(int backend);
+int hashBackendFind(const char *name);		// -1 if unknown
+int hashBackendCurrent();
+
+// Digests of every input of rounds random inputs (0 to 300 bytes, from seed) that differ from the reference
+int hashBackendMismatches(int backend, int rounds, uint64_t seed);
+
+// Available, known answers right and no mismatch on a short differential test
+bool hashBackendUsable(int backend);
+int hashBackendSelect(int backend);		// 0, or -1 if not usable
+
+// Nanoseconds of the chain step (sha256 of 32 bytes), best of three runs
+double hashBackendStepTime(int backend);
+
+// Select the backend named by CHAINWALLET_HASH_BACKEND, or the one with the fastest chain step if it is
+// "fastest". Leaves the selection alone if the variable is not set. Returns false with the reason in
+// error if the backend asked for is unknown or not usable, or if "fastest" finds none usable.
+bool hashBackendFromEnvironment(std::string &error);
+
+#endif
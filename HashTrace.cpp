@@ -0,0 +1,140 @@
+// Binary traces of chain hashes
+#include "HashTrace.h"
+#include "SHA256.h"
+#include <chrono>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+using namespace std;
+
+HashTraceWriter::HashTraceWriter(const string &path, uint64_t every, uint64_t index, uint64_t last, const uint8_t hash[32])
+	: file(NULL), every(every > 0 ? every : 1), countdown(every > 0 ? every : 1), index(index), last(last), head(0), tail(0),
+	  stopping(false), failed(false)
+{
+	ring = new uint8_t[HASH_TRACE_SLOTS][32];
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0600);
+	if (fd < 0)
+		return;
+	if ((file = fdopen(fd, "wb")) == NULL)
+	{
+		close(fd);
+		return;
+	}
+	HashTraceHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "CWHASH1", 8);
+	header.first = index;
+	header.every = this->every;
+	if (fwrite(&header, sizeof(header), 1, file) != 1)
+		failed = true;
+	if (index < last)
+		push(hash);
+	writer = thread(&HashTraceWriter::drain, this);
+}
+
+HashTraceWriter::~HashTraceWriter()
+{
+	if (file)
+	{
+		stopping.store(true);
+		writer.join();
+		if (fclose(file) != 0)
+			failed = true;
+	}
+	delete [] ring;
+}
+
+// Wait for a free slot when the disk is slower than the chain
+void HashTraceWriter::push(const uint8_t hash[32])
+{
+	if (file == NULL)
+		return;
+	uint64_t h = head.load(memory_order_relaxed);
+	while (h - tail.load(memory_order_acquire) >= HASH_TRACE_SLOTS)
+		this_thread::yield();
+	memcpy(ring[h % HASH_TRACE_SLOTS], hash, 32);
+	head.store(h + 1, memory_order_release);
+}
+
+// Writer thread: contiguous runs of the ring in one fwrite each
+void HashTraceWriter::drain()
+{
+	while (true)
+	{
+		uint64_t t = tail.load(memory_order_relaxed);
+		uint64_t h = head.load(memory_order_acquire);
+		if (h == t)
+		{
+			if (stopping.load())
+			{
+				if (head.load(memory_order_acquire) == t)
+					break;
+				continue;
+			}
+			this_thread::sleep_for(chrono::microseconds(200));
+			continue;
+		}
+		uint64_t start = t % HASH_TRACE_SLOTS;
+		uint64_t n = min(h - t, (uint64_t)HASH_TRACE_SLOTS - start);
+		if (fwrite(ring[start], 32, n, file) != n)
+			failed = true;
+		tail.store(t + n, memory_order_release);
+	}
+	if (fflush(file) != 0)
+		failed = true;
+}
+
+void HashTraceWriter::flush()
+{
+	if (file == NULL)
+		return;
+	while (tail.load(memory_order_acquire) != head.load(memory_order_relaxed))
+		this_thread::sleep_for(chrono::microseconds(200));
+	if (fflush(file) != 0)
+		failed = true;
+}
+
+bool HashTraceReader::open(const string &path)
+{
+	if (file)
+		fclose(file);
+	file = fopen(path.c_str(), "rb");
+	struct stat st;
+	if (file == NULL || fstat(fileno(file), &st) != 0 || fread(&header, sizeof(header), 1, file) != 1 ||
+	    memcmp(header.magic, "CWHASH1", 8) != 0 || header.every == 0 || st.st_size < (off_t)(sizeof(header) + 32))
+		return false;
+	records = (st.st_size - sizeof(header)) / 32;
+	cached = UINT64_MAX;
+	return true;
+}
+
+HashTraceReader::~HashTraceReader()
+{
+	if (file)
+		fclose(file);
+}
+
+bool HashTraceReader::hash(uint64_t index, uint8_t out[32])
+{
+	if (file == NULL || index < header.first || index > last())
+		return false;
+	uint64_t r = (index - header.first) / header.every;
+	uint64_t at = header.first + r * header.every;
+
+	// Going forward from the last hash asked is cheaper than from the record when it is closer
+	if (cached == UINT64_MAX || cached > index || cached < at)
+	{
+		if (fseeko(file, sizeof(header) + r * 32, SEEK_SET) != 0 || fread(cache, 32, 1, file) != 1)
+			return false;
+		cached = at;
+	}
+	uint8_t src[32];
+	for (; cached<index; cached++)
+	{
+		memcpy(src, cache, 32);
+		computeSHA256(src, 32, cache);
+	}
+	memcpy(out, cache, 32);
+	return true;
+}
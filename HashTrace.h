@@ -0,0 +1,96 @@
+#ifndef HASHTRACE_H
+
+#define HASHTRACE_H
+
+// Binary traces of the intermediate hashes of a chain, for audits.
+//
+// The hash loop copies every K-th hash into a lock-free single producer, single consumer ring and a
+// background thread writes the ring to disk in large blocks, so the loop never waits on I/O unless the
+// disk falls behind the hash rate.
+//
+// File: a 32 byte header ("CWHASH1", first index, K) and then the raw 32 byte hashes of the chain
+// indexes first, first+K, first+2K... Hashes do not compress, but a chain does: any hash between two
+// records is recomputed from the record before it, so a trace of every K-th hash still gives every
+// hash of a range at the cost of at most K-1 extra hashes.
+//
+// Like a transcript, a trace stops before the last hash, which is the private key. The file is created
+// new, readable by its owner only, as every record is a few hashes away from the key.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#define HASH_TRACE_SLOTS (1 << 16)		// Ring of 2 MB
+
+struct HashTraceHeader
+{
+	char magic[8];			// "CWHASH1"
+	uint64_t first;			// Chain index of the first record
+	uint64_t every;			// K
+	uint64_t reserved;
+};
+
+class HashTraceWriter
+{
+public:
+	// index is the chain position of hash, which is the first record; nothing at or after last is
+	// recorded. Fails if path exists.
+	HashTraceWriter(const std::string &path, uint64_t every, uint64_t index, uint64_t last, const uint8_t hash[32]);
+	~HashTraceWriter();
+
+	// The file could be created and every write so far succeeded
+	bool ok() const { return file != NULL && !failed.load(); }
+
+	// Call after each hash
+	inline void step(const uint8_t hash[32])
+	{
+		index++;
+		if (--countdown == 0)
+		{
+			countdown = every;
+			if (index < last)
+				push(hash);
+		}
+	}
+
+	// Wait until every record is on disk
+	void flush();
+
+private:
+	void push(const uint8_t hash[32]);
+	void drain();
+
+	FILE *file;
+	uint64_t every, countdown, index, last;
+	uint8_t (*ring)[32];
+	std::atomic<uint64_t> head;		// Records pushed
+	std::atomic<uint64_t> tail;		// Records written
+	std::atomic<bool> stopping, failed;
+	std::thread writer;
+};
+
+class HashTraceReader
+{
+public:
+	bool open(const std::string &path);
+	~HashTraceReader();
+
+	uint64_t first() const { return header.first; }
+	uint64_t every() const { return header.every; }
+	uint64_t count() const { return records; }
+	uint64_t last() const { return header.first + (records - 1) * header.every; }
+
+	// Hash of any chain index from first to last, recomputed from the record before it if needed
+	bool hash(uint64_t index, uint8_t out[32]);
+
+private:
+	FILE *file = NULL;
+	HashTraceHeader header;
+	uint64_t records = 0;
+	uint64_t cached = UINT64_MAX;	// Index of the hash in cache
+	uint8_t cache[32];
+};
+
+#endif
@@ -0,0 +1,226 @@
+// Hexadecimal codec
+#include "Hex.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HEX_X86
+#include <immintrin.h>
+#endif
+
+static const char digits[] = "0123456789abcdef";
+
+// Two output characters for every byte value
+static const char pairs[] =
+	"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Nibble value of each character, 0xff if invalid
+static const uint8_t values[256] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static void encodeScalar(const uint8_t *source, size_t len, char *dest)
+{
+	for (size_t i=0; i<len; i++)
+		memcpy(dest + 2*i, &pairs[2*source[i]], 2);
+}
+
+static int decodeScalar(const char *source, size_t len, uint8_t *dest)
+{
+	uint8_t bad = 0;
+	for (size_t i=0; i<len; i++)
+	{
+		uint8_t hi = values[(uint8_t)source[2*i]];
+		uint8_t lo = values[(uint8_t)source[2*i+1]];
+		bad |= (hi | lo) & 0xf0;
+		dest[i] = (hi << 4) | lo;
+	}
+	return bad ? -1 : 0;
+}
+
+#ifdef HEX_X86
+
+// Convert 16 bytes to 32 characters with a nibble shuffle
+__attribute__((target("ssse3")))
+static void encodeSSSE3(const uint8_t *source, size_t len, char *dest)
+{
+	const __m128i lut  = _mm_loadu_si128((const __m128i *)digits);
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	size_t i = 0;
+	for (; i+16<=len; i+=16)
+	{
+		__m128i in = _mm_loadu_si128((const __m128i *)(source + i));
+		__m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+		__m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+		_mm_storeu_si128((__m128i *)(dest + 2*i),      _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *)(dest + 2*i + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	encodeScalar(source + i, len - i, dest + 2*i);
+}
+
+// Nibble values of 16 characters; invalid lanes are flagged in bad
+__attribute__((target("ssse3")))
+static inline __m128i nibblesSSSE3(__m128i c, __m128i &bad)
+{
+	__m128i digit  = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+	__m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i isDigit  = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	__m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+	bad = _mm_or_si128(bad, _mm_andnot_si128(_mm_or_si128(isDigit, isLetter), _mm_set1_epi8(-1)));
+	return _mm_or_si128(_mm_and_si128(isDigit, digit),
+	                    _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+static int decodeSSSE3(const char *source, size_t len, uint8_t *dest)
+{
+	const __m128i weights = _mm_set1_epi16(0x0110); // hi*16 + lo
+	__m128i bad = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i+16<=len; i+=16)
+	{
+		__m128i a = nibblesSSSE3(_mm_loadu_si128((const __m128i *)(source + 2*i)), bad);
+		__m128i b = nibblesSSSE3(_mm_loadu_si128((const __m128i *)(source + 2*i + 16)), bad);
+		a = _mm_maddubs_epi16(a, weights);
+		b = _mm_maddubs_epi16(b, weights);
+		_mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(a, b));
+	}
+	if (_mm_movemask_epi8(bad))
+		return -1;
+	return decodeScalar(source + 2*i, len - i, dest + i);
+}
+
+// Same as SSSE3 on 32 bytes; the in-lane unpack is fixed by a 128-bit lane permute
+__attribute__((target("avx2")))
+static void encodeAVX2(const uint8_t *source, size_t len, char *dest)
+{
+	const __m256i lut  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)digits));
+	const __m256i mask = _mm256_set1_epi8(0x0f);
+	size_t i = 0;
+	for (; i+32<=len; i+=32)
+	{
+		__m256i in = _mm256_loadu_si256((const __m256i *)(source + i));
+		__m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+		__m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+		__m256i l  = _mm256_unpacklo_epi8(hi, lo);
+		__m256i h  = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i *)(dest + 2*i),      _mm256_permute2x128_si256(l, h, 0x20));
+		_mm256_storeu_si256((__m256i *)(dest + 2*i + 32), _mm256_permute2x128_si256(l, h, 0x31));
+	}
+	encodeSSSE3(source + i, len - i, dest + 2*i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i nibblesAVX2(__m256i c, __m256i &bad)
+{
+	__m256i digit  = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+	__m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	__m256i isDigit  = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+	__m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+	bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(isDigit, isLetter), _mm256_set1_epi8(-1)));
+	return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+	                       _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2")))
+static int decodeAVX2(const char *source, size_t len, uint8_t *dest)
+{
+	const __m256i weights = _mm256_set1_epi16(0x0110);
+	__m256i bad = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i+32<=len; i+=32)
+	{
+		__m256i a = nibblesAVX2(_mm256_loadu_si256((const __m256i *)(source + 2*i)), bad);
+		__m256i b = nibblesAVX2(_mm256_loadu_si256((const __m256i *)(source + 2*i + 32)), bad);
+		a = _mm256_maddubs_epi16(a, weights);
+		b = _mm256_maddubs_epi16(b, weights);
+		// packus works per 128-bit lane, restore the byte order afterwards
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+		_mm256_storeu_si256((__m256i *)(dest + i), packed);
+	}
+	if (_mm256_movemask_epi8(bad))
+		return -1;
+	return decodeSSSE3(source + 2*i, len - i, dest + i);
+}
+
+#endif
+
+typedef void (*encodeFn)(const uint8_t *, size_t, char *);
+typedef int (*decodeFn)(const char *, size_t, uint8_t *);
+
+// Pick the best implementation once
+struct HexDispatch
+{
+	encodeFn encode;
+	decodeFn decode;
+	const char *name;
+	HexDispatch()
+	{
+		encode = encodeScalar;
+		decode = decodeScalar;
+		name = "scalar";
+#ifdef HEX_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+		{
+			encode = encodeAVX2;
+			decode = decodeAVX2;
+			name = "avx2";
+		}
+		else if (__builtin_cpu_supports("ssse3"))
+		{
+			encode = encodeSSSE3;
+			decode = decodeSSSE3;
+			name = "ssse3";
+		}
+#endif
+	}
+};
+
+static const HexDispatch &dispatch()
+{
+	static const HexDispatch d;
+	return d;
+}
+
+void hexEncode(const uint8_t *source, size_t len, char *dest)
+{
+	// Hashes are short; skip the dispatch for them
+	if (len < 16)
+		encodeScalar(source, len, dest);
+	else
+		dispatch().encode(source, len, dest);
+}
+
+int hexDecode(const char *source, size_t len, uint8_t *dest)
+{
+	if (len < 16)
+		return decodeScalar(source, len, dest);
+	return dispatch().decode(source, len, dest);
+}
+
+const char *hexKernel()
+{
+	return dispatch().name;
+}
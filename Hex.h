@@ -0,0 +1,22 @@
+#ifndef HEX_H
+
+#define HEX_H
+
+// Hexadecimal encoding and decoding into caller provided buffers.
+//
+// The scalar path is table driven. On x86 an SSSE3 or AVX2 path is selected at run time.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Write 2*len lowercase hex digits to dest (no terminating zero)
+void hexEncode(const uint8_t *source, size_t len, char *dest);
+
+// Read 2*len hex digits (upper or lower case) into len bytes.
+// Returns 0 on success and -1 if any character is not a hex digit.
+int hexDecode(const char *source, size_t len, uint8_t *dest);
+
+// Name of the implementation chosen at run time ("avx2", "ssse3" or "scalar")
+const char *hexKernel();
+
+#endif
@@ -0,0 +1,548 @@
+// Chain job daemon
+#include "JobDaemon.h"
+#include "chainwallet.h"
+#include "Hex.h"
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <fstream>
+#include <iostream>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+using namespace std;
+using namespace std::chrono;
+
+#define JOB_SLICE (1 << 20)			// Hashes between looks at the queue
+#define JOB_CHECKPOINT_SECONDS 30
+
+struct JobEntry
+{
+	ChainJob job;
+	bool running;
+	bool cancel;
+	bool late;				// LATE already sent
+	uint64_t lastDone;		// For the rate shown in PROGRESS
+	double rate;
+};
+
+string formatJob(const ChainJob &job)
+{
+	char state[65];
+	hexEncode(job.state, 32, state);
+	state[64] = 0;
+	string password(job.password.size() * 2, ' ');
+	hexEncode((const uint8_t *)job.password.data(), job.password.size(), &password[0]);
+	char head[160];
+	snprintf(head, sizeof(head), "%" PRIu64 " %d %" PRId64 " %d %d %" PRIu64 " %" PRIu64 " %s %.3f ",
+	         job.id, job.priority, job.deadline, job.b, job.n, job.done, job.total, state, job.seconds);
+	return head + (password.empty() ? "-" : password);
+}
+
+bool parseJob(const string &line, ChainJob &job)
+{
+	char state[65];
+	int used = 0;
+	if (sscanf(line.c_str(), "%" SCNu64 " %d %" SCNd64 " %d %d %" SCNu64 " %" SCNu64 " %64s %lf %n",
+	           &job.id, &job.priority, &job.deadline, &job.b, &job.n, &job.done, &job.total, state, &job.seconds, &used) != 9 ||
+	    used == 0 || strlen(state) != 64 || hexDecode(state, 32, job.state) != 0 || job.done == 0 || job.done > job.total)
+		return false;
+	string password = line.substr(used);
+	while (!password.empty() && (password.back() == '\n' || password.back() == ' '))
+		password.pop_back();
+	if (password == "-")
+		password.clear();
+	if (password.size() % 2)
+		return false;
+	job.password.assign(password.size() / 2, 0);
+	return hexDecode(password.data(), password.size() / 2, (uint8_t *)&job.password[0]) == 0;
+}
+
+// Write a file under a temporary name first, so a crash never leaves it half done
+static bool writeAtomic(const string &path, const string &text)
+{
+	string tmp = path + ".tmp";
+	FILE *f = fopen(tmp.c_str(), "w");
+	if (f == NULL)
+		return false;
+	bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+	ok = fflush(f) == 0 && fsync(fileno(f)) == 0 && ok;
+	ok = fclose(f) == 0 && ok;
+	return ok && rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+static string jobName(uint64_t id)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "job-%06" PRIu64, id);
+	return name;
+}
+
+// Queue order: priority, then the earliest deadline, then the oldest job
+static bool before(const JobEntry *a, const JobEntry *b)
+{
+	if (a->job.priority != b->job.priority)
+		return a->job.priority > b->job.priority;
+	uint64_t da = a->job.deadline > 0 ? a->job.deadline : UINT64_MAX;
+	uint64_t db = b->job.deadline > 0 ? b->job.deadline : UINT64_MAX;
+	if (da != db)
+		return da < db;
+	return a->job.id < b->job.id;
+}
+
+static int64_t now()
+{
+	return time(NULL);
+}
+
+JobDaemon::JobDaemon(const string &dir, unsigned workers, JobFinisher finish)
+	: dir(dir), workers(workers > 0 ? workers : 1), finish(finish), nextId(1), idle(0), stopping(false)
+{
+}
+
+JobDaemon::~JobDaemon()
+{
+	for (size_t i=0; i<jobs.size(); i++)
+		delete jobs[i];
+}
+
+// Jobs saved by an earlier run go back to the queue
+void JobDaemon::load()
+{
+	string jobsDir = dir + "/jobs";
+	mkdir(jobsDir.c_str(), 0700);
+	DIR *d = opendir(jobsDir.c_str());
+	if (d == NULL)
+		return;
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL)
+	{
+		uint64_t id;
+		char suffix[8];
+		if (sscanf(e->d_name, "job-%" SCNu64 ".%7s", &id, suffix) != 2)
+			continue;
+		nextId = max(nextId, id + 1);
+		if (strcmp(suffix, "job") != 0)
+			continue;
+		ifstream in(jobsDir + "/" + e->d_name);
+		string line;
+		JobEntry *entry = new JobEntry();
+		if (getline(in, line) && parseJob(line, entry->job) && entry->job.id == id)
+		{
+			entry->lastDone = entry->job.done;
+			jobs.push_back(entry);
+		}
+		else
+		{
+			cout << "Ignoring unreadable job file " << e->d_name << endl;
+			delete entry;
+		}
+	}
+	closedir(d);
+}
+
+bool JobDaemon::save(const JobEntry *entry)
+{
+	return writeAtomic(dir + "/jobs/" + jobName(entry->job.id) + ".job", formatJob(entry->job) + "\n");
+}
+
+// Best waiting job. Call with the lock held.
+JobEntry *JobDaemon::next()
+{
+	JobEntry *best = NULL;
+	for (size_t i=0; i<jobs.size(); i++)
+		if (!jobs[i]->running && !jobs[i]->cancel && (best == NULL || before(jobs[i], best)))
+			best = jobs[i];
+	return best;
+}
+
+// A running job yields when no worker is free, it is the worst running job and a waiting one beats it
+bool JobDaemon::outranked(const JobEntry *entry)
+{
+	if (idle > 0)
+		return false;
+	for (size_t i=0; i<jobs.size(); i++)
+		if (jobs[i]->running && jobs[i] != entry && before(entry, jobs[i]))
+			return false;
+	JobEntry *waiting = next();
+	return waiting != NULL && before(waiting, entry);
+}
+
+// Send an event line to the watchers of a job. Watchers that do not keep up are dropped.
+// Call with the lock held.
+void JobDaemon::event(uint64_t id, const string &line, bool last)
+{
+	string text = line + "\n";
+	for (size_t i=0; i<watchers.size(); )
+	{
+		if (watchers[i].id != 0 && watchers[i].id != id)
+		{
+			i++;
+			continue;
+		}
+		bool ok = send(watchers[i].fd, text.data(), text.size(), MSG_NOSIGNAL | MSG_DONTWAIT) == (ssize_t)text.size();
+		if (ok && !(last && watchers[i].id == id))
+		{
+			i++;
+			continue;
+		}
+		close(watchers[i].fd);
+		watchers.erase(watchers.begin() + i);
+	}
+}
+
+void JobDaemon::work()
+{
+	cw_engine *engine = cw_engine_new();
+	unique_lock<mutex> locked(lock);
+	while (true)
+	{
+		JobEntry *entry = NULL;
+		idle++;
+		while (!stopping && (entry = next()) == NULL)
+			wake.wait(locked);
+		idle--;
+		if (stopping)
+			break;
+		entry->running = true;
+		ChainJob &job = entry->job;
+		event(job.id, "START " + to_string(job.id));
+		cw_engine_resume(engine, job.state, job.done, job.total);
+		locked.unlock();
+
+		// Slices, with the queue looked at in between
+		auto saved = steady_clock::now();
+		int r;
+		while (true)
+		{
+			auto start = steady_clock::now();
+			r = cw_engine_step(engine, JOB_SLICE);
+			auto end = steady_clock::now();
+			locked.lock();
+			cw_engine_state(engine, job.state, &job.done);
+			job.seconds += duration<double>(end - start).count();
+			bool leave = r != CW_RUNNING || stopping || entry->cancel || outranked(entry);
+			if (r == CW_RUNNING && (leave || end - saved >= seconds(JOB_CHECKPOINT_SECONDS)))
+			{
+				if (!save(entry))
+					cout << "Unable to save the checkpoint of job " << job.id << endl;
+				saved = end;
+			}
+			if (leave)
+				break;
+			locked.unlock();
+		}
+
+		// Finished, cancelled or back to the queue. A finishing job stays marked as running.
+		string name = dir + "/jobs/" + jobName(job.id);
+		if (r == CW_FINISHED)
+		{
+			locked.unlock();
+			string address;
+			{
+				lock_guard<mutex> one(finishing);
+				address = finish(job, job.state);
+			}
+			locked.lock();
+
+			// A wallet that could not be saved keeps its job file with the end of the chain, so the
+			// next start of the daemon saves it without hashing again
+			if (address.empty())
+			{
+				if (!save(entry))
+					cout << "Unable to save the checkpoint of job " << job.id << endl;
+				event(job.id, "FAILED " + to_string(job.id), true);
+			}
+			else
+			{
+				writeAtomic(name + ".done", to_string(job.id) + " " + address + "\n");
+				unlink((name + ".job").c_str());
+				event(job.id, "DONE " + to_string(job.id) + " " + address, true);
+			}
+		}
+		else if (entry->cancel)
+		{
+			entry->running = false;
+			unlink((name + ".job").c_str());
+			event(job.id, "CANCELLED " + to_string(job.id), true);
+		}
+		else
+		{
+			entry->running = false;
+			if (!stopping)
+				event(job.id, "PREEMPT " + to_string(job.id));
+			wake.notify_one();
+			continue;
+		}
+		jobs.erase(find(jobs.begin(), jobs.end(), entry));
+		delete entry;
+	}
+	cw_engine_free(engine);
+}
+
+// Progress of the running jobs, once a second
+void JobDaemon::tick()
+{
+	lock_guard<mutex> locked(lock);
+	int64_t t = now();
+	for (size_t i=0; i<jobs.size(); i++)
+	{
+		JobEntry *entry = jobs[i];
+		ChainJob &job = entry->job;
+		double eta = -1;
+		if (entry->running)
+		{
+			double rate = job.done - entry->lastDone;
+			entry->rate = entry->rate > 0 ? 0.7 * entry->rate + 0.3 * rate : rate;
+			entry->lastDone = job.done;
+			if (entry->rate > 0)
+				eta = (job.total - job.done) / entry->rate;
+			char line[128];
+			snprintf(line, sizeof(line), "PROGRESS %" PRIu64 " %" PRIu64 " %" PRIu64 " %.0f %.0f",
+			         job.id, job.done, job.total, entry->rate, eta);
+			event(job.id, line);
+		}
+		if (job.deadline > 0 && !entry->late && (t > job.deadline || (eta >= 0 && t + eta > job.deadline)))
+		{
+			entry->late = true;
+			event(job.id, "LATE " + to_string(job.id));
+		}
+	}
+}
+
+// Answer one request. WATCH connections stay open for the events.
+void JobDaemon::handle(int fd, const string &request)
+{
+	lock_guard<mutex> locked(lock);
+	string reply = "ERROR\n";
+	char hex[1024];
+	ChainJob job = ChainJob();
+	uint64_t id = 0;
+	if (sscanf(request.c_str(), "SUBMIT %d %" SCNd64 " %d %d %1023s", &job.priority, &job.deadline, &job.b, &job.n, hex) == 5 &&
+	    job.b > 1 && job.n > 0 && !stopping)
+	{
+		size_t len = strlen(hex);
+		string password(len / 2, 0);
+		if (strcmp(hex, "-") == 0)
+			password.clear();
+		else if (len % 2 || hexDecode(hex, len / 2, (uint8_t *)&password[0]) != 0)
+			len = 1;
+		cw_engine *engine = cw_engine_new();
+		if (len != 1 && cw_engine_start(engine, password.data(), password.size(), job.b, job.n) == CW_OK)
+		{
+			JobEntry *entry = new JobEntry();
+			entry->job = job;
+			entry->job.id = nextId++;
+			entry->job.password = password;
+			cw_engine_state(engine, entry->job.state, &entry->job.done);
+			cw_progress progress;
+			cw_engine_poll(engine, &progress);
+			entry->job.total = progress.total;
+			entry->lastDone = entry->job.done;
+			if (save(entry))
+			{
+				jobs.push_back(entry);
+				reply = "QUEUED " + to_string(entry->job.id) + "\n";
+				event(entry->job.id, "QUEUED " + to_string(entry->job.id));
+				wake.notify_one();
+			}
+			else
+				delete entry;
+		}
+		cw_engine_free(engine);
+	}
+	else if (sscanf(request.c_str(), "CANCEL %" SCNu64, &id) == 1)
+	{
+		for (size_t i=0; i<jobs.size(); i++)
+		{
+			if (jobs[i]->job.id != id || jobs[i]->cancel)
+				continue;
+			jobs[i]->cancel = true;
+			reply = "OK\n";
+			if (jobs[i]->running)
+				break;
+
+			// Waiting jobs go at once; running ones when their slice ends
+			unlink((dir + "/jobs/" + jobName(id) + ".job").c_str());
+			event(id, "CANCELLED " + to_string(id), true);
+			delete jobs[i];
+			jobs.erase(jobs.begin() + i);
+			break;
+		}
+	}
+	else if (request == "LIST")
+	{
+		vector<JobEntry*> sorted = jobs;
+		sort(sorted.begin(), sorted.end(), before);
+		reply.clear();
+		for (size_t i=0; i<sorted.size(); i++)
+		{
+			const ChainJob &j = sorted[i]->job;
+			char line[160];
+			snprintf(line, sizeof(line), "JOB %" PRIu64 " %s %d %" PRId64 " %" PRIu64 " %" PRIu64 "\n",
+			         j.id, sorted[i]->running ? "running" : "queued", j.priority, j.deadline, j.done, j.total);
+			reply += line;
+		}
+		reply += "END\n";
+	}
+	else if (request == "WATCH" || sscanf(request.c_str(), "WATCH %" SCNu64, &id) == 1)
+	{
+		Watcher w = {fd, id};
+		watchers.push_back(w);
+		return;
+	}
+	else if (request == "SHUTDOWN")
+	{
+		stopping = true;
+		reply = "OK\n";
+		wake.notify_all();
+	}
+	if (send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0)
+		reply.clear();
+	close(fd);
+}
+
+bool JobDaemon::run()
+{
+	string socketPath = dir + "/socket";
+	struct sockaddr_un addr;
+	if (socketPath.size() >= sizeof(addr.sun_path))
+		return false;
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return false;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath.c_str());
+	unlink(socketPath.c_str());
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0)
+	{
+		close(fd);
+		return false;
+	}
+	load();
+	cout << "Serving " << jobs.size() << " saved jobs with " << workers << " workers on " << socketPath << endl;
+	for (unsigned i=0; i<workers; i++)
+		threads.push_back(thread(&JobDaemon::work, this));
+
+	// Requests are read as they come in, so a client that is slow to send one holds up nobody
+	struct Client
+	{
+		int fd;
+		string request;
+		steady_clock::time_point since;
+	};
+	vector<Client> clients;
+	auto last = steady_clock::now();
+	while (true)
+	{
+		{
+			lock_guard<mutex> locked(lock);
+			if (stopping)
+				break;
+		}
+		vector<struct pollfd> p(1 + clients.size());
+		p[0] = {fd, POLLIN, 0};
+		for (size_t i=0; i<clients.size(); i++)
+			p[i+1] = {clients[i].fd, POLLIN, 0};
+		if (poll(p.data(), p.size(), 250) > 0 && (p[0].revents & POLLIN))
+		{
+			int c = accept(fd, NULL, NULL);
+			if (c >= 0 && fcntl(c, F_SETFL, O_NONBLOCK) == 0)
+				clients.push_back({c, "", steady_clock::now()});
+			else if (c >= 0)
+				close(c);
+		}
+		for (size_t i=clients.size(); i-- > 0; )
+		{
+			Client &client = clients[i];
+			bool ended = false;
+			if (i+1 < p.size() && p[i+1].revents != 0)
+			{
+				char buf[512];
+				ssize_t n = read(client.fd, buf, sizeof(buf));
+				if (n > 0)
+					client.request.append(buf, n);
+				ended = n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR);
+			}
+			bool complete = client.request.find('\n') != string::npos || client.request.size() >= 4096 || ended;
+			if (!complete && steady_clock::now() - client.since < seconds(2))
+				continue;
+
+			// Answered in blocking mode; watchers get their events with MSG_DONTWAIT anyway
+			if (complete)
+			{
+				struct timeval timeout = {2, 0};
+				fcntl(client.fd, F_SETFL, 0);
+				setsockopt(client.fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+				handle(client.fd, client.request.substr(0, client.request.find('\n')));
+			}
+			else
+				close(client.fd);
+			clients.erase(clients.begin() + i);
+		}
+		if (steady_clock::now() - last >= seconds(1))
+		{
+			last += seconds(1);
+			tick();
+		}
+	}
+	for (size_t i=0; i<clients.size(); i++)
+		close(clients[i].fd);
+
+	// Workers save their jobs on the way out
+	for (size_t i=0; i<threads.size(); i++)
+		threads[i].join();
+	threads.clear();
+	for (size_t i=0; i<watchers.size(); i++)
+		close(watchers[i].fd);
+	watchers.clear();
+	close(fd);
+	unlink(socketPath.c_str());
+	return true;
+}
+
+bool jobRequest(const string &socketPath, const string &request, function<bool(const string &)> onLine)
+{
+	struct sockaddr_un addr;
+	if (socketPath.size() >= sizeof(addr.sun_path))
+		return false;
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return false;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath.c_str());
+	string text = request + "\n";
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+	    write(fd, text.data(), text.size()) != (ssize_t)text.size())
+	{
+		close(fd);
+		return false;
+	}
+	shutdown(fd, SHUT_WR);
+	string pending;
+	char buf[512];
+	ssize_t n;
+	bool more = true;
+	while (more && (n = read(fd, buf, sizeof(buf))) > 0)
+	{
+		pending.append(buf, n);
+		size_t end;
+		while (more && (end = pending.find('\n')) != string::npos)
+		{
+			more = onLine(pending.substr(0, end));
+			pending.erase(0, end + 1);
+		}
+	}
+	close(fd);
+	return true;
+}
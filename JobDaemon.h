@@ -0,0 +1,99 @@
+#ifndef JOBDAEMON_H
+
+#define JOBDAEMON_H
+
+// Daemon running chain jobs for many wallets.
+//
+// Jobs are submitted on a Unix socket (dir/socket) and wait in a queue ordered by priority, then by
+// deadline, then by age. Each worker thread runs one job on a chain engine in short slices. Between
+// slices it saves a checkpoint from time to time and gives its job back to the queue when a better
+// one is waiting and no worker is free. Every job lives in dir/jobs/job-NNNNNN.job, so a restart picks
+// the whole queue up again from the last checkpoints. A finished job is handed to the finisher, which
+// saves the wallet, and only its address is kept in job-NNNNNN.done.
+//
+// Job files hold the password and the chain state, so the directory has to be private.
+//
+// Requests, one per connection, each answered by lines of text:
+//   SUBMIT <priority> <deadline> <b> <n> <password hex>  ->  QUEUED <id>
+//   CANCEL <id>                                           ->  OK
+//   LIST                                                  ->  JOB <id> <status> <priority> <deadline> <done> <total>..., END
+//   WATCH [id]                                            ->  event lines until the job (or the daemon) ends
+//   SHUTDOWN                                              ->  OK, then checkpoint everything and exit
+// Events: QUEUED, START, PREEMPT and CANCELLED <id>; PROGRESS <id> <done> <total> <rate> <eta>;
+// LATE <id> when the deadline cannot be met; DONE <id> <address>; FAILED <id> when the wallet could not
+// be saved (the job file stays for the next start). Deadlines are Unix times, 0 for none.
+// Anything else gets ERROR.
+
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ChainJob
+{
+	uint64_t id;
+	int priority;			// Higher runs first
+	int64_t deadline;		// Unix time, 0 for none
+	int b, n;				// B^N hashes
+	std::string password;
+	uint64_t done, total;	// state is hash number done of the chain
+	uint8_t state[32];
+	double seconds;			// Hashing time over all runs
+};
+
+// "id priority deadline b n done total state seconds password" with the password in hex, and back
+std::string formatJob(const ChainJob &job);
+bool parseJob(const std::string &line, ChainJob &job);
+
+// Saves the wallet of a finished job and returns its address, or an empty string if it could not.
+// Never called by two threads at once.
+typedef std::string (*JobFinisher)(const ChainJob &job, const uint8_t end[32]);
+
+struct JobEntry;
+
+class JobDaemon
+{
+public:
+	JobDaemon(const std::string &dir, unsigned workers, JobFinisher finish);
+	~JobDaemon();
+
+	// Load the saved queue and serve until a SHUTDOWN request. Returns false if the socket fails.
+	bool run();
+
+private:
+	struct Watcher
+	{
+		int fd;
+		uint64_t id;		// 0 for every job
+	};
+
+	void load();
+	bool save(const JobEntry *entry);
+	void work();
+	JobEntry *next();
+	bool outranked(const JobEntry *entry);
+	void handle(int fd, const std::string &request);
+	void tick();
+	void event(uint64_t id, const std::string &line, bool last=false);
+
+	std::string dir;
+	unsigned workers;
+	JobFinisher finish;
+	std::vector<std::thread> threads;
+	std::mutex lock;		// Guards everything below
+	std::mutex finishing;
+	std::condition_variable wake;
+	std::vector<JobEntry*> jobs;
+	std::vector<Watcher> watchers;
+	uint64_t nextId;
+	unsigned idle;
+	bool stopping;
+};
+
+// Send a request to a daemon and pass every line of the answer to onLine until it returns false
+bool jobRequest(const std::string &socketPath, const std::string &request, std::function<bool(const std::string &)> onLine);
+
+#endif
@@ -0,0 +1,193 @@
+// Parallel scan and index of wallet files
+#include "KryptIndex.h"
+#include "Kryptonite.h"
+#include "WalletFile.h"
+#include "Parallel.hpp"
+#include "Trace.h"
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+static const char indexMagic[8] = {'C','W','I','N','D','E','X','1'};
+
+struct IndexHeader
+{
+	char magic[8];
+	uint64_t count;
+	uint64_t strings;	// Offset of the string pool
+};
+
+struct IndexRecord
+{
+	char address[64];	// Zero padded, so records sort with memcmp
+	uint32_t base;
+	uint32_t exponent;
+	uint32_t file;		// Offsets into the string pool
+	uint32_t eta;
+};
+
+void findKryptFiles(const string &dir, vector<string> &files)
+{
+	DIR *d = opendir(dir.c_str());
+	if (d == NULL)
+		return;
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL)
+	{
+		string name = e->d_name;
+		if (name == "." || name == "..")
+			continue;
+		string path = dir + "/" + name;
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0)
+			continue;
+		if (S_ISDIR(st.st_mode))
+			findKryptFiles(path, files);
+		else if (S_ISREG(st.st_mode) && name.size() > 6 && name.compare(name.size() - 6, 6, ".krypt") == 0)
+			files.push_back(path);
+	}
+	closedir(d);
+}
+
+bool buildIndex(const string &dir, const vector<string> &passwords, const string &indexPath,
+                int threads, IndexStats &stats)
+{
+	if (threads < 1)
+		threads = 1;
+	vector<string> files;
+	findKryptFiles(dir, files);
+	sort(files.begin(), files.end());
+	stats.files = files.size();
+	stats.matched = 0;
+	stats.entries = 0;
+
+	// Key setup once per password, then decrypt in parallel; every worker writes only its own slot
+	WalletKeys keys;
+	walletKeys(passwords, threads, keys);
+	vector<WalletFile> wallets(files.size());
+	vector<char> found(files.size(), 0);
+	parallelFor(files.size(), threads, [&](size_t i)
+	{
+		TRACE_SPAN_ARG("index", files[i]);
+		found[i] = openWallet(files[i], keys, wallets[i]);
+	});
+
+	// Records for both addresses of every wallet, sorted, and the string pool
+	vector<IndexRecord> records;
+	string pool;
+	for (size_t i=0; i<files.size(); i++)
+	{
+		if (!found[i])
+			continue;
+		stats.matched++;
+		IndexRecord r;
+		memset(&r, 0, sizeof(r));
+		r.base = strtoul(wallets[i].base.c_str(), NULL, 10);
+		r.exponent = strtoul(wallets[i].exponent.c_str(), NULL, 10);
+		r.file = pool.size();
+		pool += files[i];
+		pool += '\0';
+		r.eta = pool.size();
+		pool += wallets[i].eta;
+		pool += '\0';
+		const string *addrs[2] = {&wallets[i].pubC, &wallets[i].seg};
+		for (int a=0; a<2; a++)
+		{
+			if (addrs[a]->empty() || addrs[a]->size() >= sizeof(r.address))
+				continue;
+			memset(r.address, 0, sizeof(r.address));
+			memcpy(r.address, addrs[a]->data(), addrs[a]->size());
+			records.push_back(r);
+		}
+	}
+	sort(records.begin(), records.end(), [](const IndexRecord &a, const IndexRecord &b)
+	{
+		return memcmp(a.address, b.address, sizeof(a.address)) < 0;
+	});
+	stats.entries = records.size();
+
+	TRACE_SPAN("write index");
+	IndexHeader h;
+	memcpy(h.magic, indexMagic, 8);
+	h.count = records.size();
+	h.strings = sizeof(h) + records.size() * sizeof(IndexRecord);
+	FILE *f = fopen(indexPath.c_str(), "wb");
+	if (f == NULL)
+		return false;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	if (!records.empty())
+		ok = ok && fwrite(records.data(), sizeof(IndexRecord), records.size(), f) == records.size();
+	ok = ok && fwrite(pool.data(), 1, pool.size(), f) == pool.size();
+	ok = (fclose(f) == 0) && ok;
+	return ok;
+}
+
+int lookupIndex(const string &indexPath, const string &address, IndexEntry &entry)
+{
+	if (address.empty() || address.size() >= sizeof(((IndexRecord *)0)->address))
+		return 0;
+	int fd = open(indexPath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return -1;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(IndexHeader))
+	{
+		close(fd);
+		return -1;
+	}
+	size_t size = st.st_size;
+	const char *map = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return -1;
+
+	const IndexHeader *h = (const IndexHeader *)map;
+	if (memcmp(h->magic, indexMagic, 8) != 0 || h->strings > size ||
+	    h->count > (size - sizeof(IndexHeader)) / sizeof(IndexRecord))
+	{
+		munmap((void *)map, size);
+		return -1;
+	}
+	const IndexRecord *records = (const IndexRecord *)(map + sizeof(IndexHeader));
+	const char *pool = map + h->strings;
+	size_t poolSize = size - h->strings;
+
+	char key[64];
+	memset(key, 0, sizeof(key));
+	memcpy(key, address.data(), address.size());
+	size_t lo = 0, hi = h->count;
+	int ret = 0;
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) / 2;
+		int c = memcmp(records[mid].address, key, sizeof(key));
+		if (c < 0)
+			lo = mid + 1;
+		else if (c > 0)
+			hi = mid;
+		else
+		{
+			const IndexRecord &r = records[mid];
+			if (r.file >= poolSize || r.eta >= poolSize)
+			{
+				ret = -1;
+				break;
+			}
+			entry.address = address;
+			entry.base = r.base;
+			entry.exponent = r.exponent;
+			entry.file = string(pool + r.file, strnlen(pool + r.file, poolSize - r.file));
+			entry.eta = string(pool + r.eta, strnlen(pool + r.eta, poolSize - r.eta));
+			ret = 1;
+			break;
+		}
+	}
+	munmap((void *)map, size);
+	return ret;
+}
@@ -0,0 +1,41 @@
+#ifndef KRYPTINDEX_H
+
+#define KRYPTINDEX_H
+
+// Index of a directory of wallet files: address -> file, chain parameters and time to complete.
+//
+// The index is a sorted array of fixed size records followed by a string pool, so a lookup is a binary
+// search over a memory mapped file.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct IndexEntry
+{
+	std::string address;
+	std::string file;
+	std::string eta;
+	uint32_t base;
+	uint32_t exponent;
+};
+
+struct IndexStats
+{
+	size_t files;		// .krypt files found
+	size_t matched;		// files decrypted with one of the passwords
+	size_t entries;		// addresses written
+};
+
+// Collect the .krypt files below dir
+void findKryptFiles(const std::string &dir, std::vector<std::string> &files);
+
+// Walk dir for .krypt files, decrypt them with the candidate passwords on threads workers and write the index
+bool buildIndex(const std::string &dir, const std::vector<std::string> &passwords, const std::string &indexPath,
+                int threads, IndexStats &stats);
+
+// Find an address. Returns 1 if found, 0 if not and -1 if the index cannot be read.
+int lookupIndex(const std::string &indexPath, const std::string &address, IndexEntry &entry);
+
+#endif
@@ -0,0 +1,206 @@
+// Kryptonite encryption
+#include "Kryptonite.h"
+#include "HashBackend.h"
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KRYPT_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+#define KRYPT_WINDOW (64 << 20)	// Bytes mapped at once
+
+void kryptKey(KryptKey &key, const string &password)
+{
+	// Define digestLen to an unexpected value
+	int sumPass = 0;
+	for (int i=0; i<(int)password.size(); i++)
+	{
+		sumPass += password[i];
+	}
+	key.digestLen = 32 + sumPass % 32;
+
+	computeSHA512(password.data(), password.size(), key.digest);
+	for (int i=0; i<(int)sizeof(key.pattern); i++)
+		key.pattern[i] = key.digest[i % key.digestLen];
+}
+
+// 8 bytes at a time on any machine
+static void applyWords(const KryptKey &key, size_t pos, const uint8_t *source, uint8_t *destination, size_t len)
+{
+	size_t L = key.digestLen;
+	size_t step = 8 % L;
+	size_t i = 0;
+	for (; i+8<=len; i+=8)
+	{
+		uint64_t x, k;
+		memcpy(&x, source + i, 8);
+		memcpy(&k, key.pattern + pos, 8);
+		x ^= k;
+		memcpy(destination + i, &x, 8);
+		pos += step;
+		if (pos >= L)
+			pos -= L;
+	}
+	for (; i<len; i++)
+	{
+		destination[i] = source[i] ^ key.pattern[pos];
+		if (++pos == L)
+			pos = 0;
+	}
+}
+
+#ifdef KRYPT_X86
+// 64 bytes per iteration with two unaligned windows of the pattern
+__attribute__((target("avx2")))
+static void applyAVX2(const KryptKey &key, size_t pos, const uint8_t *source, uint8_t *destination, size_t len)
+{
+	size_t L = key.digestLen;
+	size_t step = 32 % L;
+	size_t i = 0;
+	for (; i+64<=len; i+=64)
+	{
+		__m256i k0 = _mm256_loadu_si256((const __m256i *)(key.pattern + pos));
+		pos += step;
+		if (pos >= L)
+			pos -= L;
+		__m256i k1 = _mm256_loadu_si256((const __m256i *)(key.pattern + pos));
+		pos += step;
+		if (pos >= L)
+			pos -= L;
+		__m256i a = _mm256_loadu_si256((const __m256i *)(source + i));
+		__m256i b = _mm256_loadu_si256((const __m256i *)(source + i + 32));
+		_mm256_storeu_si256((__m256i *)(destination + i),      _mm256_xor_si256(a, k0));
+		_mm256_storeu_si256((__m256i *)(destination + i + 32), _mm256_xor_si256(b, k1));
+	}
+	applyWords(key, pos, source + i, destination + i, len - i);
+}
+#endif
+
+void kryptApply(const KryptKey &key, uint64_t offset, const uint8_t *source, uint8_t *destination, size_t len)
+{
+	size_t pos = offset % key.digestLen;
+#ifdef KRYPT_X86
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	if (avx2 && len >= 64)
+	{
+		applyAVX2(key, pos, source, destination, len);
+		return;
+	}
+#endif
+	applyWords(key, pos, source, destination, len);
+}
+
+// write() all of buf
+static bool writeAll(int fd, const uint8_t *buf, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t n = write(fd, buf, len);
+		if (n <= 0)
+			return false;
+		buf += n;
+		len -= n;
+	}
+	return true;
+}
+
+int kryptFile(const KryptKey &key, const string &input, const string &output)
+{
+	bool toStdout = output == "-";
+	struct stat st, os;
+	if (stat(input.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return -1;
+
+	// The output may be the input under another name (./x, a link); any other existing file is kept
+	bool inPlace = false;
+	if (!toStdout && stat(output.c_str(), &os) == 0)
+	{
+		if (os.st_dev != st.st_dev || os.st_ino != st.st_ino)
+			return -2;
+		inPlace = true;
+	}
+	int in = open(input.c_str(), inPlace ? O_RDWR : O_RDONLY);
+	if (in < 0)
+		return -1;
+	if (fstat(in, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+		close(in);
+		return -1;
+	}
+	uint64_t size = st.st_size;
+
+	int out = in;
+	if (toStdout)
+		out = STDOUT_FILENO;
+	else if (!inPlace)
+	{
+		out = open(output.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (out < 0 || ftruncate(out, size) != 0)
+		{
+			close(in);
+			if (out >= 0)
+			{
+				close(out);
+				unlink(output.c_str());
+			}
+			return out < 0 && errno == EEXIST ? -2 : -1;
+		}
+	}
+
+	// Map a bounded window of input (and output) at a time so memory use stays constant
+	int ret = 0;
+	for (uint64_t done=0; done<size && ret==0; done+=KRYPT_WINDOW)
+	{
+		size_t len = size - done < KRYPT_WINDOW ? size - done : KRYPT_WINDOW;
+		uint8_t *src = (uint8_t *)mmap(NULL, len, inPlace ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, in, done);
+		if (src == MAP_FAILED)
+		{
+			ret = -1;
+			break;
+		}
+		madvise(src, len, MADV_SEQUENTIAL);
+		if (inPlace)
+		{
+			kryptApply(key, done, src, src, len);
+		}
+		else if (toStdout)
+		{
+			uint8_t buf[65536];
+			for (size_t i=0; i<len && ret==0; i+=sizeof(buf))
+			{
+				size_t n = len - i < sizeof(buf) ? len - i : sizeof(buf);
+				kryptApply(key, done + i, src + i, buf, n);
+				if (!writeAll(out, buf, n))
+					ret = -1;
+			}
+		}
+		else
+		{
+			uint8_t *dst = (uint8_t *)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, out, done);
+			if (dst == MAP_FAILED)
+				ret = -1;
+			else
+			{
+				kryptApply(key, done, src, dst, len);
+				munmap(dst, len);
+			}
+		}
+		munmap(src, len);
+	}
+	close(in);
+	if (out != in && !toStdout)
+	{
+		close(out);
+		if (ret != 0)
+			unlink(output.c_str());
+	}
+	return ret;
+}
@@ -0,0 +1,34 @@
+#ifndef KRYPTONITE_H
+
+#define KRYPTONITE_H
+
+// Kryptonite format (https://github.com/Saulo-Fonseca/Kryptonite)
+//
+// The data is XORed with the SHA512 digest of the password, cropped to a length between 32 and 63
+// bytes that depends on the password, and repeated over the whole input. Encryption and decryption
+// are the same operation.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+struct KryptKey
+{
+	int digestLen;
+	uint8_t digest[64];
+	uint8_t pattern[64 + 31];	// digest repeated so any 32 byte window is contiguous
+};
+
+// Prepare the key stream of a password
+void kryptKey(KryptKey &key, const std::string &password);
+
+// XOR len bytes that start at stream position offset. source and destination may be the same buffer,
+// so large inputs can be processed in place or in chunks of any size.
+void kryptApply(const KryptKey &key, uint64_t offset, const uint8_t *source, uint8_t *destination, size_t len);
+
+// Encrypt or decrypt a whole file with mmap in bounded windows; output "-" writes to stdout and
+// an output that is the input file (by any name) works in place. Returns 0 on success, -1 on I/O
+// errors and -2 if output is another file that already exists, which is never replaced.
+int kryptFile(const KryptKey &key, const std::string &input, const std::string &output);
+
+#endif
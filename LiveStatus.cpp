@@ -0,0 +1,259 @@
+// Shared memory status of running chains
+#include "LiveStatus.h"
+#include <algorithm>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+using namespace std;
+
+static const char statusMagic[8] = "CWSTAT2";
+
+static double monotonic()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static string segmentName(int pid)
+{
+	return "/chainwallet." + to_string(pid);
+}
+
+LiveStatus::LiveStatus(const char *mode, uint64_t total, const char *kernel)
+	: done(0), checkpoint(0), block(NULL), tid((int)syscall(SYS_gettid)), start(monotonic()), lastCheckpoint(0), lastCheckpointTime(0), stopping(false)
+{
+	// Without shared memory the run just goes on unobserved
+	name = segmentName(getpid());
+	int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+	if (fd < 0)
+		return;
+	if (ftruncate(fd, sizeof(LiveStatusBlock)) == 0)
+	{
+		void *p = mmap(NULL, sizeof(LiveStatusBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (p != MAP_FAILED)
+			block = (LiveStatusBlock*)p;
+	}
+	close(fd);
+	if (block == NULL)
+	{
+		shm_unlink(name.c_str());
+		return;
+	}
+	memset(block, 0, sizeof(LiveStatusBlock));
+	block->pid = getpid();
+	snprintf(block->mode, sizeof(block->mode), "%s", mode);
+	snprintf(block->kernel, sizeof(block->kernel), "%s", kernel);
+	block->total = total;
+	block->checkpointAge = -1;
+	publish();
+	memcpy(block->magic, statusMagic, sizeof(statusMagic));
+	reporter = thread(&LiveStatus::report, this);
+}
+
+LiveStatus::~LiveStatus()
+{
+	if (block == NULL)
+		return;
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_one();
+	reporter.join();
+	munmap(block, sizeof(LiveStatusBlock));
+	shm_unlink(name.c_str());
+}
+
+void LiveStatus::report()
+{
+	unique_lock<mutex> guard(lock);
+	while (!wake.wait_for(guard, chrono::seconds(1), [this] { return stopping; }))
+		publish();
+}
+
+// Rate between now and the newest sample at least window seconds old
+static double windowRate(const vector<pair<double,uint64_t>> &samples, double window)
+{
+	const pair<double,uint64_t> &now = samples.back();
+	for (size_t i=samples.size(); i-->0;)
+	{
+		if (now.first - samples[i].first >= window || i == 0)
+		{
+			double dt = now.first - samples[i].first;
+			return dt > 0 ? (now.second - samples[i].second) / dt : 0;
+		}
+	}
+	return 0;
+}
+
+// First number after key in a /proc file of the form "key: value"
+static bool procValue(const string &path, const char *key, uint64_t &value)
+{
+	FILE *f = fopen(path.c_str(), "r");
+	if (f == NULL)
+		return false;
+	char line[256];
+	size_t n = strlen(key);
+	bool found = false;
+	while (!found && fgets(line, sizeof(line), f))
+	{
+		char *colon = strchr(line, ':');
+		found = strncmp(line, key, n) == 0 && colon && sscanf(colon + 1, "%" SCNu64, &value) == 1;
+	}
+	fclose(f);
+	return found;
+}
+
+// Field 39 of /proc/.../stat, after the command name in parentheses
+static int lastCpu(const string &path)
+{
+	FILE *f = fopen(path.c_str(), "r");
+	if (f == NULL)
+		return -1;
+	char line[1024];
+	int cpu = -1;
+	if (fgets(line, sizeof(line), f))
+	{
+		char *p = strrchr(line, ')');
+		for (int field=2; p && field<39; field++)
+			p = strchr(p + 1, ' ');
+		if (p == NULL || sscanf(p + 1, "%d", &cpu) != 1)
+			cpu = -1;
+	}
+	fclose(f);
+	return cpu;
+}
+
+void LiveStatus::publish()
+{
+	double now = monotonic();
+	uint64_t d = done.load(memory_order_relaxed);
+	samples.push_back(make_pair(now, d));
+	while (samples.size() > 2 && now - samples[1].first >= 60)
+		samples.erase(samples.begin());
+	uint64_t cp = checkpoint.load(memory_order_relaxed);
+
+	// Scheduling of the loop thread, read by this thread so the loop pays nothing
+	string task = "/proc/self/task/" + to_string(tid);
+	uint64_t migrations = UINT64_MAX, preemptions = 0;
+	if (!procValue(task + "/sched", "se.nr_migrations", migrations))
+		migrations = UINT64_MAX;
+	procValue(task + "/status", "nonvoluntary_ctxt_switches", preemptions);
+	int cpu = lastCpu(task + "/stat");
+	if (cp != lastCheckpoint)
+	{
+		lastCheckpoint = cp;
+		lastCheckpointTime = now;
+	}
+
+	__atomic_fetch_add(&block->seq, 1, __ATOMIC_RELAXED);
+	atomic_thread_fence(memory_order_release);
+	block->done = d;
+	block->rate1 = windowRate(samples, 1);
+	block->rate10 = windowRate(samples, 10);
+	block->rate60 = windowRate(samples, 60);
+	block->eta = block->rate10 > 0 && block->total > d ? (block->total - d) / block->rate10 : 0;
+	block->elapsed = now - start;
+	block->checkpoint = cp;
+	block->checkpointAge = cp ? now - lastCheckpointTime : -1;
+	block->updated = time(NULL);
+	block->cpu = cpu;
+	block->migrations = migrations;
+	block->preemptions = preemptions;
+	__atomic_fetch_add(&block->seq, 1, __ATOMIC_RELEASE);
+}
+
+bool readLiveStatus(int pid, LiveStatusBlock &status)
+{
+	int fd = shm_open(segmentName(pid).c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	void *p = mmap(NULL, sizeof(LiveStatusBlock), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+		return false;
+	LiveStatusBlock *block = (LiveStatusBlock*)p;
+	bool ok = false;
+	for (int tries=0; tries<1000 && !ok; tries++)
+	{
+		uint64_t before = __atomic_load_n(&block->seq, __ATOMIC_ACQUIRE);
+		if (before & 1)
+			continue;
+		memcpy(&status, block, sizeof(status));
+		atomic_thread_fence(memory_order_acquire);
+		ok = __atomic_load_n(&block->seq, __ATOMIC_RELAXED) == before;
+	}
+	munmap(p, sizeof(LiveStatusBlock));
+	return ok && memcmp(status.magic, statusMagic, sizeof(statusMagic)) == 0;
+}
+
+vector<int> liveStatusPids()
+{
+	vector<int> pids;
+	DIR *d = opendir("/dev/shm");
+	if (d == NULL)
+		return pids;
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL)
+	{
+		// Segments of killed processes stay behind; skip them
+		int pid;
+		if (sscanf(e->d_name, "chainwallet.%d", &pid) == 1 && kill(pid, 0) == 0)
+			pids.push_back(pid);
+	}
+	closedir(d);
+	sort(pids.begin(), pids.end());
+	return pids;
+}
+
+string liveStatusPrometheus(const vector<LiveStatusBlock> &status)
+{
+	static const struct { const char *name, *help, *type; } metrics[] =
+	{
+		{"chainwallet_iterations", "Iterations done", "gauge"},
+		{"chainwallet_iterations_target", "Iterations of the run", "gauge"},
+		{"chainwallet_rate", "Iterations per second over a sliding window", "gauge"},
+		{"chainwallet_eta_seconds", "Seconds left at the 10 second rate", "gauge"},
+		{"chainwallet_elapsed_seconds", "Seconds since the start", "gauge"},
+		{"chainwallet_checkpoint_age_seconds", "Seconds since the last checkpoint, -1 if none", "gauge"},
+		{"chainwallet_cpu", "CPU the loop thread last ran on, -1 if unknown", "gauge"},
+		{"chainwallet_migrations_total", "Moves of the loop thread to another CPU", "counter"},
+		{"chainwallet_preemptions_total", "Involuntary context switches of the loop thread", "counter"},
+	};
+	string out;
+	char line[512];
+	for (size_t m=0; m<sizeof(metrics)/sizeof(metrics[0]); m++)
+	{
+		out += string("# HELP ") + metrics[m].name + " " + metrics[m].help + "\n";
+		out += string("# TYPE ") + metrics[m].name + " " + metrics[m].type + "\n";
+		for (size_t i=0; i<status.size(); i++)
+		{
+			const LiveStatusBlock &s = status[i];
+			char labels[128];
+			snprintf(labels, sizeof(labels), "pid=\"%d\",mode=\"%s\",kernel=\"%s\"", s.pid, s.mode, s.kernel);
+			if (m == 2)
+			{
+				snprintf(line, sizeof(line), "%s{%s,window=\"1s\"} %.1f\n%s{%s,window=\"10s\"} %.1f\n%s{%s,window=\"60s\"} %.1f\n",
+				         metrics[m].name, labels, s.rate1, metrics[m].name, labels, s.rate10, metrics[m].name, labels, s.rate60);
+				out += line;
+				continue;
+			}
+			if (m == 7 && s.migrations == UINT64_MAX)
+				continue;
+			double v = m == 0 ? s.done : m == 1 ? s.total : m == 3 ? s.eta : m == 4 ? s.elapsed : m == 5 ? s.checkpointAge :
+			           m == 6 ? s.cpu : m == 7 ? s.migrations : s.preemptions;
+			snprintf(line, sizeof(line), "%s{%s} %.17g\n", metrics[m].name, labels, v);
+			out += line;
+		}
+	}
+	return out;
+}
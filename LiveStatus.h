@@ -0,0 +1,78 @@
+#ifndef LIVESTATUS_H
+
+#define LIVESTATUS_H
+
+// Live status of a running chain in a small shared memory segment, /dev/shm/chainwallet.<pid>.
+//
+// The hash loop only stores its iteration in an atomic. A reporter thread samples it once a second,
+// works out the rates over sliding windows and the remaining time, and publishes them under a sequence
+// lock, so neither the loop nor the readers ever wait and the loop makes no system calls.
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct LiveStatusBlock
+{
+	char magic[8];			// "CWSTAT2"
+	int32_t pid;
+	uint32_t pad;
+	uint64_t seq;			// Odd while the reporter writes (accessed with __atomic builtins)
+	char mode[16];			// chain, lanes, squarings...
+	char kernel[32];		// Hash or squaring kernel in use
+	uint64_t done;			// Iterations done
+	uint64_t total;			// Iterations of the run
+	double rate1, rate10, rate60;	// Iterations per second over the last 1, 10 and 60 seconds
+	double eta;				// Seconds left at the 10 second rate
+	double elapsed;			// Seconds since the start
+	uint64_t checkpoint;	// Index of the last checkpoint written, 0 if none
+	double checkpointAge;	// Seconds since it was written, -1 if none
+	int64_t updated;		// Unix time of the last update
+	int32_t cpu;			// CPU the loop thread last ran on, -1 if unknown
+	uint32_t pad2;
+	uint64_t migrations;	// Moves of the loop thread to another CPU, UINT64_MAX if unknown
+	uint64_t preemptions;	// Involuntary context switches of the loop thread
+};
+
+class LiveStatus
+{
+public:
+	// The thread that creates it is the one whose scheduling is reported
+	LiveStatus(const char *mode, uint64_t total, const char *kernel);
+	~LiveStatus();
+
+	// Written by the running loop
+	std::atomic<uint64_t> done;
+	std::atomic<uint64_t> checkpoint;
+
+private:
+	void report();
+	void publish();
+
+	LiveStatusBlock *block;
+	std::string name;
+	int tid;
+	std::vector<std::pair<double,uint64_t>> samples;	// (seconds, done) of the last minute
+	double start;
+	uint64_t lastCheckpoint;
+	double lastCheckpointTime;
+	bool stopping;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::thread reporter;
+};
+
+// Consistent copy of the status of a process. Returns false if it has none.
+bool readLiveStatus(int pid, LiveStatusBlock &status);
+
+// Processes that publish a status
+std::vector<int> liveStatusPids();
+
+// Status as Prometheus text format
+std::string liveStatusPrometheus(const std::vector<LiveStatusBlock> &status);
+
+#endif
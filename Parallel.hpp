@@ -0,0 +1,30 @@
+#ifndef GUARD_PARALLEL
+#define GUARD_PARALLEL
+
+// Minimal thread pool for independent work items
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Run f(i) for i in [0,count) on up to threads workers
+template <typename F>
+void parallelFor(size_t count, int threads, F f)
+{
+	if (threads < 1)
+		threads = 1;
+	if ((size_t)threads > count)
+		threads = count;
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> pool;
+	for (int t=0; t<threads; t++)
+	{
+		pool.push_back(std::thread([&]()
+		{
+			for (size_t i = next++; i < count; i = next++)
+				f(i);
+		}));
+	}
+	for (size_t t=0; t<pool.size(); t++)
+		pool[t].join();
+}
+#endif
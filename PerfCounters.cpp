@@ -0,0 +1,113 @@
+// perf_event_open counters
+#include "PerfCounters.h"
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+using namespace std;
+
+static uint64_t wallNanos()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+PerfCounters::PerfCounters() : wallStart(0), running(false)
+{
+	static const uint32_t types[COUNTERS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+	static const uint64_t configs[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+	                                           PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_TASK_CLOCK};
+	for (int i=0; i<COUNTERS; i++)
+	{
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = types[i];
+		attr.config = configs[i];
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		base[i] = 0;
+	}
+}
+
+PerfCounters::~PerfCounters()
+{
+	for (int i=0; i<COUNTERS; i++)
+		if (fd[i] >= 0)
+			close(fd[i]);
+}
+
+// Counter value scaled for the time it was multiplexed out, or -1
+double PerfCounters::readCounter(int i) const
+{
+	uint64_t v[3];
+	if (fd[i] < 0 || read(fd[i], v, sizeof(v)) != sizeof(v) || v[2] == 0)
+		return -1;
+	return (double)v[0] * v[1] / v[2];
+}
+
+void PerfCounters::begin(const string &stage, uint64_t ops, const char *unit)
+{
+	end();
+	current.stage = stage;
+	current.ops = ops ? ops : 1;
+	current.unit = unit;
+	for (int i=0; i<COUNTERS; i++)
+		base[i] = readCounter(i);
+	wallStart = wallNanos();
+	running = true;
+}
+
+void PerfCounters::end()
+{
+	if (!running)
+		return;
+	uint64_t wall = wallNanos() - wallStart;
+	double v[COUNTERS];
+	for (int i=0; i<COUNTERS; i++)
+	{
+		double now = readCounter(i);
+		v[i] = now < 0 || base[i] < 0 ? -1 : now - base[i];
+	}
+	current.cycles = v[CYCLES];
+	current.instructions = v[INSTRUCTIONS];
+	current.branchMisses = v[BRANCH_MISSES];
+	current.nanos = v[TASK_CLOCK] >= 0 ? v[TASK_CLOCK] : wall;
+	done.push_back(current);
+	running = false;
+}
+
+string PerfCounters::report() const
+{
+	string out;
+	char line[200];
+	snprintf(line, sizeof(line), "%-14s %14s %12s %12s %6s %6s %12s\n",
+	         "Stage", "Ops", "ns/op", "cycles/op", "IPC", "GHz", "br-miss/op");
+	out += line;
+	for (size_t i=0; i<done.size(); i++)
+	{
+		const PerfSample &s = done[i];
+		char cyc[16] = "n/a", ipc[16] = "n/a", ghz[16] = "n/a", br[16] = "n/a", ops[32];
+		if (s.cycles >= 0)
+		{
+			snprintf(cyc, sizeof(cyc), "%.1f", s.cycles / s.ops);
+			if (s.nanos > 0)
+				snprintf(ghz, sizeof(ghz), "%.2f", s.cycles / s.nanos);
+			if (s.instructions >= 0 && s.cycles > 0)
+				snprintf(ipc, sizeof(ipc), "%.2f", s.instructions / s.cycles);
+		}
+		if (s.branchMisses >= 0)
+			snprintf(br, sizeof(br), "%.3f", s.branchMisses / s.ops);
+		snprintf(ops, sizeof(ops), "%llu %s", (unsigned long long)s.ops, s.unit);
+		snprintf(line, sizeof(line), "%-14s %14s %12.1f %12s %6s %6s %12s\n",
+		         s.stage.c_str(), ops, s.nanos / s.ops, cyc, ipc, ghz, br);
+		out += line;
+	}
+	return out;
+}
@@ -0,0 +1,53 @@
+#ifndef PERFCOUNTERS_H
+
+#define PERFCOUNTERS_H
+
+// Hardware counters of the calling thread through perf_event_open: cycles, instructions and branch
+// misses, with the task clock for the CPU time. Each counter is opened on its own, so whatever the
+// kernel allows is still reported (virtual machines often have no hardware counters at all; with
+// perf_event_paranoid 2 only user space is counted).
+//
+// Stages are timed back to back: begin() closes the previous stage and starts the next one.
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct PerfSample
+{
+	std::string stage;
+	uint64_t ops;			// Work items of the stage, for the per-op figures
+	const char *unit;
+	double cycles, instructions, branchMisses;	// < 0 when not available
+	double nanos;			// Task clock, or wall time without it
+};
+
+class PerfCounters
+{
+public:
+	PerfCounters();
+	~PerfCounters();
+
+	// Start a stage, ending the running one
+	void begin(const std::string &stage, uint64_t ops=1, const char *unit="op");
+	void end();
+
+	const std::vector<PerfSample> &samples() const { return done; }
+
+	// Table with ns/op, cycles/op, IPC, clock and branch misses per op of every stage
+	std::string report() const;
+
+private:
+	enum { CYCLES, INSTRUCTIONS, BRANCH_MISSES, TASK_CLOCK, COUNTERS };
+
+	double readCounter(int i) const;
+
+	int fd[COUNTERS];
+	double base[COUNTERS];
+	uint64_t wallStart;
+	bool running;
+	PerfSample current;
+	std::vector<PerfSample> done;
+};
+
+#endif
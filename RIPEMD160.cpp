@@ -1,4 +1,5 @@
 #include "RIPEMD160.h"
+#include "HashBackend.h"
 #include <string.h>
 
 
@@ -366,7 +367,7 @@ void MDfinish(uint32_t *MDbuf,const uint8_t *strptr, uint32_t lswlen, uint32_t m
 
 #define RMDsize 160
 
-void computeRIPEMD160(const void *_message,uint32_t length,uint8_t hashcode[20])
+void ripemd160_reference_hash(const void *_message,uint32_t length,uint8_t hashcode[20])
 /*
  * returns RMD(message)
  * message should be a string terminated by '\0'
@@ -403,4 +404,10 @@ void computeRIPEMD160(const void *_message,uint32_t length,uint8_t hashcode[20])
 
 }
 
+
+void computeRIPEMD160(const void *input, uint32_t length, uint8_t hashcode[20])
+{
+	hashBackend->ripemd160(input, length, hashcode);
+}
+
 /************************ end of file rmd160.c **********************/
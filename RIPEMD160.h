@@ -11,8 +11,12 @@
 // The implementation is based on the reference version released by Antoon Bosselaers, ESAT-COSIC in 1996
 //
 
+// With the selected hash backend (see HashBackend.h)
 void computeRIPEMD160(const void *input,	// The input data to compute the hash for.
 					  uint32_t length,		// The length of the input data
 					  uint8_t hashcode[20]); // The output hash of 160 bits (20 bytes)
 
+// The implementation below, whatever backend is selected
+void ripemd160_reference_hash(const void *input, uint32_t length, uint8_t hashcode[20]);
+
 #endif
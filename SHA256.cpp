@@ -29,16 +29,27 @@
  */
 
 #include "SHA256.h"
+#include "HashBackend.h"
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
 
 #ifdef _MSC_VER 
 #pragma warning(disable:4718) // Disable a compiler optimization warning on visual studio
 #endif
 
 
-#define SHA256_HASH_SIZE  32	/* 256 bit */
-#define SHA256_HASH_WORDS 8
-#define SHA256_UNROLL 64	// This define determines how much loop unrolling is done when computing the hash; 
+// The compression function is compiled for every SHA256_UNROLL value, and with the SHA extensions on x86;
+// sha256_autotune() picks the fastest at run time.
 
 // Uncomment this line of code if you want this snippet to compute the endian mode of your processor at run time; rather than at compile time.
 //#define RUNTIME_ENDIAN
@@ -46,23 +57,6 @@
 // Uncomment this line of code if you want this routine to compile for a big-endian processor
 //#define WORDS_BIGENDIAN
 
-typedef struct 
-{
-	uint64_t totalLength;
-	uint32_t hash[SHA256_HASH_WORDS];
-	uint32_t bufferLength;
-	union 
-	{
-		uint32_t words[16];
-		uint8_t bytes[64];
-	} buffer;
-} sha256_ctx_t;
-
-void sha256_init(sha256_ctx_t * sc);
-void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len);
-void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE]);
-
-
 #define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
 #define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
 
@@ -213,211 +207,138 @@ static void burnStack(int size)
 		burnStack(size);
 }
 
-static void SHA256Guts(sha256_ctx_t * sc, const uint32_t * cbuf)
+#define SHA256_UNROLL 1
+#define SHA256_GUTS_NAME SHA256Guts1
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 2
+#define SHA256_GUTS_NAME SHA256Guts2
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 4
+#define SHA256_GUTS_NAME SHA256Guts4
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 8
+#define SHA256_GUTS_NAME SHA256Guts8
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 16
+#define SHA256_GUTS_NAME SHA256Guts16
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 32
+#define SHA256_GUTS_NAME SHA256Guts32
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#define SHA256_UNROLL 64
+#define SHA256_GUTS_NAME SHA256Guts64
+#define SHA256_GUTS_ATTR
+#include "SHA256Guts.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+// The same code with rorx for the rotations
+#define SHA256_UNROLL 64
+#define SHA256_GUTS_NAME SHA256GutsBMI2
+#define SHA256_GUTS_ATTR __attribute__((target("bmi2")))
+#include "SHA256Guts.h"
+
+// SHA extensions: two rounds per sha256rnds2, message schedule with sha256msg1/2.
+// The state is kept as ABEF and CDGH as the instructions want it.
+__attribute__((target("sha,sse4.1")))
+static void SHA256GutsSHANI(sha256_ctx_t * sc, const uint32_t * cbuf)
 {
-	uint32_t buf[64];
-	uint32_t *W, *W2, *W7, *W15, *W16;
-	uint32_t a, b, c, d, e, f, g, h;
-	uint32_t t1, t2;
-	const uint32_t *Kp;
-	int i;
-
-	W = buf;
-
-	for (i = 15; i >= 0; i--) 
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i tmp = _mm_loadu_si128((const __m128i *)&sc->hash[0]);
+	__m128i state1 = _mm_loadu_si128((const __m128i *)&sc->hash[4]);
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);				// CDAB
+	state1 = _mm_shuffle_epi32(state1, 0x1B);		// EFGH
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);	// ABEF
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);	// CDGH
+	__m128i abef = state0, cdgh = state1;
+
+	__m128i w[4];
+	for (int i = 0; i < 16; i++)
 	{
-		*(W++) = BYTESWAP(*cbuf);
-		cbuf++;
+		__m128i m;
+		if (i < 4)
+			m = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cbuf + i), mask);
+		else
+		{
+			// w[i] = msg2(msg1(w[i-4], w[i-3]) + w[i-7 .. i-4], w[i-1])
+			m = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+			m = _mm_add_epi32(m, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+			m = _mm_sha256msg2_epu32(m, w[(i + 3) & 3]);
+		}
+		w[i & 3] = m;
+		__m128i k = _mm_add_epi32(m, _mm_loadu_si128((const __m128i *)&K[4 * i]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(k, 0x0E));
 	}
 
-	W16 = &buf[0];
-	W15 = &buf[1];
-	W7 = &buf[9];
-	W2 = &buf[14];
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+	tmp = _mm_shuffle_epi32(state0, 0x1B);			// FEBA
+	state1 = _mm_shuffle_epi32(state1, 0xB1);		// DCHG
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);	// DCBA
+	state1 = _mm_alignr_epi8(state1, tmp, 8);		// HGFE
+	_mm_storeu_si128((__m128i *)&sc->hash[0], state0);
+	_mm_storeu_si128((__m128i *)&sc->hash[4], state1);
+}
 
-	for (i = 47; i >= 0; i--) 
-	{
-		*(W++) = sigma1(*W2) + *(W7++) + sigma0(*W15) + *(W16++);
-		W2++;
-		W15++;
-	}
+static int hasBMI2(void)
+{
+	return __builtin_cpu_supports("bmi2");
+}
 
-	a = sc->hash[0];
-	b = sc->hash[1];
-	c = sc->hash[2];
-	d = sc->hash[3];
-	e = sc->hash[4];
-	f = sc->hash[5];
-	g = sc->hash[6];
-	h = sc->hash[7];
+static int hasSHANI(void)
+{
+	unsigned int a, b, c, d;
+	return __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1 << 29)) && __builtin_cpu_supports("sse4.1");
+}
+#endif
 
-	Kp = K;
-	W = buf;
+static int always(void)
+{
+	return 1;
+}
 
-#ifndef SHA256_UNROLL
-#define SHA256_UNROLL 1
-#endif				/* !SHA256_UNROLL */
-
-#if SHA256_UNROLL == 1
-	for (i = 63; i >= 0; i--)
-		DO_ROUND();
-#elif SHA256_UNROLL == 2
-	for (i = 31; i >= 0; i--) {
-		DO_ROUND();
-		DO_ROUND();
-	}
-#elif SHA256_UNROLL == 4
-	for (i = 15; i >= 0; i--) {
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-	}
-#elif SHA256_UNROLL == 8
-	for (i = 7; i >= 0; i--) {
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-	}
-#elif SHA256_UNROLL == 16
-	for (i = 3; i >= 0; i--) {
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-	}
-#elif SHA256_UNROLL == 32
-	for (i = 1; i >= 0; i--) {
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-		DO_ROUND();
-	}
-#elif SHA256_UNROLL == 64
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-	DO_ROUND();
-#else
-#error "SHA256_UNROLL must be 1, 2, 4, 8, 16, 32, or 64!"
+typedef void (*sha256_guts_t)(sha256_ctx_t * sc, const uint32_t * cbuf);
+
+static const struct
+{
+	const char *name;
+	sha256_guts_t guts;
+	int (*available)(void);
+} kernels[] = {
+	{"unroll-1", SHA256Guts1, always},
+	{"unroll-2", SHA256Guts2, always},
+	{"unroll-4", SHA256Guts4, always},
+	{"unroll-8", SHA256Guts8, always},
+	{"unroll-16", SHA256Guts16, always},
+	{"unroll-32", SHA256Guts32, always},
+	{"unroll-64", SHA256Guts64, always},
+#if defined(__x86_64__) || defined(__i386__)
+	{"bmi2", SHA256GutsBMI2, hasBMI2},
+	{"sha-ni", SHA256GutsSHANI, hasSHANI},
 #endif
+};
 
-	sc->hash[0] += a;
-	sc->hash[1] += b;
-	sc->hash[2] += c;
-	sc->hash[3] += d;
-	sc->hash[4] += e;
-	sc->hash[5] += f;
-	sc->hash[6] += g;
-	sc->hash[7] += h;
-}
+#define KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+#define DEFAULT_KERNEL 6	// unroll-64, the fixed choice before the kernels could be switched
 
-void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len)
+// Kernel used by sha256_update
+static sha256_guts_t SHA256Guts = SHA256Guts64;
+static int currentKernel = DEFAULT_KERNEL;
+
+// Update and finalize with a given kernel, so the reference hash does not depend on the one selected
+static void update(sha256_ctx_t * sc, const void *data, uint32_t len, sha256_guts_t guts)
 {
 	uint32_t bufferBytesLeft;
 	uint32_t bytesToCopy;
@@ -438,7 +359,7 @@ void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len)
 		len -= bytesToCopy;
 		if (sc->bufferLength == 64L) 
 		{
-			SHA256Guts(sc, sc->buffer.words);
+			guts(sc, sc->buffer.words);
 			needBurn = 1;
 			sc->bufferLength = 0L;
 		}
@@ -448,7 +369,7 @@ void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len)
 	{
 		sc->totalLength += 512L;
 
-		SHA256Guts(sc, (const uint32_t *)data);
+		guts(sc, (const uint32_t *)data);
 		needBurn = 1;
 
 		data = ((uint8_t *) data) + 64L;
@@ -468,7 +389,12 @@ void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len)
 	}
 }
 
-void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE])
+void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len)
+{
+	update(sc, data, len, SHA256Guts);
+}
+
+static void finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE], sha256_guts_t guts)
 {
 	uint32_t bytesToPad;
 	uint64_t lengthPad;
@@ -482,8 +408,8 @@ void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE])
 
 	lengthPad = BYTESWAP64(sc->totalLength);
 
-	sha256_update(sc, padding, bytesToPad);
-	sha256_update(sc, &lengthPad, 8L);
+	update(sc, padding, bytesToPad, guts);
+	update(sc, &lengthPad, 8L, guts);
 
 	if (hash) 
 	{
@@ -495,12 +421,290 @@ void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE])
 	}
 }
 
+void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE])
+{
+	finalize(sc, hash, SHA256Guts);
+}
 
 void computeSHA256(const void *input,uint32_t size,uint8_t destHash[32])
+{
+	hashBackend->sha256(input, size, destHash);
+}
+
+void sha256_kernel_hash(const void *input, uint32_t size, uint8_t destHash[32])
+{
+	sha256_ctx_t sc;
+	sha256_init(&sc);
+	update(&sc, input, size, SHA256Guts);
+	finalize(&sc, destHash, SHA256Guts);
+}
+
+void sha256_reference_hash(const void *input, uint32_t size, uint8_t destHash[32])
+{
+	sha256_ctx_t sc;
+	sha256_init(&sc);
+	update(&sc, input, size, SHA256Guts64);
+	finalize(&sc, destHash, SHA256Guts64);
+}
+
+void sha256_copy(sha256_ctx_t * dst, const sha256_ctx_t * src)
+{
+	memcpy(dst, src, sizeof(sha256_ctx_t));
+}
+
+int sha256_get_midstate(const sha256_ctx_t * sc, uint32_t state[SHA256_HASH_WORDS], uint64_t * bytes)
+{
+	if (sc->bufferLength)
+		return 0;
+	memcpy(state, sc->hash, sizeof(sc->hash));
+	if (bytes)
+		*bytes = sc->totalLength / 8;
+	return 1;
+}
+
+void sha256_set_midstate(sha256_ctx_t * sc, const uint32_t state[SHA256_HASH_WORDS], uint64_t bytes)
+{
+	memcpy(sc->hash, state, sizeof(sc->hash));
+	sc->totalLength = bytes * 8;
+	sc->bufferLength = 0L;
+}
+
+void sha256_init_tagged(sha256_ctx_t * sc, const void *tag, uint32_t tagLen)
+{
+	uint8_t tagHash[SHA256_HASH_SIZE];
+	computeSHA256(tag, tagLen, tagHash);
+	sha256_init(sc);
+	sha256_update(sc, tagHash, SHA256_HASH_SIZE);
+	sha256_update(sc, tagHash, SHA256_HASH_SIZE);
+}
+
+void hmac_sha256_init(hmac_sha256_key_t * key, const void *secret, uint32_t len)
+{
+	uint8_t block[SHA256_BLOCK_SIZE];
+	uint8_t pad[SHA256_BLOCK_SIZE];
+	int i;
+
+	// Keys longer than a block are hashed first
+	memset(block, 0, sizeof(block));
+	if (len > SHA256_BLOCK_SIZE)
+		computeSHA256(secret, len, block);
+	else
+		memcpy(block, secret, len);
+
+	for (i = 0; i < SHA256_BLOCK_SIZE; i++)
+		pad[i] = block[i] ^ 0x36;
+	sha256_init(&key->inner);
+	sha256_update(&key->inner, pad, SHA256_BLOCK_SIZE);
+
+	for (i = 0; i < SHA256_BLOCK_SIZE; i++)
+		pad[i] = block[i] ^ 0x5c;
+	sha256_init(&key->outer);
+	sha256_update(&key->outer, pad, SHA256_BLOCK_SIZE);
+
+	memset(block, 0, sizeof(block));
+	memset(pad, 0, sizeof(pad));
+}
+
+void hmac_sha256(const hmac_sha256_key_t * key, const void *data, uint32_t len, uint8_t mac[SHA256_HASH_SIZE])
 {
 	sha256_ctx_t sc;
+	uint8_t innerHash[SHA256_HASH_SIZE];
+
+	sha256_copy(&sc, &key->inner);
+	sha256_update(&sc, data, len);
+	sha256_finalize(&sc, innerHash);
+
+	sha256_copy(&sc, &key->outer);
+	sha256_update(&sc, innerHash, SHA256_HASH_SIZE);
+	sha256_finalize(&sc, mac);
+}
+
+#define SHA256_FILE_CHUNK (1 << 20)
+
+int computeSHA256File(const char *path, uint8_t destHash[32])
+{
+	sha256_ctx_t sc;
+	struct stat st;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		return -1;
+	}
 	sha256_init(&sc);
-	sha256_update(&sc,input,size);
-	sha256_finalize(&sc,destHash);
+
+	// Regular files are mapped and hashed in chunks, so only the touched pages are resident
+	if (S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		size_t size = (size_t) st.st_size;
+		const uint8_t *map = (const uint8_t *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED)
+		{
+			size_t done = 0;
+			madvise((void *) map, size, MADV_SEQUENTIAL);
+			while (done < size)
+			{
+				size_t chunk = size - done;
+				if (chunk > SHA256_FILE_CHUNK)
+					chunk = SHA256_FILE_CHUNK;
+				sha256_update(&sc, map + done, (uint32_t) chunk);
+				madvise((void *) (map + done), chunk, MADV_DONTNEED);
+				done += chunk;
+			}
+			munmap((void *) map, size);
+			close(fd);
+			sha256_finalize(&sc, destHash);
+			return 0;
+		}
+	}
+
+	// Pipes, empty files or failed mappings fall back to read()
+	{
+		uint8_t buf[65536];
+		ssize_t got;
+		while ((got = read(fd, buf, sizeof(buf))) > 0)
+			sha256_update(&sc, buf, (uint32_t) got);
+		close(fd);
+		if (got < 0)
+			return -1;
+	}
+	sha256_finalize(&sc, destHash);
+	return 0;
+}
+
+int sha256_kernel_count(void)
+{
+	return KERNELS;
+}
+
+const char *sha256_kernel_name(int kernel)
+{
+	return kernel >= 0 && kernel < KERNELS ? kernels[kernel].name : NULL;
+}
+
+int sha256_kernel_find(const char *name)
+{
+	for (int i = 0; i < KERNELS; i++)
+		if (strcmp(kernels[i].name, name) == 0)
+			return i;
+	return -1;
+}
+
+// The kernel has to run here and give the right digest of "abc"
+int sha256_kernel_usable(int kernel)
+{
+	static const uint8_t abc[32] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+	};
+	if (kernel < 0 || kernel >= KERNELS || !kernels[kernel].available())
+		return 0;
+	sha256_guts_t saved = SHA256Guts;
+	uint8_t hash[32];
+	SHA256Guts = kernels[kernel].guts;
+	sha256_kernel_hash("abc", 3, hash);
+	SHA256Guts = saved;
+	return memcmp(hash, abc, 32) == 0;
+}
+
+int sha256_kernel_select(int kernel)
+{
+	if (!sha256_kernel_usable(kernel))
+		return -1;
+	SHA256Guts = kernels[kernel].guts;
+	currentKernel = kernel;
+	return 0;
+}
+
+int sha256_kernel_current(void)
+{
+	return currentKernel;
+}
+
+// Identifies the processor a cached choice was made on
+static void cpuSignature(char *sig, size_t len)
+{
+	snprintf(sig, len, "unknown");
+#if defined(__x86_64__) || defined(__i386__)
+	unsigned int regs[12];
+	if (__get_cpuid(0x80000004, &regs[0], &regs[1], &regs[2], &regs[3]))
+	{
+		for (unsigned int i = 0; i < 3; i++)
+			__get_cpuid(0x80000002 + i, &regs[4 * i], &regs[4 * i + 1], &regs[4 * i + 2], &regs[4 * i + 3]);
+		char brand[49];
+		memcpy(brand, regs, 48);
+		brand[48] = 0;
+		unsigned int a = 0, b, c, d;
+		__get_cpuid(1, &a, &b, &c, &d);
+		snprintf(sig, len, "%08x-", a);
+		for (size_t i = 0, j = strlen(sig); brand[i] && j + 1 < len; i++)
+			if (brand[i] != ' ')
+				sig[j++] = brand[i], sig[j] = 0;
+	}
+#endif
 }
 
+static double nowSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int sha256_autotune(const char *cacheFile)
+{
+	char sig[96], line[160], name[32];
+	cpuSignature(sig, sizeof(sig));
+
+	// A forced kernel wins, then a choice cached for this processor
+	const char *forced = getenv("CHAINWALLET_SHA256_KERNEL");
+	if (forced && sha256_kernel_select(sha256_kernel_find(forced)) == 0)
+		return currentKernel;
+	FILE *f = cacheFile ? fopen(cacheFile, "r") : NULL;
+	if (f)
+	{
+		char cached[96];
+		int ok = fgets(line, sizeof(line), f) && sscanf(line, "%95s %31s", cached, name) == 2 && strcmp(cached, sig) == 0;
+		fclose(f);
+		if (ok && sha256_kernel_select(sha256_kernel_find(name)) == 0)
+			return currentKernel;
+	}
+
+	// Best of three runs of the chain step (one 32 byte message) per kernel
+	int best = currentKernel;
+	double bestTime = 1e30;
+	uint8_t hash[32] = {0};
+	for (int k = 0; k < KERNELS; k++)
+	{
+		if (sha256_kernel_select(k) != 0)
+			continue;
+		double t = 1e30;
+		for (int run = 0; run < 3; run++)
+		{
+			double start = nowSeconds();
+			for (int i = 0; i < 4096; i++)
+				sha256_kernel_hash(hash, 32, hash);
+			double elapsed = nowSeconds() - start;
+			if (elapsed < t)
+				t = elapsed;
+		}
+		if (t < bestTime)
+		{
+			bestTime = t;
+			best = k;
+		}
+	}
+	sha256_kernel_select(best);
+
+	f = cacheFile ? fopen(cacheFile, "w") : NULL;
+	if (f)
+	{
+		fprintf(f, "%s %s\n", sig, kernels[best].name);
+		fclose(f);
+	}
+	return best;
+}
@@ -13,8 +13,75 @@
 
 #include <stdint.h>	// Include stdint.h; available on most compilers but, if not, a copy is provided here for Microsoft Visual Studio
 
+#define SHA256_HASH_SIZE  32	/* 256 bit */
+#define SHA256_HASH_WORDS 8
+#define SHA256_BLOCK_SIZE 64
+
+// Streaming context. It is a plain struct, so a midstate can be cloned by simple assignment
+// (or sha256_copy) and reused for every message sharing the same prefix.
+typedef struct 
+{
+	uint64_t totalLength;
+	uint32_t hash[SHA256_HASH_WORDS];
+	uint32_t bufferLength;
+	union 
+	{
+		uint32_t words[16];
+		uint8_t bytes[64];
+	} buffer;
+} sha256_ctx_t;
+
+void sha256_init(sha256_ctx_t * sc);
+void sha256_update(sha256_ctx_t * sc, const void *data, uint32_t len);
+void sha256_finalize(sha256_ctx_t * sc, uint8_t hash[SHA256_HASH_SIZE]);
+
+// Copy a context (midstate) so the original can keep being used
+void sha256_copy(sha256_ctx_t * dst, const sha256_ctx_t * src);
+
+// Export/import the chaining value of a context that has consumed a whole number of blocks.
+// This is the compact form of a precomputed prefix (e.g. HMAC pads or tagged hash prefixes).
+// sha256_get_midstate returns 0 if the context still has buffered bytes.
+int  sha256_get_midstate(const sha256_ctx_t * sc, uint32_t state[SHA256_HASH_WORDS], uint64_t * bytes);
+void sha256_set_midstate(sha256_ctx_t * sc, const uint32_t state[SHA256_HASH_WORDS], uint64_t bytes);
+
+// Context initialized with the BIP340 tagged hash prefix sha256(tag) || sha256(tag)
+void sha256_init_tagged(sha256_ctx_t * sc, const void *tag, uint32_t tagLen);
+
+// Precomputed HMAC-SHA256 key: inner and outer pad midstates
+typedef struct
+{
+	sha256_ctx_t inner;
+	sha256_ctx_t outer;
+} hmac_sha256_key_t;
+
+void hmac_sha256_init(hmac_sha256_key_t * key, const void *secret, uint32_t len);
+void hmac_sha256(const hmac_sha256_key_t * key, const void *data, uint32_t len, uint8_t mac[SHA256_HASH_SIZE]);
+
+// One-shot hash with the selected hash backend (see HashBackend.h)
 void computeSHA256(const void *input,		// A pointer to the input data to have the SHA256 hash computed for it.
 				   uint32_t size,			// the length of the input data
 				   uint8_t destHash[32]);	// The output 256 bit (32 byte) hash
 
+// One-shot hash with the selected kernel, and with the portable unroll-64 kernel whatever is selected
+void sha256_kernel_hash(const void *input, uint32_t size, uint8_t destHash[32]);
+void sha256_reference_hash(const void *input, uint32_t size, uint8_t destHash[32]);
+
+// Hash a whole file in constant memory (mmap when possible, chunked reads otherwise).
+// Returns 0 on success and -1 if the file could not be read.
+int computeSHA256File(const char *path, uint8_t destHash[32]);
+
+// Compression kernels compiled into the binary: every SHA256_UNROLL value and, on x86, rorx (BMI2)
+// and the SHA extensions. They give the same digests; only the speed differs.
+int sha256_kernel_count(void);
+const char *sha256_kernel_name(int kernel);
+int sha256_kernel_find(const char *name);		// -1 if unknown
+int sha256_kernel_usable(int kernel);			// Supported by this CPU and self-tested
+int sha256_kernel_select(int kernel);			// 0, or -1 if not usable. Not thread safe.
+int sha256_kernel_current(void);
+
+// Time every usable kernel on the chain step and select the fastest. The choice is cached in cacheFile
+// (may be NULL) together with the processor it was made on, so later runs only read it. The
+// CHAINWALLET_SHA256_KERNEL environment variable forces a kernel by name. Returns the kernel selected.
+int sha256_autotune(const char *cacheFile);
+
 #endif
@@ -0,0 +1,207 @@
+// Body of the SHA-256 compression function, included by SHA256.cpp once per kernel.
+// Define SHA256_UNROLL (1, 2, 4, 8, 16, 32 or 64), SHA256_GUTS_NAME and SHA256_GUTS_ATTR before including it.
+// There is no include guard on purpose.
+
+SHA256_GUTS_ATTR static void SHA256_GUTS_NAME(sha256_ctx_t * sc, const uint32_t * cbuf)
+{
+	uint32_t buf[64];
+	uint32_t *W, *W2, *W7, *W15, *W16;
+	uint32_t a, b, c, d, e, f, g, h;
+	uint32_t t1, t2;
+	const uint32_t *Kp;
+	int i;
+
+	W = buf;
+
+	for (i = 15; i >= 0; i--) 
+	{
+		*(W++) = BYTESWAP(*cbuf);
+		cbuf++;
+	}
+
+	W16 = &buf[0];
+	W15 = &buf[1];
+	W7 = &buf[9];
+	W2 = &buf[14];
+
+	for (i = 47; i >= 0; i--) 
+	{
+		*(W++) = sigma1(*W2) + *(W7++) + sigma0(*W15) + *(W16++);
+		W2++;
+		W15++;
+	}
+
+	a = sc->hash[0];
+	b = sc->hash[1];
+	c = sc->hash[2];
+	d = sc->hash[3];
+	e = sc->hash[4];
+	f = sc->hash[5];
+	g = sc->hash[6];
+	h = sc->hash[7];
+
+	Kp = K;
+	W = buf;
+
+#if SHA256_UNROLL == 1
+	for (i = 63; i >= 0; i--)
+		DO_ROUND();
+#elif SHA256_UNROLL == 2
+	for (i = 31; i >= 0; i--) {
+		DO_ROUND();
+		DO_ROUND();
+	}
+#elif SHA256_UNROLL == 4
+	for (i = 15; i >= 0; i--) {
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+	}
+#elif SHA256_UNROLL == 8
+	for (i = 7; i >= 0; i--) {
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+	}
+#elif SHA256_UNROLL == 16
+	for (i = 3; i >= 0; i--) {
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+	}
+#elif SHA256_UNROLL == 32
+	for (i = 1; i >= 0; i--) {
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+		DO_ROUND();
+	}
+#elif SHA256_UNROLL == 64
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+	DO_ROUND();
+#else
+#error "SHA256_UNROLL must be 1, 2, 4, 8, 16, 32, or 64!"
+#endif
+
+	sc->hash[0] += a;
+	sc->hash[1] += b;
+	sc->hash[2] += c;
+	sc->hash[3] += d;
+	sc->hash[4] += e;
+	sc->hash[5] += f;
+	sc->hash[6] += g;
+	sc->hash[7] += h;
+}
+
+#undef SHA256_UNROLL
+#undef SHA256_GUTS_NAME
+#undef SHA256_GUTS_ATTR
@@ -87,10 +87,7 @@ public:
    */
   void clear()
   {
-    sum_[0] = 0x6a09e667f3bcc908; sum_[1] = 0xbb67ae8584caa73b;
-    sum_[2] = 0x3c6ef372fe94f82b; sum_[3] = 0xa54ff53a5f1d36f1;
-    sum_[4] = 0x510e527fade682d1; sum_[5] = 0x9b05688c2b3e6c1f;
-    sum_[6] = 0x1f83d9abfb41bd6b; sum_[7] = 0x5be0cd19137e2179;
+    memcpy(sum_, iv_, sizeof(sum_));
     sz_ = 0; iterations_ = 0; memset(&block_, 0, sizeof(block_));
   }
 
@@ -149,6 +146,82 @@ public:
     #undef U32_B
   }
 
+  /**
+   * Finalise checksum into a raw 64 byte digest.
+   * @param uint8_t *out
+   */
+  void final_bytes(uint8_t *out)
+  {
+    unsigned nb, n;
+    uint64_t n_total;
+    nb = 1 + ((0x80-17) < (sz_ & 0x7f));
+    n_total = (iterations_ + sz_) << 3;
+    n = nb << 7;
+    memset(block_ + sz_, 0, n - sz_);
+    block_[sz_] = 0x80;
+    for (unsigned i = 0; i < 8; ++i) block_[n-1-i] = (uint8_t)(n_total >> (i << 3));
+    transform(block_, nb);
+    for (unsigned i = 0; i < 64; ++i) out[i] = (uint8_t)(sum_[i >> 3] >> ((7 - (i & 7)) << 3));
+    clear();
+  }
+
+  /**
+   * Chaining value after the blocks pushed so far (only meaningful on block
+   * boundaries, e.g. after an HMAC pad).
+   * @return const uint64_t*
+   */
+  const uint64_t* state() const
+  { return sum_; }
+
+  /**
+   * Initial hash value.
+   * @return const uint64_t*
+   */
+  static const uint64_t* iv()
+  { return iv_; }
+
+  /**
+   * Round constants.
+   * @return const uint64_t*
+   */
+  static const uint64_t* constants()
+  { return lut_; }
+
+  /**
+   * One compression of an already decoded (host order) 16 word block into
+   * sum. Used by constructions that keep their own midstates (HMAC, PBKDF2).
+   * @param uint64_t *sum
+   * @param const uint64_t *block
+   */
+  static void compress(uint64_t *sum, const uint64_t *block)
+  {
+    #define RR(x, n) ((x >> n) | (x << (64 - n)))
+    #define CH(x, y, z)  ((x & y) ^ (~x & z))
+    #define MJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
+    #define F1(x) (RR(x, 28) ^ RR(x, 34) ^ RR(x, 39))
+    #define F2(x) (RR(x, 14) ^ RR(x, 18) ^ RR(x, 41))
+    #define F3(x) (RR(x,  1) ^ RR(x,  8) ^ (x >> 7))
+    #define F4(x) (RR(x, 19) ^ RR(x, 61) ^ (x >> 6))
+    uint64_t t, u, v[8], w[80];
+    unsigned j;
+    for(j = 0; j < 16; ++j) w[j] = block[j];
+    for(j = 16; j < 80; ++j) w[j] = F4(w[j-2]) + w[j-7] + F3(w[j-15]) + w[j-16];
+    for(j = 0; j < 8; ++j) v[j] = sum[j];
+    for(j = 0; j < 80; ++j) {
+      t = v[7] + F2(v[4]) + CH(v[4], v[5], v[6]) + lut_[j] + w[j];
+      u = F1(v[0]) + MJ(v[0], v[1], v[2]); v[7] = v[6]; v[6] = v[5]; v[5] = v[4];
+      v[4] = v[3] + t; v[3] = v[2]; v[2] = v[1]; v[1] = v[0]; v[0] = t + u;
+    }
+    for(j = 0; j < 8; ++j) sum[j] += v[j];
+    #undef RR
+    #undef CH
+    #undef MJ
+    #undef F1
+    #undef F2
+    #undef F3
+    #undef F4
+  }
+
 public:
 
   /**
@@ -263,6 +336,13 @@ private:
   unsigned sz_;         // Number of currently stored bytes in the block
   uint8_t  block_[256];
   static const uint64_t lut_[80]; // Lookup table
+  static const uint64_t iv_[8];   // Initial hash value
+};
+
+template <typename CT>
+const uint64_t basic_sha512<CT>::iv_[8] = {
+  0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+  0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
 };
 
 template <typename CT>
@@ -0,0 +1,602 @@
+// secp256k1 field and group arithmetic on 4x64 bit limbs
+#include "Secp256k1.h"
+#include <gmp.h>
+#include <string.h>
+#include <vector>
+using namespace std;
+
+typedef unsigned __int128 u128;
+
+// Field element mod P = 2^256 - 2^32 - 977, little endian limbs, always fully reduced
+struct fe
+{
+	uint64_t n[4];
+};
+
+// Point in affine and in Jacobian (X/Z^2, Y/Z^3) coordinates
+struct ge
+{
+	fe x, y;
+	bool inf;
+};
+
+struct gej
+{
+	fe x, y, z;
+	bool inf;
+};
+
+static const uint64_t C = 0x1000003D1ULL; // 2^256 mod P
+static const fe P = {{0xFFFFFFFEFFFFFC2FULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL}};
+static const uint64_t N[4] = {0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL};
+static const fe Gx = {{0x59F2815B16F81798ULL, 0x029BFCDB2DCE28D9ULL, 0x55A06295CE870B07ULL, 0x79BE667EF9DCBBACULL}};
+static const fe Gy = {{0x9C47D08FFB10D4B8ULL, 0xFD17B448A6855419ULL, 0x5DA4FBFC0E1108A8ULL, 0x483ADA7726A3C465ULL}};
+
+static inline void feSet(fe &r, uint64_t v)
+{
+	r.n[0] = v;
+	r.n[1] = r.n[2] = r.n[3] = 0;
+}
+
+static inline bool feIsZero(const fe &a)
+{
+	return (a.n[0] | a.n[1] | a.n[2] | a.n[3]) == 0;
+}
+
+static inline bool feEqual(const fe &a, const fe &b)
+{
+	return ((a.n[0] ^ b.n[0]) | (a.n[1] ^ b.n[1]) | (a.n[2] ^ b.n[2]) | (a.n[3] ^ b.n[3])) == 0;
+}
+
+// Reduce a value below 2^256 that may still be >= P
+static inline void feNormalize(fe &r)
+{
+	// r >= P  <=>  r + C overflows 2^256
+	u128 c = (u128)r.n[0] + C;
+	uint64_t t0 = (uint64_t)c;
+	c = (c >> 64) + r.n[1];
+	uint64_t t1 = (uint64_t)c;
+	c = (c >> 64) + r.n[2];
+	uint64_t t2 = (uint64_t)c;
+	c = (c >> 64) + r.n[3];
+	uint64_t t3 = (uint64_t)c;
+	if (c >> 64)
+	{
+		r.n[0] = t0;
+		r.n[1] = t1;
+		r.n[2] = t2;
+		r.n[3] = t3;
+	}
+}
+
+static inline void feAdd(fe &r, const fe &a, const fe &b)
+{
+	u128 c = 0;
+	for (int i=0; i<4; i++)
+	{
+		c += (u128)a.n[i] + b.n[i];
+		r.n[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	// An overflow of 2^256 is worth C
+	if (c)
+	{
+		c = C;
+		for (int i=0; i<4 && c; i++)
+		{
+			c += r.n[i];
+			r.n[i] = (uint64_t)c;
+			c >>= 64;
+		}
+	}
+	feNormalize(r);
+}
+
+static inline void feSub(fe &r, const fe &a, const fe &b)
+{
+	uint64_t borrow = 0;
+	for (int i=0; i<4; i++)
+	{
+		u128 d = (u128)a.n[i] - b.n[i] - borrow;
+		r.n[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	// Wrapped around 2^256: add P back, i.e. subtract C
+	if (borrow)
+	{
+		borrow = 0;
+		uint64_t sub = C;
+		for (int i=0; i<4; i++)
+		{
+			u128 d = (u128)r.n[i] - sub - borrow;
+			r.n[i] = (uint64_t)d;
+			borrow = (uint64_t)(d >> 64) & 1;
+			sub = 0;
+		}
+	}
+}
+
+static inline void feNeg(fe &r, const fe &a)
+{
+	fe zero;
+	feSet(zero, 0);
+	feSub(r, zero, a);
+}
+
+// 512 bit product folded twice with 2^256 = C
+static inline void feMul(fe &r, const fe &a, const fe &b)
+{
+	const uint64_t *x = a.n, *y = b.n;
+	uint64_t t[8];
+	u128 c;
+
+	// Schoolbook rows, written out so the compiler keeps everything in registers
+	c = (u128)x[0]*y[0];                  t[0] = (uint64_t)c; c >>= 64;
+	c += (u128)x[0]*y[1];                 t[1] = (uint64_t)c; c >>= 64;
+	c += (u128)x[0]*y[2];                 t[2] = (uint64_t)c; c >>= 64;
+	c += (u128)x[0]*y[3];                 t[3] = (uint64_t)c; t[4] = (uint64_t)(c >> 64);
+	c = (u128)x[1]*y[0] + t[1];           t[1] = (uint64_t)c; c >>= 64;
+	c += (u128)x[1]*y[1] + t[2];          t[2] = (uint64_t)c; c >>= 64;
+	c += (u128)x[1]*y[2] + t[3];          t[3] = (uint64_t)c; c >>= 64;
+	c += (u128)x[1]*y[3] + t[4];          t[4] = (uint64_t)c; t[5] = (uint64_t)(c >> 64);
+	c = (u128)x[2]*y[0] + t[2];           t[2] = (uint64_t)c; c >>= 64;
+	c += (u128)x[2]*y[1] + t[3];          t[3] = (uint64_t)c; c >>= 64;
+	c += (u128)x[2]*y[2] + t[4];          t[4] = (uint64_t)c; c >>= 64;
+	c += (u128)x[2]*y[3] + t[5];          t[5] = (uint64_t)c; t[6] = (uint64_t)(c >> 64);
+	c = (u128)x[3]*y[0] + t[3];           t[3] = (uint64_t)c; c >>= 64;
+	c += (u128)x[3]*y[1] + t[4];          t[4] = (uint64_t)c; c >>= 64;
+	c += (u128)x[3]*y[2] + t[5];          t[5] = (uint64_t)c; c >>= 64;
+	c += (u128)x[3]*y[3] + t[6];          t[6] = (uint64_t)c; t[7] = (uint64_t)(c >> 64);
+
+	// First fold: low + high * C, leaves a top limb below 2^34
+	uint64_t l0, l1, l2, l3, top;
+	c = (u128)t[4]*C + t[0];              l0 = (uint64_t)c; c >>= 64;
+	c += (u128)t[5]*C + t[1];             l1 = (uint64_t)c; c >>= 64;
+	c += (u128)t[6]*C + t[2];             l2 = (uint64_t)c; c >>= 64;
+	c += (u128)t[7]*C + t[3];             l3 = (uint64_t)c; top = (uint64_t)(c >> 64);
+
+	// Second fold; a final carry is worth C again and cannot carry further
+	c = (u128)top*C + l0;                 r.n[0] = (uint64_t)c; c >>= 64;
+	c += l1;                              r.n[1] = (uint64_t)c; c >>= 64;
+	c += l2;                              r.n[2] = (uint64_t)c; c >>= 64;
+	c += l3;                              r.n[3] = (uint64_t)c; c >>= 64;
+	if (c)
+	{
+		c = (u128)r.n[0] + C;             r.n[0] = (uint64_t)c; c >>= 64;
+		c += r.n[1];                      r.n[1] = (uint64_t)c; c >>= 64;
+		c += r.n[2];                      r.n[2] = (uint64_t)c; c >>= 64;
+		r.n[3] += (uint64_t)c;
+	}
+	feNormalize(r);
+}
+
+static inline void feSqr(fe &r, const fe &a)
+{
+	feMul(r, a, a);
+}
+
+static inline void feMulInt(fe &r, const fe &a, int k)
+{
+	fe t = a;
+	feSet(r, 0);
+	for (int i=0; i<k; i++)
+		feAdd(r, r, t);
+}
+
+// a^e for a 256 bit exponent given as limbs
+static void fePow(fe &r, const fe &a, const uint64_t e[4])
+{
+	fe acc;
+	feSet(acc, 1);
+	for (int i=255; i>=0; i--)
+	{
+		feSqr(acc, acc);
+		if ((e[i/64] >> (i%64)) & 1)
+			feMul(acc, acc, a);
+	}
+	r = acc;
+}
+
+// GMP does the single inversion of a batch
+static void feInv(fe &r, const fe &a)
+{
+	mpz_t x, p;
+	mpz_init(x);
+	mpz_init(p);
+	mpz_import(x, 4, -1, sizeof(uint64_t), 0, 0, a.n);
+	mpz_import(p, 4, -1, sizeof(uint64_t), 0, 0, P.n);
+	mpz_invert(x, x, p);
+	feSet(r, 0);
+	mpz_export(r.n, NULL, -1, sizeof(uint64_t), 0, 0, x);
+	mpz_clear(x);
+	mpz_clear(p);
+}
+
+// Square root for P = 3 mod 4: a^((P+1)/4). Returns false if a is not a square.
+static bool feSqrt(fe &r, const fe &a)
+{
+	static const uint64_t e[4] = {0xFFFFFFFFBFFFFF0CULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x3FFFFFFFFFFFFFFFULL};
+	fe s, check;
+	fePow(s, a, e);
+	feSqr(check, s);
+	if (!feEqual(check, a))
+		return false;
+	r = s;
+	return true;
+}
+
+static void feFromBytes(fe &r, const uint8_t b[32])
+{
+	for (int i=0; i<4; i++)
+	{
+		uint64_t v = 0;
+		for (int j=0; j<8; j++)
+			v = (v << 8) | b[(3-i)*8 + j];
+		r.n[i] = v;
+	}
+}
+
+static void feToBytes(uint8_t b[32], const fe &a)
+{
+	for (int i=0; i<4; i++)
+	{
+		uint64_t v = a.n[i];
+		for (int j=7; j>=0; j--)
+		{
+			b[(3-i)*8 + j] = (uint8_t)v;
+			v >>= 8;
+		}
+	}
+}
+
+// Less than the modulus given as limbs
+static bool lessThan(const fe &a, const uint64_t m[4])
+{
+	for (int i=3; i>=0; i--)
+	{
+		if (a.n[i] != m[i])
+			return a.n[i] < m[i];
+	}
+	return false;
+}
+
+// Doubling, dbl-2009-l
+static void gejDouble(gej &r, const gej &a)
+{
+	if (a.inf || feIsZero(a.y))
+	{
+		r.inf = true;
+		return;
+	}
+	fe A, B, Cc, D, E, F, t;
+	feSqr(A, a.x);
+	feSqr(B, a.y);
+	feSqr(Cc, B);
+	feAdd(t, a.x, B);
+	feSqr(t, t);
+	feSub(t, t, A);
+	feSub(t, t, Cc);
+	feAdd(D, t, t);
+	feMulInt(E, A, 3);
+	feSqr(F, E);
+	fe x3, y3, z3;
+	feSub(x3, F, D);
+	feSub(x3, x3, D);
+	feSub(t, D, x3);
+	feMul(y3, E, t);
+	feMulInt(t, Cc, 8);
+	feSub(y3, y3, t);
+	feMul(z3, a.y, a.z);
+	feAdd(z3, z3, z3);
+	r.x = x3;
+	r.y = y3;
+	r.z = z3;
+	r.inf = false;
+}
+
+// Jacobian plus affine, madd-2007-bl
+static void gejAddGe(gej &r, const gej &a, const ge &b)
+{
+	if (b.inf)
+	{
+		r = a;
+		return;
+	}
+	if (a.inf)
+	{
+		r.x = b.x;
+		r.y = b.y;
+		feSet(r.z, 1);
+		r.inf = false;
+		return;
+	}
+	fe Z1Z1, U2, S2, H, HH, I, J, rr, V, t;
+	feSqr(Z1Z1, a.z);
+	feMul(U2, b.x, Z1Z1);
+	feMul(S2, b.y, a.z);
+	feMul(S2, S2, Z1Z1);
+	feSub(H, U2, a.x);
+	feSub(rr, S2, a.y);
+	if (feIsZero(H))
+	{
+		if (feIsZero(rr))
+			gejDouble(r, a);
+		else
+			r.inf = true;
+		return;
+	}
+	feAdd(rr, rr, rr);
+	feSqr(HH, H);
+	feAdd(I, HH, HH);
+	feAdd(I, I, I);
+	feMul(J, H, I);
+	feMul(V, a.x, I);
+	fe x3, y3, z3;
+	feSqr(x3, rr);
+	feSub(x3, x3, J);
+	feSub(x3, x3, V);
+	feSub(x3, x3, V);
+	feSub(t, V, x3);
+	feMul(y3, rr, t);
+	feMul(t, a.y, J);
+	feAdd(t, t, t);
+	feSub(y3, y3, t);
+	feAdd(z3, a.z, H);
+	feSqr(z3, z3);
+	feSub(z3, z3, Z1Z1);
+	feSub(z3, z3, HH);
+	r.x = x3;
+	r.y = y3;
+	r.z = z3;
+	r.inf = false;
+}
+
+// Convert many Jacobian points to affine with one inversion (Montgomery's trick)
+static void gejToGeBatch(const gej *a, ge *r, size_t count)
+{
+	vector<fe> prefix(count);
+	fe acc;
+	feSet(acc, 1);
+	for (size_t i=0; i<count; i++)
+	{
+		prefix[i] = acc;
+		if (!a[i].inf)
+			feMul(acc, acc, a[i].z);
+	}
+	fe inv;
+	feInv(inv, acc);
+	for (size_t i=count; i-- > 0;)
+	{
+		if (a[i].inf)
+		{
+			r[i].inf = true;
+			continue;
+		}
+		fe zInv, zInv2, zInv3;
+		feMul(zInv, inv, prefix[i]);
+		feMul(inv, inv, a[i].z);
+		feSqr(zInv2, zInv);
+		feMul(zInv3, zInv2, zInv);
+		feMul(r[i].x, a[i].x, zInv2);
+		feMul(r[i].y, a[i].y, zInv3);
+		r[i].inf = false;
+	}
+}
+
+// table[w][j] = (j + 1) * 16^w * G, for 64 windows of 4 bits, and offset = -(sum of 16^w * G).
+// With every digit shifted by one each window adds a real point, so no step depends on a digit being zero.
+struct GTable
+{
+	vector<ge> points;
+	ge offset;
+	GTable() : points(64 * 16)
+	{
+		vector<gej> jac(64 * 16);
+		ge base;
+		base.x = Gx;
+		base.y = Gy;
+		base.inf = false;
+		gej sum;
+		sum.inf = true;
+		for (int w=0; w<64; w++)
+		{
+			gejAddGe(sum, sum, base);
+			gej acc;
+			acc.inf = true;
+			for (int j=0; j<16; j++)
+			{
+				gejAddGe(acc, acc, base);
+				jac[w*16 + j] = acc;
+			}
+			// 16 * base for the next window
+			gejToGeBatch(&acc, &base, 1);
+		}
+		gejToGeBatch(jac.data(), points.data(), jac.size());
+		gejToGeBatch(&sum, &offset, 1);
+		feNeg(offset.y, offset.y);
+	}
+};
+
+static const GTable &gTable()
+{
+	static const GTable table;
+	return table;
+}
+
+// p = table[w][digit], reading all 16 entries so the memory access does not depend on the digit
+static void gTableSelect(ge &p, const GTable &t, int w, unsigned digit)
+{
+	memset(&p, 0, sizeof(p));
+	for (unsigned j=0; j<16; j++)
+	{
+		uint64_t mask = (uint64_t)0 - (uint64_t)(((j ^ digit) - 1) >> 31 & 1);
+		const ge &e = t.points[w*16 + j];
+		for (int k=0; k<4; k++)
+		{
+			p.x.n[k] |= e.x.n[k] & mask;
+			p.y.n[k] |= e.y.n[k] & mask;
+		}
+	}
+}
+
+// sk * G in Jacobian coordinates, in constant time: the same 64 table scans and mixed additions for
+// every key. The exceptional cases of the addition (a partial sum equal to plus or minus the point
+// added) need a key built for it and are as likely as guessing one.
+static void mulG(gej &r, const uint8_t sk[32])
+{
+	const GTable &t = gTable();
+	r.x = t.offset.x;
+	r.y = t.offset.y;
+	feSet(r.z, 1);
+	r.inf = false;
+	for (int w=0; w<64; w++)
+	{
+		uint8_t b = sk[31 - w / 2];
+		ge p;
+		gTableSelect(p, t, w, w & 1 ? b >> 4 : b & 15);
+		gejAddGe(r, r, p);
+	}
+}
+
+static void geToCompressed(uint8_t pub[33], const ge &p)
+{
+	pub[0] = (p.y.n[0] & 1) ? 0x03 : 0x02;
+	feToBytes(pub + 1, p.x);
+}
+
+static bool geFromCompressed(ge &p, const uint8_t pub[33])
+{
+	if (pub[0] != 0x02 && pub[0] != 0x03)
+		return false;
+	feFromBytes(p.x, pub + 1);
+	if (!lessThan(p.x, P.n))
+		return false;
+	fe y2, seven;
+	feSqr(y2, p.x);
+	feMul(y2, y2, p.x);
+	feSet(seven, 7);
+	feAdd(y2, y2, seven);
+	if (!feSqrt(p.y, y2))
+		return false;
+	if ((p.y.n[0] & 1) != (uint64_t)(pub[0] & 1))
+		feNeg(p.y, p.y);
+	p.inf = false;
+	return true;
+}
+
+bool ecSeckeyValid(const uint8_t sk[32])
+{
+	fe k;
+	feFromBytes(k, sk);
+	return !feIsZero(k) && lessThan(k, N);
+}
+
+bool ecSeckeyTweakAdd(uint8_t sk[32], const uint8_t tweak[32])
+{
+	fe k, t;
+	feFromBytes(k, sk);
+	feFromBytes(t, tweak);
+	if (!lessThan(t, N))
+		return false;
+	u128 c = 0;
+	uint64_t s[4];
+	for (int i=0; i<4; i++)
+	{
+		c += (u128)k.n[i] + t.n[i];
+		s[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	// Both inputs are below N, so one subtraction is enough
+	fe sum;
+	memcpy(sum.n, s, sizeof(s));
+	if (c || !lessThan(sum, N))
+	{
+		uint64_t borrow = 0;
+		for (int i=0; i<4; i++)
+		{
+			u128 d = (u128)sum.n[i] - N[i] - borrow;
+			sum.n[i] = (uint64_t)d;
+			borrow = (uint64_t)(d >> 64) & 1;
+		}
+	}
+	if (feIsZero(sum))
+		return false;
+	feToBytes(sk, sum);
+	return true;
+}
+
+bool ecPubkey(const uint8_t sk[32], uint8_t pub[33])
+{
+	return ecPubkeyBatch((const uint8_t (*)[32])sk, 1, (uint8_t (*)[33])pub);
+}
+
+bool ecPubkeyUncompressed(const uint8_t sk[32], uint8_t pub[65])
+{
+	if (!ecSeckeyValid(sk))
+		return false;
+	gej r;
+	ge a;
+	mulG(r, sk);
+	gejToGeBatch(&r, &a, 1);
+	pub[0] = 0x04;
+	feToBytes(pub + 1, a.x);
+	feToBytes(pub + 33, a.y);
+	return true;
+}
+
+bool ecPubkeyBatch(const uint8_t (*sk)[32], size_t count, uint8_t (*pub)[33])
+{
+	vector<gej> jac(count);
+	vector<ge> aff(count);
+	for (size_t i=0; i<count; i++)
+	{
+		if (!ecSeckeyValid(sk[i]))
+			return false;
+		mulG(jac[i], sk[i]);
+	}
+	gejToGeBatch(jac.data(), aff.data(), count);
+	for (size_t i=0; i<count; i++)
+		geToCompressed(pub[i], aff[i]);
+	return true;
+}
+
+bool ecPubkeyTweakAddBatch(const uint8_t parent[33], const uint8_t (*tweak)[32], size_t count, uint8_t (*out)[33])
+{
+	ge base;
+	if (!geFromCompressed(base, parent))
+		return false;
+	vector<gej> jac(count);
+	vector<ge> aff(count);
+	for (size_t i=0; i<count; i++)
+	{
+		fe t;
+		feFromBytes(t, tweak[i]);
+		if (!lessThan(t, N))
+			return false;
+		mulG(jac[i], tweak[i]);
+		gejAddGe(jac[i], jac[i], base);
+		if (jac[i].inf)
+			return false;
+	}
+	gejToGeBatch(jac.data(), aff.data(), count);
+	for (size_t i=0; i<count; i++)
+		geToCompressed(out[i], aff[i]);
+	return true;
+}
+
+bool ecPubkeyDecompress(const uint8_t pub[33], uint8_t out[65])
+{
+	ge p;
+	if (!geFromCompressed(p, pub))
+		return false;
+	out[0] = 0x04;
+	feToBytes(out + 1, p.x);
+	feToBytes(out + 33, p.y);
+	return true;
+}
+
+void ecPubkeyCompress(const uint8_t pub[65], uint8_t out[33])
+{
+	out[0] = (pub[64] & 1) ? 0x03 : 0x02;
+	memcpy(out + 1, pub + 1, 32);
+}
@@ -0,0 +1,39 @@
+#ifndef SECP256K1_H
+
+#define SECP256K1_H
+
+// Arithmetic on the secp256k1 curve with fixed 4x64 bit limbs.
+//
+// This is the fast path used by HD derivation and verification. Points are kept in Jacobian coordinates
+// and multiples of G come from a precomputed table with 4 bit windows, so a public key costs 64 mixed
+// additions and batches of keys share a single field inversion. Multiplying G by a secret scans whole
+// table rows and runs the same additions for every key, so its timing does not depend on the key; the
+// final inversion and the encodings are not constant time.
+//
+// Keys are 32 byte big endian scalars. Public keys are 33 byte compressed or 65 byte uncompressed.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Check 0 < sk < N
+bool ecSeckeyValid(const uint8_t sk[32]);
+
+// sk = (sk + tweak) mod N. Returns false if tweak >= N or the result is zero.
+bool ecSeckeyTweakAdd(uint8_t sk[32], const uint8_t tweak[32]);
+
+// sk * G
+bool ecPubkey(const uint8_t sk[32], uint8_t pub[33]);
+bool ecPubkeyUncompressed(const uint8_t sk[32], uint8_t pub[65]);
+
+// Public keys of many secret keys, normalized with one shared inversion
+bool ecPubkeyBatch(const uint8_t (*sk)[32], size_t count, uint8_t (*pub)[33]);
+
+// parent + tweak[i] * G for every tweak (BIP32 public child derivation), with one shared inversion.
+// Returns false if the parent does not decode, a tweak is >= N or a result is the point at infinity.
+bool ecPubkeyTweakAddBatch(const uint8_t parent[33], const uint8_t (*tweak)[32], size_t count, uint8_t (*out)[33]);
+
+// Compressed <-> uncompressed
+bool ecPubkeyDecompress(const uint8_t pub[33], uint8_t out[65]);
+void ecPubkeyCompress(const uint8_t pub[65], uint8_t out[33]);
+
+#endif
@@ -0,0 +1,162 @@
+// RSW time-lock puzzles
+#include "TimeLock.h"
+#include "SHA256.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/random.h>
+#include <vector>
+using namespace std;
+
+mpz_class timeLockBase(const uint8_t passwordHash[32], const mpz_class &modulus)
+{
+	// x = sha256("ChainWallet RSW" || sha256(password)) mod n, away from 0 and 1
+	sha256_ctx_t sc;
+	uint8_t h[32];
+	sha256_init(&sc);
+	sha256_update(&sc, "ChainWallet RSW", 15);
+	sha256_update(&sc, passwordHash, 32);
+	sha256_finalize(&sc, h);
+	mpz_class x;
+	mpz_import(x.get_mpz_t(), 32, 1, 1, 1, 0, h);
+	x = x % modulus;
+	if (x < 2)
+		x += 2;
+	return x;
+}
+
+// Fill buf from the kernel CSPRNG
+static void randomBytes(uint8_t *buf, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t n = getrandom(buf, len, 0);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			fprintf(stderr, "Unable to read random bytes: %s\n", strerror(errno));
+			exit(1);
+		}
+		buf += n;
+		len -= n;
+	}
+}
+
+// Random prime of the given size: every candidate comes straight from getrandom()
+static void randomPrime(mpz_class &p, int bits)
+{
+	vector<uint8_t> buf((bits + 7) / 8);
+	do
+	{
+		randomBytes(buf.data(), buf.size());
+		mpz_import(p.get_mpz_t(), buf.size(), 1, 1, 1, 0, buf.data());
+		mpz_fdiv_r_2exp(p.get_mpz_t(), p.get_mpz_t(), bits);
+		mpz_setbit(p.get_mpz_t(), bits - 1);
+		mpz_setbit(p.get_mpz_t(), bits - 2);	// Product keeps its full size
+		mpz_setbit(p.get_mpz_t(), 0);
+	}
+	while (mpz_probab_prime_p(p.get_mpz_t(), 40) == 0);
+	memset(buf.data(), 0, buf.size());
+}
+
+void timeLockCreate(const uint8_t passwordHash[32], const mpz_class &squarings, int bits,
+                    mpz_class &modulus, mpz_class &solution)
+{
+	mpz_class p, q;
+	do
+	{
+		randomPrime(p, bits / 2);
+		randomPrime(q, bits - bits / 2);
+	}
+	while (p == q);
+	modulus = p * q;
+
+	// Trapdoor: e = 2^T mod phi(n), y = x^e mod n
+	mpz_class phi = (p - 1) * (q - 1);
+	mpz_class e, two = 2;
+	mpz_powm(e.get_mpz_t(), two.get_mpz_t(), squarings.get_mpz_t(), phi.get_mpz_t());
+	mpz_class x = timeLockBase(passwordHash, modulus);
+	mpz_powm(solution.get_mpz_t(), x.get_mpz_t(), e.get_mpz_t(), modulus.get_mpz_t());
+	p = 0;
+	q = 0;
+	phi = 0;
+	e = 0;
+}
+
+void timeLockKey(const mpz_class &solution, const mpz_class &modulus, uint8_t key[32])
+{
+	// sha256 of y as a big endian number of the modulus size
+	size_t len = (mpz_sizeinbase(modulus.get_mpz_t(), 2) + 7) / 8;
+	vector<uint8_t> bytes(len, 0);
+	size_t count;
+	size_t used = (mpz_sizeinbase(solution.get_mpz_t(), 2) + 7) / 8;
+	if (solution != 0)
+		mpz_export(&bytes[len - used], &count, 1, 1, 1, 0, solution.get_mpz_t());
+	computeSHA256(bytes.data(), len, key);
+}
+
+TimeLockSquarer::TimeLockSquarer(const mpz_class &modulus, const mpz_class &x)
+	: n(modulus)
+{
+	k = mpz_size(n.get_mpz_t());
+	np.assign(mpz_limbs_read(n.get_mpz_t()), mpz_limbs_read(n.get_mpz_t()) + k);
+	a.assign(k, 0);
+	t.assign(2 * k, 0);
+
+	// Newton iteration for 1/n mod 2^64 (n is odd)
+	mp_limb_t inv = np[0];
+	for (int i=0; i<6; i++)
+		inv *= 2 - np[0] * inv;
+	ninv = -inv;
+
+	// a = x * 2^(64k) mod n
+	mpz_class xr = x % n;
+	mpz_mul_2exp(xr.get_mpz_t(), xr.get_mpz_t(), 64 * k);
+	xr = xr % n;
+	size_t used = mpz_size(xr.get_mpz_t());
+	memcpy(a.data(), mpz_limbs_read(xr.get_mpz_t()), used * sizeof(mp_limb_t));
+}
+
+void TimeLockSquarer::reduce()
+{
+	mp_limb_t *A = a.data(), *T = t.data();
+	const mp_limb_t *N = np.data();
+
+	// Montgomery reduction one limb at a time; the carry of row i is parked in T[i],
+	// which the row just cleared
+	for (size_t i=0; i<k; i++)
+	{
+		mp_limb_t m = T[i] * ninv;
+		T[i] = mpn_addmul_1(T + i, N, k, m);
+	}
+	mp_limb_t cy = mpn_add_n(A, T + k, T, k);
+	if (cy || mpn_cmp(A, N, k) >= 0)
+		mpn_sub_n(A, A, N, k);
+}
+
+void TimeLockSquarer::square(uint64_t count)
+{
+	for (uint64_t c=0; c<count; c++)
+	{
+		mpn_sqr(t.data(), a.data(), k);
+		reduce();
+	}
+}
+
+void TimeLockSquarer::multiply(const TimeLockSquarer &other)
+{
+	mpn_mul_n(t.data(), a.data(), other.a.data(), k);
+	reduce();
+}
+
+mpz_class TimeLockSquarer::value() const
+{
+	mpz_class r, R, rinv;
+	mpz_import(r.get_mpz_t(), k, -1, sizeof(mp_limb_t), 0, 0, a.data());
+	R = 1;
+	mpz_mul_2exp(R.get_mpz_t(), R.get_mpz_t(), 64 * k);
+	mpz_invert(rinv.get_mpz_t(), R.get_mpz_t(), n.get_mpz_t());
+	return (r * rinv) % n;
+}
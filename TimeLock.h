@@ -0,0 +1,54 @@
+#ifndef TIMELOCK_H
+
+#define TIMELOCK_H
+
+// Rivest-Shamir-Wagner time-lock puzzle: y = x^(2^T) mod n for an RSA modulus n.
+//
+// Whoever knows the factorization reduces the exponent 2^T mod phi(n) and gets y in milliseconds.
+// Everybody else has to do the T squarings one after the other.
+//
+// https://people.csail.mit.edu/rivest/pubs/RSW96.pdf
+
+#include <stdint.h>
+#include <vector>
+#include <gmpxx.h>
+
+// Puzzle base derived from the password
+mpz_class timeLockBase(const uint8_t passwordHash[32], const mpz_class &modulus);
+
+// Generate a random modulus of the given size and solve the puzzle for x with the trapdoor.
+// The factors are wiped before returning; only the modulus has to be kept.
+void timeLockCreate(const uint8_t passwordHash[32], const mpz_class &squarings, int bits,
+                    mpz_class &modulus, mpz_class &solution);
+
+// Chain end state (private key material) from the solution
+void timeLockKey(const mpz_class &solution, const mpz_class &modulus, uint8_t key[32]);
+
+// Sequential squarings in Montgomery form on raw limbs. The modulus must be odd (and above 2).
+class TimeLockSquarer
+{
+public:
+	TimeLockSquarer(const mpz_class &modulus, const mpz_class &x);
+
+	// value = value^(2^count)
+	void square(uint64_t count);
+
+	// value = value * other.value (same modulus)
+	void multiply(const TimeLockSquarer &other);
+
+	// Current value, out of Montgomery form
+	mpz_class value() const;
+
+private:
+	// a = t * R^-1 mod n
+	void reduce();
+
+	mpz_class n;
+	size_t k;				// Limbs of n
+	mp_limb_t ninv;			// -1/n mod 2^64
+	std::vector<mp_limb_t> np;	// n
+	std::vector<mp_limb_t> a;	// value * R mod n
+	std::vector<mp_limb_t> t;	// 2k limbs of scratch
+};
+
+#endif
@@ -0,0 +1,126 @@
+// Chrome trace-event output of the trace spans
+#include "Trace.h"
+
+#ifdef CHAINWALLET_TRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+struct TraceEvent
+{
+	const char *name;
+	string arg;
+	double ts, dur;		// Microseconds
+	long tid;
+};
+
+static double traceNow()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// All events, written when the process ends
+class TraceLog
+{
+public:
+	~TraceLog()
+	{
+		const char *path = getenv("CHAINWALLET_TRACE_FILE");
+		if (path == NULL || events.empty())
+			return;
+		FILE *f = fopen(path, "w");
+		if (f == NULL)
+			return;
+		long pid = getpid();
+		fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+		fprintf(f, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %ld, \"args\": {\"name\": \"ChainWallet\"}}", pid);
+		for (size_t i=0; i<events.size(); i++)
+		{
+			const TraceEvent &e = events[i];
+			fprintf(f, ",\n{\"name\": \"%s\", \"cat\": \"wallet\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %ld, \"tid\": %ld",
+			        e.name, e.ts - origin, e.dur, pid, e.tid);
+			if (!e.arg.empty())
+				fprintf(f, ", \"args\": {\"wallet\": \"%s\"}", escape(e.arg).c_str());
+			fprintf(f, "}");
+		}
+		fprintf(f, "\n]}\n");
+		fclose(f);
+	}
+
+	void add(vector<TraceEvent> &buffer)
+	{
+		lock_guard<mutex> guard(lock);
+		events.insert(events.end(), buffer.begin(), buffer.end());
+		buffer.clear();
+	}
+
+	double origin = traceNow();
+
+private:
+	static string escape(const string &s)
+	{
+		string out;
+		for (size_t i=0; i<s.size(); i++)
+		{
+			if (s[i] == '"' || s[i] == '\\')
+				out += '\\';
+			if ((unsigned char)s[i] >= 0x20)
+				out += s[i];
+		}
+		return out;
+	}
+
+	mutex lock;
+	vector<TraceEvent> events;
+};
+
+static TraceLog traceLog;
+
+// Events of one thread, handed to the log when the thread ends
+struct TraceBuffer
+{
+	vector<TraceEvent> events;
+	long tid = syscall(SYS_gettid);
+	~TraceBuffer() { traceLog.add(events); }
+};
+
+static thread_local TraceBuffer traceBuffer;
+
+static void traceRecord(const char *name, const string &arg, double start)
+{
+	TraceEvent e;
+	e.name = name;
+	e.arg = arg;
+	e.ts = start;
+	e.dur = traceNow() - start;
+	e.tid = traceBuffer.tid;
+	traceBuffer.events.push_back(e);
+}
+
+TraceSpan::TraceSpan(const char *name, const string &arg) : name(name), arg(arg), start(traceNow())
+{
+}
+
+TraceSpan::~TraceSpan()
+{
+	traceRecord(name, arg, start);
+}
+
+void TraceStages::next(const char *stage)
+{
+	double now = traceNow();
+	if (name)
+		traceRecord(name, string(), start);
+	name = stage;
+	start = now;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+
+#define TRACE_H
+
+// Scoped trace spans in Chrome trace-event format (chrome://tracing, ui.perfetto.dev).
+//
+// Built with -DCHAINWALLET_TRACE (make TRACE=1) the spans record their start and duration into a
+// buffer of their thread, and at exit all buffers go to the file named by the CHAINWALLET_TRACE_FILE
+// environment variable. Without the define the macros are empty, so the spans cost nothing.
+//
+//	TRACE_SPAN("name");					span until the end of the scope
+//	TRACE_SPAN_ARG("name", wallet);		same, with a string shown as its argument
+//	TRACE_STAGES(stages);				back to back spans in one scope:
+//	TRACE_NEXT(stages, "name");			ends the running stage and starts the next one
+//	TRACE_NEXT(stages, NULL);			ends the running stage
+
+#ifdef CHAINWALLET_TRACE
+
+#include <stdint.h>
+#include <string>
+
+class TraceSpan
+{
+public:
+	TraceSpan(const char *name, const std::string &arg = std::string());
+	~TraceSpan();
+
+private:
+	const char *name;
+	std::string arg;
+	double start;
+};
+
+class TraceStages
+{
+public:
+	TraceStages() : name(NULL), start(0) {}
+	~TraceStages() { next(NULL); }
+	void next(const char *stage);
+
+private:
+	const char *name;
+	double start;
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_SPAN_ARG(name, arg) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name, arg)
+#define TRACE_STAGES(var) TraceStages var
+#define TRACE_NEXT(var, name) var.next(name)
+
+#else
+
+#define TRACE_SPAN(name) do {} while (0)
+#define TRACE_SPAN_ARG(name, arg) do {} while (0)
+#define TRACE_STAGES(var) do {} while (0)
+#define TRACE_NEXT(var, name) do {} while (0)
+
+#endif
+
+#endif
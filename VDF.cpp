@@ -0,0 +1,160 @@
+// Wesolowski VDF over the RSA-2048 group
+#include "VDF.h"
+#include "SHA256.h"
+#include <algorithm>
+#include <string>
+using namespace std;
+
+const mpz_class &vdfModulus()
+{
+	// RSA-2048 factoring challenge (RSA Laboratories, 1991)
+	static const mpz_class n(
+		"25195908475657893494027183240048398571429282126204032027777137836043662020707595556264018525880784406918290641249515082189298559149176184502808489120072844992687392807287776735971418347270261896375014971824691165077613379859095700097330459748808428401797429100642458691817195118746121515172654632282216869987549182422433637259085141865462043576798423387184774447920739934236584823824281198163815010674810451660377306056201619676256133844143603833904414952634432190114657544454178424020924616515723350778707749817125772467962926386356373289912154831438167899885040445364023527381951378636564391212010397122822120720357",
+		10);
+	return n;
+}
+
+mpz_class vdfPrime(const mpz_class &x, const mpz_class &y, const mpz_class &squarings)
+{
+	string msg = "ChainWallet VDF|" + x.get_str(16) + "|" + y.get_str(16) + "|" + squarings.get_str(16);
+	uint8_t h[32];
+	computeSHA256((const uint8_t*)msg.data(), msg.size(), h);
+
+	// First prime above a 127 bit number, so that 2r always fits in 128 bits
+	mpz_class l;
+	mpz_import(l.get_mpz_t(), 16, 1, 1, 1, 0, h);
+	mpz_clrbit(l.get_mpz_t(), 127);
+	mpz_setbit(l.get_mpz_t(), 126);
+	mpz_nextprime(l.get_mpz_t(), l.get_mpz_t());
+	return l;
+}
+
+bool vdfVerify(const mpz_class &x, const mpz_class &y, const mpz_class &squarings, const mpz_class &proof)
+{
+	const mpz_class &n = vdfModulus();
+	if (x <= 1 || x >= n || y <= 0 || y >= n || proof <= 0 || proof >= n || squarings < 1)
+		return false;
+	mpz_class l = vdfPrime(x, y, squarings);
+	mpz_class r, a, b, two = 2;
+	mpz_powm(r.get_mpz_t(), two.get_mpz_t(), squarings.get_mpz_t(), l.get_mpz_t());
+	mpz_powm(a.get_mpz_t(), proof.get_mpz_t(), l.get_mpz_t(), n.get_mpz_t());
+	mpz_powm(b.get_mpz_t(), x.get_mpz_t(), r.get_mpz_t(), n.get_mpz_t());
+	return (a * b) % n == y;
+}
+
+#define VDF_KEPT (1 << 14)		// Powers of x kept by the evaluation, about 25 MB
+
+// Cost of the proof in multiplications: one per digit, the buckets of each group and the squarings
+// between groups. The kept powers bound gamma from below.
+static uint64_t proofCost(uint64_t squarings, unsigned kappa, uint64_t &gamma)
+{
+	gamma = max<uint64_t>(1, (squarings + (uint64_t)kappa * VDF_KEPT - 1) / ((uint64_t)kappa * VDF_KEPT));
+	return squarings / kappa + gamma * (2ull << kappa) + kappa * gamma;
+}
+
+VdfProver::VdfProver(const mpz_class &x, uint64_t squarings)
+	: x(x), total(squarings), done(0), kappa(1), gamma(1), sq(vdfModulus(), x), pi(vdfModulus(), 1), piSet(false)
+{
+	uint64_t best = UINT64_MAX, g;
+	for (unsigned k=1; k<=16; k++)
+	{
+		uint64_t cost = proofCost(squarings, k, g);
+		if (cost < best)
+		{
+			best = cost;
+			kappa = k;
+			gamma = g;
+		}
+	}
+	group = gamma;
+	kept.push_back(sq);
+}
+
+bool VdfProver::step(uint64_t count)
+{
+	uint64_t span = kappa * gamma;
+	while (count > 0 && done < total)
+	{
+		uint64_t next = min(total, (done / span + 1) * span);
+		uint64_t n = min(count, next - done);
+		sq.square(n);
+		done += n;
+		count -= n;
+		if (done % span == 0 && done < total)
+			kept.push_back(sq);
+	}
+	if (done < total)
+		return true;
+	if (l == 0)
+		l = vdfPrime(x, sq.value(), total);
+	return false;
+}
+
+// into = into * v, or v if into is still 1
+void VdfProver::fold(const TimeLockSquarer &v, TimeLockSquarer &into, bool &set)
+{
+	if (set)
+		into.multiply(v);
+	else
+		into = v;
+	set = true;
+}
+
+// Digit i of floor(2^T/l) is floor(2^kappa * (2^(T-kappa*(i+1)) mod l) / l), and 0 for a top digit
+// that is not whole. Group j holds the digits i = gamma*m + j, whose powers x^(2^(kappa*i)) are
+// kept[m]^(2^(kappa*j)); the proof is the product over j of P_j^(2^(kappa*j)), taken from the top j
+// down with kappa squarings in between.
+bool VdfProver::prove()
+{
+	if (group == 0 || done < total)
+		return false;
+	uint64_t j = --group;
+	if (buckets.empty())
+	{
+		buckets.assign((size_t)1 << kappa, pi);
+		used.assign((size_t)1 << kappa, false);
+	}
+	fill(used.begin(), used.end(), false);
+
+	// Whole digits of this group from the top one down, each remainder 2^(kappa*gamma) times the one before
+	uint64_t digits = total / kappa;
+	if (j < digits)
+	{
+		uint64_t m = (digits - 1 - j) / gamma;
+		mpz_class r, step, two = 2, e = (unsigned long)(total - kappa * (gamma * m + j + 1));
+		mpz_class span = (unsigned long)(kappa * gamma);
+		mpz_powm(r.get_mpz_t(), two.get_mpz_t(), e.get_mpz_t(), l.get_mpz_t());
+		mpz_powm(step.get_mpz_t(), two.get_mpz_t(), span.get_mpz_t(), l.get_mpz_t());
+		while (true)
+		{
+			mpz_class d = (r << kappa) / l;
+			unsigned long v = d.get_ui();
+			if (v)
+			{
+				bool set = used[v];
+				fold(kept[m], buckets[v], set);
+				used[v] = true;
+			}
+			if (m == 0)
+				break;
+			m--;
+			r = r * step % l;
+		}
+	}
+
+	// P_j = product of buckets[v]^v, as a running product of the buckets from the top
+	TimeLockSquarer running = pi, product = pi;
+	bool runningSet = false, productSet = false;
+	for (size_t v=used.size()-1; v>0; v--)
+	{
+		if (used[v])
+			fold(buckets[v], running, runningSet);
+		if (runningSet)
+			fold(running, product, productSet);
+	}
+	if (piSet)
+		pi.square(kappa);
+	if (productSet)
+		fold(product, pi, piSet);
+	return group > 0;
+}
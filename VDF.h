@@ -0,0 +1,63 @@
+#ifndef VDF_H
+
+#define VDF_H
+
+// Wesolowski verifiable delay function in the RSA group of the RSA-2048 challenge modulus,
+// whose factorization nobody knows.
+//
+// The evaluation y = x^(2^T) takes T sequential squarings (see TimeLockSquarer). The proof is
+// pi = x^floor(2^T/l) for a 127 bit prime l hashed from (x, y, T), and the verifier only checks
+// pi^l * x^(2^T mod l) = y, which is two short exponentiations. Wallets tie y to their address
+// through the key derived from it (timeLockKey).
+//
+// https://eprint.iacr.org/2018/623
+
+#include <stdint.h>
+#include <vector>
+#include <gmpxx.h>
+#include "TimeLock.h"
+
+// The group modulus
+const mpz_class &vdfModulus();
+
+// Fiat-Shamir challenge prime
+mpz_class vdfPrime(const mpz_class &x, const mpz_class &y, const mpz_class &squarings);
+
+// Check y = x^(2^T) mod n with the proof
+bool vdfVerify(const mpz_class &x, const mpz_class &y, const mpz_class &squarings, const mpz_class &proof);
+
+// Evaluates y and builds pi in one pass (Wesolowski, section 4.1). Every kappa*gamma squarings the
+// evaluation keeps x^(2^(kappa*gamma*m)). Once y and l are known, the kappa bit digits of
+// floor(2^T/l) pick which of those go into each of 2^kappa buckets, one group of digits at a time.
+// The proof then costs about T/kappa multiplications on top of the T squarings, not T more squarings.
+class VdfProver
+{
+public:
+	VdfProver(const mpz_class &x, uint64_t squarings);
+
+	// Do the next count squarings of the evaluation. Returns false when all are done.
+	bool step(uint64_t count);
+	mpz_class output() const { return sq.value(); }
+
+	// Then fold the next group of digits into the proof. Returns false when all are done.
+	bool prove();
+	uint64_t groups() const { return gamma; }
+	mpz_class proof() const { return pi.value(); }
+
+private:
+	void fold(const TimeLockSquarer &v, TimeLockSquarer &into, bool &set);
+
+	mpz_class x, l;
+	uint64_t total, done;
+	unsigned kappa;					// Bits per digit of the quotient
+	uint64_t gamma;					// Groups of digits, kappa*gamma squarings between kept powers
+	uint64_t group;					// Groups still to fold
+	TimeLockSquarer sq;
+	std::vector<TimeLockSquarer> kept;	// x^(2^(kappa*gamma*m))
+	std::vector<TimeLockSquarer> buckets;
+	std::vector<bool> used;
+	TimeLockSquarer pi;
+	bool piSet;
+};
+
+#endif
@@ -0,0 +1,152 @@
+// Wallet verification
+#include "Verify.h"
+#include "Address.h"
+#include "BIP39.hpp"
+#include "Hex.h"
+#include "HMAC.h"
+#include "Secp256k1.h"
+#include "SHA256.h"
+#include "VDF.h"
+#include <stdlib.h>
+#include <string.h>
+using namespace std;
+
+static VerifyResult fail(const string &error)
+{
+	VerifyResult r;
+	r.ok = false;
+	r.hasPrivate = false;
+	r.error = error;
+	return r;
+}
+
+// Positive decimal number
+static bool isNumber(const string &s)
+{
+	if (s.empty() || s.size() > 9)
+		return false;
+	for (size_t i=0; i<s.size(); i++)
+		if (s[i] < '0' || s[i] > '9')
+			return false;
+	return atoi(s.c_str()) > 0;
+}
+
+// Check the proof of a VDF wallet and get the key its output leads to
+static bool vdfCheck(const WalletFile &wallet, uint8_t key[32])
+{
+	mpz_class y, proof, squarings;
+	if (y.set_str(wallet.vdfOutput, 16) != 0 || proof.set_str(wallet.vdfProof, 16) != 0)
+		return false;
+	uint8_t hash[32];
+	computeSHA256((const uint8_t*)wallet.password.data(), wallet.password.size(), hash);
+	mpz_class x = timeLockBase(hash, vdfModulus());
+	mpz_ui_pow_ui(squarings.get_mpz_t(), atoi(wallet.base.c_str()), atoi(wallet.exponent.c_str()));
+	if (!vdfVerify(x, y, squarings, proof))
+		return false;
+	timeLockKey(y, vdfModulus(), key);
+	return true;
+}
+
+static const mpz_class &curveOrder()
+{
+	static const mpz_class order("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+	return order;
+}
+
+// The private key is the chain end state mod N
+static bool endStateMatches(const string &endState, const uint8_t sk[32])
+{
+	mpz_class t, k;
+	if (endState.size() != 64 || t.set_str(endState, 16) != 0)
+		return false;
+	if (t >= curveOrder())
+		t -= curveOrder();
+	mpz_import(k.get_mpz_t(), 32, 1, 1, 1, 0, sk);
+	return t == k;
+}
+
+// Private key of a chain end state, reduced mod N as finishWallet does
+static void reduceKey(uint8_t key[32])
+{
+	mpz_class t;
+	mpz_import(t.get_mpz_t(), 32, 1, 1, 1, 0, key);
+	if (t < curveOrder())
+		return;
+	t -= curveOrder();
+	memset(key, 0, 32);
+	size_t count;
+	uint8_t buf[32];
+	mpz_export(buf, &count, 1, 1, 1, 0, t.get_mpz_t());
+	memcpy(key + 32 - count, buf, count);
+}
+
+VerifyResult verifyWallet(const string &path, const WalletFile &wallet)
+{
+	// The file is named after the compressed address
+	string name = path.substr(path.find_last_of('/') == string::npos ? 0 : path.find_last_of('/') + 1);
+	if (name != wallet.pubC + ".krypt")
+		return fail("file name does not match address " + wallet.pubC);
+	if (!isNumber(wallet.base) || !isNumber(wallet.exponent))
+		return fail("invalid chain parameters");
+
+	// VDF wallets prove the delay with two short exponentiations, as long as the output was kept, and
+	// the output has to lead to the address, private lines or not
+	uint8_t vdfKey[32], pub[33];
+	bool vdf = !wallet.vdfProof.empty() && !wallet.vdfOutput.empty();
+	if (vdf)
+	{
+		if (!vdfCheck(wallet, vdfKey))
+			return fail("VDF proof does not verify");
+		reduceKey(vdfKey);
+		if (!ecSeckeyValid(vdfKey) || !ecPubkey(vdfKey, pub) || addrP2PKH(pub) != wallet.pubC)
+			return fail("address does not match VDF output");
+	}
+
+	VerifyResult r;
+	r.ok = true;
+	r.hasPrivate = !wallet.privHex.empty();
+	if (!r.hasPrivate)
+	{
+		memset(vdfKey, 0, sizeof(vdfKey));
+		return r;
+	}
+
+	// Private key -> public key -> addresses
+	uint8_t sk[32];
+	if (wallet.privHex.size() != 64 || hexDecode(wallet.privHex.data(), 32, sk) != 0 || !ecSeckeyValid(sk))
+		return fail("invalid private key");
+	if (vdf && memcmp(vdfKey, sk, 32) != 0)
+		return fail("private key does not match VDF output");
+	if (!wallet.endState.empty() && !endStateMatches(wallet.endState, sk))
+		return fail("private key does not match chain end state");
+	ecPubkey(sk, pub);
+	if (addrP2PKH(pub) != wallet.pubC)
+		return fail("address does not match private key");
+	if (!wallet.seg.empty() && addrP2SHP2WPKH(pub) != wallet.seg)
+		return fail("segwit address does not match private key");
+
+	if (!wallet.wif.empty())
+	{
+		uint8_t payload[40];
+		int len = decodeBase58Check(wallet.wif, payload, sizeof(payload));
+		if (len != 34 || payload[0] != 0x80 || payload[33] != 0x01 || memcmp(payload + 1, sk, 32) != 0)
+			return fail("WIF does not match private key");
+	}
+
+	if (!wallet.mnemonic.empty())
+	{
+		uint8_t entropy[32];
+		if (fromBIP39(wallet.mnemonic, entropy) != 0 || memcmp(entropy, sk, 32) != 0)
+			return fail("mnemonic does not match private key");
+		if (!wallet.seed.empty())
+		{
+			uint8_t seed[64], stored[64];
+			mnemonicToSeed(wallet.mnemonic, "", seed);
+			if (wallet.seed.size() != 128 || hexDecode(wallet.seed.data(), 64, stored) != 0 || memcmp(seed, stored, 64) != 0)
+				return fail("seed does not match mnemonic");
+		}
+	}
+	memset(sk, 0, sizeof(sk));
+	memset(vdfKey, 0, sizeof(vdfKey));
+	return r;
+}
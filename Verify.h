@@ -0,0 +1,22 @@
+#ifndef VERIFY_H
+
+#define VERIFY_H
+
+// Re-verification of a saved wallet without running the chain again: the public key and both
+// addresses are derived from the stored private key with the fast EC path and compared with the
+// file name and contents, together with the WIF, the mnemonic and the seed. VDF wallets also get their
+// delay proof checked and the address derived from its output, even without the private lines.
+
+#include <string>
+#include "WalletFile.h"
+
+struct VerifyResult
+{
+	bool ok;
+	bool hasPrivate;	// false if the private key lines were deleted
+	std::string error;	// First mismatch found
+};
+
+VerifyResult verifyWallet(const std::string &path, const WalletFile &wallet);
+
+#endif
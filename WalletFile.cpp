@@ -0,0 +1,130 @@
+// Wallet file parsing
+#include "WalletFile.h"
+#include "Trace.h"
+#include "Parallel.hpp"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+using namespace std;
+
+const char walletFirstLabel[] = "Brain Password               - ";
+
+// Labels are padded to the same width as in saveKey()
+static const struct
+{
+	const char *label;
+	string WalletFile::*field;
+} fields[] = {
+	{"Brain Password               - ", &WalletFile::password},
+	{"Base                         - ", &WalletFile::base},
+	{"Exponent                     - ", &WalletFile::exponent},
+	{"Private Key (hex)            - ", &WalletFile::privHex},
+	{"Private Key (WIF compressed) - ", &WalletFile::wif},
+	{"BIP39 mnemonic (HD wallet)   - ", &WalletFile::mnemonic},
+	{"BIP39 seed (hex)             - ", &WalletFile::seed},
+	{"Public Key compressed        - ", &WalletFile::pubC},
+	{"Public Segwit P2SH(P2WPKH)   - ", &WalletFile::seg},
+	{"Time to complete             - ", &WalletFile::eta},
+	{"Time-lock modulus (hex)      - ", &WalletFile::timeLockModulus},
+	{"VDF output (hex)             - ", &WalletFile::vdfOutput},
+	{"VDF proof (hex)              - ", &WalletFile::vdfProof},
+	{"Chain lanes                  - ", &WalletFile::lanes},
+	{"Chain end state (hex)        - ", &WalletFile::endState},
+};
+
+bool parseWallet(const char *text, size_t len, WalletFile &wallet)
+{
+	static const char deleted[] = " - It should be deleted";
+	const size_t deletedLen = sizeof(deleted) - 1;
+	wallet = WalletFile();
+	if (len < sizeof(walletFirstLabel) - 1 || memcmp(text, walletFirstLabel, sizeof(walletFirstLabel) - 1) != 0)
+		return false;
+
+	size_t pos = 0;
+	while (pos < len)
+	{
+		const char *end = (const char *)memchr(text + pos, '\n', len - pos);
+		size_t lineLen = end ? end - (text + pos) : len - pos;
+		string line(text + pos, lineLen);
+		pos += lineLen + 1;
+		for (size_t i=0; i<sizeof(fields)/sizeof(fields[0]); i++)
+		{
+			size_t labelLen = strlen(fields[i].label);
+			if (line.compare(0, labelLen, fields[i].label) != 0)
+				continue;
+			string value = line.substr(labelLen);
+			if (value.size() >= deletedLen && value.compare(value.size() - deletedLen, deletedLen, deleted) == 0)
+				value.erase(value.size() - deletedLen);
+			while (!value.empty() && (value.back() == ' ' || value.back() == '\r'))
+				value.pop_back();
+			wallet.*fields[i].field = value;
+			break;
+		}
+	}
+	return !wallet.pubC.empty();
+}
+
+bool readWallet(const string &path, const KryptKey &key, WalletFile &wallet)
+{
+	TRACE_SPAN("readWallet");
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+	size_t size = st.st_size;
+	void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return false;
+	vector<char> plain(size);
+	kryptApply(key, 0, (const uint8_t *)map, (uint8_t *)plain.data(), size);
+	munmap(map, size);
+	return parseWallet(plain.data(), size, wallet);
+}
+
+// First 8 key stream bytes
+static uint64_t streamPrefix(const uint8_t *bytes)
+{
+	uint64_t v;
+	memcpy(&v, bytes, 8);
+	return v;
+}
+
+void walletKeys(const vector<string> &passwords, int threads, WalletKeys &keys)
+{
+	keys.passwords = passwords;
+	keys.keys.resize(passwords.size());
+	keys.byPrefix.clear();
+	parallelFor(passwords.size(), threads, [&](size_t i) { kryptKey(keys.keys[i], passwords[i]); });
+	for (size_t i=0; i<passwords.size(); i++)
+		keys.byPrefix.insert(make_pair(streamPrefix(keys.keys[i].pattern), i));
+}
+
+bool openWallet(const string &path, const WalletKeys &keys, WalletFile &wallet)
+{
+	uint8_t head[8];
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	ssize_t n = pread(fd, head, 8, 0);
+	close(fd);
+	if (n != 8)
+		return false;
+	for (int j=0; j<8; j++)
+		head[j] ^= walletFirstLabel[j];
+	auto range = keys.byPrefix.equal_range(streamPrefix(head));
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (readWallet(path, keys.keys[it->second], wallet) && wallet.password == keys.passwords[it->second])
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,58 @@
+#ifndef WALLETFILE_H
+
+#define WALLETFILE_H
+
+// Reading the wallet files written by saveKey(): decryption and parsing of the "Label - value" lines.
+// Lines the user deleted (e.g. the private key) are simply left empty.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Kryptonite.h"
+
+struct WalletFile
+{
+	std::string password;	// Brain Password
+	std::string base;
+	std::string exponent;
+	std::string privHex;	// Private Key (hex)
+	std::string wif;		// Private Key (WIF compressed)
+	std::string mnemonic;	// BIP39 mnemonic (HD wallet)
+	std::string seed;		// BIP39 seed (hex)
+	std::string pubC;		// Public Key compressed
+	std::string seg;		// Public Segwit P2SH(P2WPKH)
+	std::string eta;		// Time to complete
+	std::string timeLockModulus;	// Time-lock modulus (hex), RSW wallets only
+	std::string vdfOutput;	// VDF output (hex), VDF wallets only
+	std::string vdfProof;	// VDF proof (hex)
+	std::string lanes;		// Chain lanes, multi-lane wallets only
+	std::string endState;	// Chain end state (hex), kept for extending the chain
+};
+
+// Plain text starts with this label, which makes the first key stream bytes of a file known
+extern const char walletFirstLabel[];
+
+// Parse decrypted text. Returns false if it does not look like a wallet file.
+bool parseWallet(const char *text, size_t len, WalletFile &wallet);
+
+// Decrypt (through mmap) and parse a wallet file
+bool readWallet(const std::string &path, const KryptKey &key, WalletFile &wallet);
+
+// Candidate passwords with their keys, looked up by the first 8 key stream bytes.
+// Every file reveals those bytes through its known first label.
+struct WalletKeys
+{
+	std::vector<std::string> passwords;
+	std::vector<KryptKey> keys;
+	std::unordered_multimap<uint64_t,size_t> byPrefix;
+};
+
+// Set up the keys of all passwords (in parallel)
+void walletKeys(const std::vector<std::string> &passwords, int threads, WalletKeys &keys);
+
+// Decrypt a wallet file with whichever candidate password it was written with
+bool openWallet(const std::string &path, const WalletKeys &keys, WalletFile &wallet);
+
+#endif
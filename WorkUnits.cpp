@@ -0,0 +1,478 @@
+// Work units for distributed chain verification
+#include "WorkUnits.h"
+#include "SHA256.h"
+#include "Hex.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+using namespace std;
+
+TranscriptWriter::TranscriptWriter(FILE *file, uint64_t every, uint64_t index, uint64_t last, const uint8_t hash[32], bool first)
+	: file(file), every(every), index(index), last(last), written(0), published(NULL)
+{
+	countdown = every - index % every;
+	if (!first)
+		written = index;
+	else if (index < last)
+		write(hash);
+}
+
+void TranscriptWriter::flush(const uint8_t hash[32])
+{
+	if (written != index && index < last)
+		write(hash);
+	fflush(file);
+}
+
+void TranscriptWriter::write(const uint8_t hash[32])
+{
+	char hex[64];
+	hexEncode(hash, 32, hex);
+	fprintf(file, "%" PRIu64 " %.64s\n", index, hex);
+	written = index;
+	if (published)
+		published->store(index, memory_order_relaxed);
+}
+
+FILE *openTranscript(const string &path, bool append)
+{
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0600);
+	if (fd < 0)
+		return NULL;
+	FILE *f = fdopen(fd, append ? "a" : "w");
+	if (f == NULL)
+		close(fd);
+	return f;
+}
+
+bool readTranscriptEnds(const string &path, uint8_t first[32], uint64_t &index, uint8_t last[32])
+{
+	ifstream in(path);
+	string line;
+	bool started = false;
+	while (getline(in, line))
+	{
+		uint64_t i;
+		char hex[65];
+		if (line.empty())
+			continue;
+		if (sscanf(line.c_str(), "%" SCNu64 " %64s", &i, hex) != 2 || strlen(hex) != 64 || hexDecode(hex, 32, last) != 0 ||
+		    (!started && i != 1) || (started && i <= index))
+			return false;
+		if (!started)
+			memcpy(first, last, 32);
+		started = true;
+		index = i;
+	}
+	return started;
+}
+
+string formatUnit(const WorkUnit &unit)
+{
+	char a[65], b[65], line[200];
+	hexEncode(unit.startHash, 32, a);
+	hexEncode(unit.endHash, 32, b);
+	a[64] = b[64] = 0;
+	snprintf(line, sizeof(line), "%s %" PRIu64 " %s %" PRIu64 " %s", unit.name.c_str(), unit.start, a, unit.end, b);
+	return line;
+}
+
+bool parseUnit(const string &line, WorkUnit &unit)
+{
+	char name[32], a[65], b[65];
+	if (sscanf(line.c_str(), "%31s %" SCNu64 " %64s %" SCNu64 " %64s", name, &unit.start, a, &unit.end, b) != 5)
+		return false;
+	unit.name = name;
+	return strlen(a) == 64 && strlen(b) == 64 && unit.end > unit.start &&
+	       hexDecode(a, 32, unit.startHash) == 0 && hexDecode(b, 32, unit.endHash) == 0;
+}
+
+// Write a file under a temporary name first, so readers never see it half done. Units hold chain
+// hashes, so only the owner may read them.
+static bool writeAtomic(const string &path, const string &text)
+{
+	string tmp = path + ".tmp";
+	FILE *f = openTranscript(tmp, false);
+	if (f == NULL)
+		return false;
+	bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+	ok = fclose(f) == 0 && ok;
+	return ok && rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+static bool readLine(const string &path, string &line)
+{
+	ifstream in(path);
+	return (bool)getline(in, line);
+}
+
+// Files of a spool sorted by name
+static vector<string> listSpool(const string &spool)
+{
+	vector<string> names;
+	DIR *d = opendir(spool.c_str());
+	if (d == NULL)
+		return names;
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL)
+		if (strncmp(e->d_name, "unit-", 5) == 0)
+			names.push_back(e->d_name);
+	closedir(d);
+	sort(names.begin(), names.end());
+	return names;
+}
+
+static bool hasSuffix(const string &s, const char *suffix)
+{
+	size_t n = strlen(suffix);
+	return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// Claimed units carry the host and process that works on them
+static string workSuffix(pid_t pid)
+{
+	char host[64] = "";
+	gethostname(host, sizeof(host) - 1);
+	return string(".work.") + host + "." + to_string(pid);
+}
+
+static bool hasResult(const string &spool, const string &base)
+{
+	struct stat st;
+	return stat((spool + "/" + base + ".ok").c_str(), &st) == 0 || stat((spool + "/" + base + ".bad").c_str(), &st) == 0;
+}
+
+// The claim of a process of this host that is gone, or older than timeout seconds
+static bool staleClaim(const string &spool, const string &name, int timeout)
+{
+	string owner = name.substr(name.find(".work.") + 6);
+	size_t dot = owner.rfind('.');
+	char host[64] = "";
+	gethostname(host, sizeof(host) - 1);
+	if (dot != string::npos && owner.compare(0, dot, host) == 0)
+	{
+		pid_t pid = atoi(owner.c_str() + dot + 1);
+		if (pid > 0 && kill(pid, 0) != 0 && errno == ESRCH)
+			return true;
+	}
+	struct stat st;
+	return timeout > 0 && stat((spool + "/" + name).c_str(), &st) == 0 && time(NULL) - st.st_mtime > timeout;
+}
+
+size_t requeueStaleUnits(const string &spool, int timeout)
+{
+	vector<string> names = listSpool(spool);
+	size_t n = 0;
+	for (size_t i=0; i<names.size(); i++)
+	{
+		size_t at = names[i].find(".work.");
+		if (at == string::npos)
+			continue;
+		string base = names[i].substr(0, at);
+		string work = spool + "/" + names[i];
+		if (hasResult(spool, base))
+			unlink(work.c_str());
+		else if (staleClaim(spool, names[i], timeout) && rename(work.c_str(), (spool + "/" + base + ".todo").c_str()) == 0)
+			n++;
+	}
+	return n;
+}
+
+long exportUnits(const string &transcript, const string &spool, int per)
+{
+	ifstream in(transcript);
+	if (!in || per < 1)
+		return -1;
+	vector<pair<uint64_t,string>> points;
+	string line;
+	while (getline(in, line))
+	{
+		uint64_t index;
+		char hex[65];
+		if (line.empty())
+			continue;
+		if (sscanf(line.c_str(), "%" SCNu64 " %64s", &index, hex) != 2 || strlen(hex) != 64)
+			return -1;
+		if (!points.empty() && index <= points.back().first)
+			return -1;
+		points.push_back(make_pair(index, string(hex)));
+	}
+	if (points.size() < 2)
+		return -1;
+	mkdir(spool.c_str(), 0700);
+
+	long count = 0;
+	for (size_t i=0; i+1<points.size(); i+=per)
+	{
+		size_t j = min(i + per, points.size() - 1);
+		char name[32];
+		snprintf(name, sizeof(name), "unit-%06ld", count);
+		string text = string(name) + " " + to_string(points[i].first) + " " + points[i].second + " " +
+		              to_string(points[j].first) + " " + points[j].second + "\n";
+		if (!writeAtomic(spool + "/" + name + ".todo", text))
+			return -1;
+		count++;
+	}
+	return count;
+}
+
+// Claim for the process owner of this host
+static bool claimUnitFor(const string &spool, WorkUnit &unit, pid_t owner)
+{
+	string suffix = workSuffix(owner);
+	vector<string> names = listSpool(spool);
+	for (size_t i=0; i<names.size(); i++)
+	{
+		if (!hasSuffix(names[i], ".todo"))
+			continue;
+
+		// rename() is atomic, so only one worker wins each unit. A unit requeued after its late worker
+		// finished already has a result.
+		string base = names[i].substr(0, names[i].size() - 5);
+		string work = spool + "/" + base + suffix;
+		if (hasResult(spool, base))
+		{
+			unlink((spool + "/" + names[i]).c_str());
+			continue;
+		}
+		if (rename((spool + "/" + names[i]).c_str(), work.c_str()) != 0)
+			continue;
+		utimensat(AT_FDCWD, work.c_str(), NULL, 0);	// The claim time, for requeueStaleUnits
+		string line;
+		if (readLine(work, line) && parseUnit(line, unit) && unit.name == base)
+			return true;
+		rename(work.c_str(), (spool + "/" + base + ".bad").c_str());
+	}
+	return false;
+}
+
+bool claimUnit(const string &spool, WorkUnit &unit)
+{
+	return claimUnitFor(spool, unit, getpid());
+}
+
+bool runUnit(const WorkUnit &unit, uint8_t got[32])
+{
+	uint8_t src[32];
+	memcpy(got, unit.startHash, 32);
+	for (uint64_t j=unit.start; j<unit.end; j++)
+	{
+		memcpy(src, got, 32);
+		computeSHA256(src, 32, got);
+	}
+	return memcmp(got, unit.endHash, 32) == 0;
+}
+
+bool finishUnit(const string &spool, const WorkUnit &unit, bool ok, const uint8_t got[32])
+{
+	char hex[65];
+	hexEncode(got, 32, hex);
+	hex[64] = 0;
+	string text = formatUnit(unit) + " " + hex + "\n";
+	if (!writeAtomic(spool + "/" + unit.name + (ok ? ".ok" : ".bad"), text))
+		return false;
+
+	// Whoever holds the claim now, the unit is done
+	vector<string> names = listSpool(spool);
+	for (size_t i=0; i<names.size(); i++)
+		if (names[i].compare(0, unit.name.size() + 6, unit.name + ".work.") == 0)
+			unlink((spool + "/" + names[i]).c_str());
+	return true;
+}
+
+// One request and its answer per connection
+static bool exchange(const string &socketPath, const string &request, string &reply)
+{
+	struct sockaddr_un addr;
+	if (socketPath.size() >= sizeof(addr.sun_path))
+		return false;
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return false;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath.c_str());
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+	    write(fd, request.data(), request.size()) != (ssize_t)request.size())
+	{
+		close(fd);
+		return false;
+	}
+	shutdown(fd, SHUT_WR);
+	reply.clear();
+	char buf[256];
+	ssize_t n;
+	while ((n = read(fd, buf, sizeof(buf))) > 0)
+		reply.append(buf, n);
+	close(fd);
+	return true;
+}
+
+bool requestUnit(const string &socketPath, WorkUnit &unit)
+{
+	string reply;
+	return exchange(socketPath, "GET\n", reply) && parseUnit(reply, unit);
+}
+
+bool reportUnit(const string &socketPath, const WorkUnit &unit, bool ok, const uint8_t got[32])
+{
+	char hex[65];
+	hexEncode(got, 32, hex);
+	hex[64] = 0;
+	string reply;
+	return exchange(socketPath, "PUT " + string(ok ? "ok " : "bad ") + hex + " " + formatUnit(unit) + "\n", reply) &&
+	       reply == "OK\n";
+}
+
+// Units without a result yet, after stale claims went back to the queue
+static size_t pendingUnits(const string &spool, int timeout)
+{
+	requeueStaleUnits(spool, timeout);
+	vector<string> names = listSpool(spool);
+	size_t n = 0;
+	for (size_t i=0; i<names.size(); i++)
+	{
+		size_t at = hasSuffix(names[i], ".todo") ? names[i].size() - 5 : names[i].find(".work.");
+		if (at != string::npos && !hasResult(spool, names[i].substr(0, at)))
+			n++;
+	}
+	return n;
+}
+
+bool serveUnits(const string &spool, const string &socketPath, int claimTimeout)
+{
+	struct sockaddr_un addr;
+	if (socketPath.size() >= sizeof(addr.sun_path))
+		return false;
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return false;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath.c_str());
+	unlink(socketPath.c_str());
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	// Units are claimed in the spool in the name of the worker process, found from the socket, so the
+	// claim of a worker that dies goes stale like a spool worker's. The spool is checked every second
+	// too, so units finished by spool workers or claims gone stale end the wait.
+	while (pendingUnits(spool, claimTimeout) > 0)
+	{
+		struct pollfd p = {fd, POLLIN, 0};
+		if (poll(&p, 1, 1000) <= 0)
+			continue;
+		int c = accept(fd, NULL, NULL);
+		if (c < 0)
+			continue;
+
+		// A client that connects and sends nothing cannot hold up the others for long
+		struct timeval tv = {5, 0};
+		setsockopt(c, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		string request;
+		char buf[256];
+		ssize_t n;
+		while (request.find('\n') == string::npos && (n = read(c, buf, sizeof(buf))) > 0)
+			request.append(buf, n);
+
+		string reply = "ERROR\n";
+		WorkUnit unit;
+		uint8_t got[32];
+		char status[8], hex[65];
+		int at = -1;
+		if (request == "GET\n")
+		{
+			struct ucred peer;
+			socklen_t len = sizeof(peer);
+			pid_t owner = getsockopt(c, SOL_SOCKET, SO_PEERCRED, &peer, &len) == 0 ? peer.pid : getpid();
+			reply = claimUnitFor(spool, unit, owner) ? formatUnit(unit) + "\n" : "NONE\n";
+		}
+		else if (sscanf(request.c_str(), "PUT %7s %64s %n", status, hex, &at) == 2 && at > 0 && strlen(hex) == 64 &&
+		         hexDecode(hex, 32, got) == 0 && parseUnit(request.c_str() + at, unit) &&
+		         finishUnit(spool, unit, strcmp(status, "ok") == 0, got))
+			reply = "OK\n";
+		// A worker gone before the answer leaves a claim in its name, which goes stale
+		if (send(c, reply.data(), reply.size(), MSG_NOSIGNAL) < 0)
+			reply.clear();
+		close(c);
+	}
+	close(fd);
+	unlink(socketPath.c_str());
+	return true;
+}
+
+bool mergeUnits(const string &spool, MergeReport &report)
+{
+	report = MergeReport();
+	vector<string> names = listSpool(spool);
+	map<string,int> state;	// 0 pending, 1 ok, 2 bad
+	vector<WorkUnit> done;
+	for (size_t i=0; i<names.size(); i++)
+	{
+		string base = names[i].substr(0, names[i].find('.'));
+		bool ok = hasSuffix(names[i], ".ok"), bad = hasSuffix(names[i], ".bad");
+		if (hasSuffix(names[i], ".tmp"))
+			continue;
+		if (!ok && !bad)
+		{
+			state.insert(make_pair(base, 0));
+			continue;
+		}
+		state[base] = ok ? 1 : 2;
+		WorkUnit unit;
+		string line;
+		if (readLine(spool + "/" + names[i], line) && parseUnit(line, unit))
+			done.push_back(unit);
+	}
+
+	for (map<string,int>::iterator it=state.begin(); it!=state.end(); ++it)
+	{
+		report.units++;
+		if (it->second == 1)
+			report.ok++;
+		else if (it->second == 2)
+		{
+			report.bad++;
+			report.problems.push_back(it->first + " does not reach its end hash");
+		}
+		else
+		{
+			report.pending++;
+			report.problems.push_back(it->first + " has no result yet");
+		}
+	}
+
+	// Units have to join end to end
+	sort(done.begin(), done.end(), [](const WorkUnit &a, const WorkUnit &b) { return a.start < b.start; });
+	for (size_t i=0; i+1<done.size(); i++)
+	{
+		if (done[i].end != done[i+1].start || memcmp(done[i].endHash, done[i+1].startHash, 32) != 0)
+		{
+			report.gaps++;
+			report.problems.push_back(done[i].name + " and " + done[i+1].name + " do not join");
+		}
+	}
+	if (!done.empty())
+	{
+		report.first = done.front().start;
+		report.last = done.back().end;
+	}
+	return report.units > 0 && report.ok == report.units && report.gaps == 0;
+}
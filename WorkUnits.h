@@ -0,0 +1,114 @@
+#ifndef WORKUNITS_H
+
+#define WORKUNITS_H
+
+// Distributed verification of long chains.
+//
+// A transcript holds checkpoints of a chain as "index hash" lines, index 1 being sha256(password).
+// It is cut into self-contained work units (start index and hash, expected end index and hash) in a
+// spool directory. Workers on any number of hosts claim units by renaming them, hash from start to
+// end and leave the result next to them. A worker can also get its units from a local socket served
+// over the same spool. Merging checks that every unit passed and that the units join end to end.
+//
+// Spool files: unit-NNNNNN.todo -> unit-NNNNNN.work.<host>.<pid> -> unit-NNNNNN.ok or .bad
+// A claim whose worker died goes back to .todo.
+//
+// A transcript is as secret as the password: anyone holding it can run the rest of the chain.
+// It stops before the last hash, which is the private key.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct WorkUnit
+{
+	std::string name;		// unit-NNNNNN
+	uint64_t start;			// Chain index of startHash
+	uint64_t end;			// Chain index of endHash
+	uint8_t startHash[32];
+	uint8_t endHash[32];
+};
+
+// Writes checkpoints every so many hashes while a chain runs
+class TranscriptWriter
+{
+public:
+	// index is the position of the current hash, which is written unless first is false (when appending
+	// to a transcript that ends with it); nothing at or after last is
+	TranscriptWriter(FILE *file, uint64_t every, uint64_t index, uint64_t last, const uint8_t hash[32], bool first=true);
+
+	// Write the current hash too, if it is not a checkpoint already, and flush the file
+	void flush(const uint8_t hash[32]);
+
+	// Store the index of every checkpoint written here too (for the live status)
+	void publish(std::atomic<uint64_t> *index) { published = index; }
+
+	// Call after each hash
+	inline void step(const uint8_t hash[32])
+	{
+		index++;
+		if (--countdown == 0)
+		{
+			countdown = every;
+			if (index < last)
+				write(hash);
+		}
+	}
+
+private:
+	void write(const uint8_t hash[32]);
+
+	FILE *file;
+	uint64_t every, index, last, countdown;
+	uint64_t written;		// Index of the last line
+	std::atomic<uint64_t> *published;
+};
+
+// Open a transcript for writing, created readable by its owner only, or NULL
+FILE *openTranscript(const std::string &path, bool append);
+
+// First hash (index 1) and last checkpoint of a transcript, to go on with its chain
+bool readTranscriptEnds(const std::string &path, uint8_t first[32], uint64_t &index, uint8_t last[32]);
+
+// "name start startHash end endHash" and back
+std::string formatUnit(const WorkUnit &unit);
+bool parseUnit(const std::string &line, WorkUnit &unit);
+
+// Cut a transcript into units of per checkpoint intervals. Returns the number of units or -1.
+long exportUnits(const std::string &transcript, const std::string &spool, int per);
+
+// Take the next pending unit of a spool. Returns false when there is none.
+bool claimUnit(const std::string &spool, WorkUnit &unit);
+
+// Hash from start to end. Returns true if the end hash matches; got is the hash found.
+bool runUnit(const WorkUnit &unit, uint8_t got[32]);
+
+// Store the result of a claimed unit
+bool finishUnit(const std::string &spool, const WorkUnit &unit, bool ok, const uint8_t got[32]);
+
+// The same two steps through a socket served by serveUnits()
+bool requestUnit(const std::string &socketPath, WorkUnit &unit);
+bool reportUnit(const std::string &socketPath, const WorkUnit &unit, bool ok, const uint8_t got[32]);
+
+// Put back to .todo the claims of processes of this host that are gone and, if timeout > 0, claims
+// older than timeout seconds (a worker on a host that went away). A unit that outlives its timeout
+// is only verified twice. Returns the number of units requeued.
+size_t requeueStaleUnits(const std::string &spool, int timeout);
+
+// Hand out the units of a spool on a Unix socket until all have results, requeueing stale claims
+bool serveUnits(const std::string &spool, const std::string &socketPath, int claimTimeout);
+
+struct MergeReport
+{
+	size_t units, ok, bad, pending;
+	size_t gaps;			// Consecutive units that do not join
+	uint64_t first, last;	// Chain indexes covered
+	std::vector<std::string> problems;
+};
+
+// Confirm that all units passed and cover one unbroken range
+bool mergeUnits(const std::string &spool, MergeReport &report);
+
+#endif
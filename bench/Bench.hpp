@@ -0,0 +1,154 @@
+#ifndef BENCH_H
+
+#define BENCH_H
+
+// Microbenchmark harness: warm-up and calibration, repeated timed runs, statistics, cycles per op,
+// JSON output and comparison with a stored baseline.
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "PerfCounters.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+struct BenchResult
+{
+	std::string name;
+	uint64_t iterations;	// Calls per repetition
+	int reps;
+	double min, median, mean, stddev, max;	// ns/op over the repetitions
+	double cyclesPerOp;		// < 0 if no cycle counter
+	const char *cycles;		// "pmu", "tsc" or "none"
+};
+
+// Keep the compiler from dropping a result
+inline void benchSink(const void *p)
+{
+	asm volatile("" : : "r"(p) : "memory");
+}
+
+inline uint64_t benchTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+template <typename F>
+double benchTime(uint64_t iterations, F &f)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t i=0; i<iterations; i++)
+		f();
+	return std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run f in reps repetitions of about repMs milliseconds each
+template <typename F>
+BenchResult runBench(const std::string &name, int reps, double repMs, F f)
+{
+	BenchResult r;
+	r.name = name;
+	r.reps = reps;
+
+	// Warm up while finding how many calls fill a repetition
+	uint64_t n = 1;
+	double t;
+	while ((t = benchTime(n, f)) < 1e6 * repMs / 10 && n < (1ull << 40))
+		n *= 2;
+	r.iterations = std::max<uint64_t>(1, n * (1e6 * repMs) / std::max(t, 1.0));
+	benchTime(r.iterations, f);
+
+	std::vector<double> ns;
+	double cycles = 0, ticks = 0;
+	PerfCounters perf;
+	for (int i=0; i<reps; i++)
+	{
+		perf.begin(name, r.iterations);
+		uint64_t t0 = benchTicks();
+		ns.push_back(benchTime(r.iterations, f) / r.iterations);
+		ticks += benchTicks() - t0;
+		perf.end();
+		cycles += perf.samples().back().cycles;
+	}
+
+	std::sort(ns.begin(), ns.end());
+	r.min = ns.front();
+	r.max = ns.back();
+	r.median = reps % 2 ? ns[reps / 2] : (ns[reps / 2 - 1] + ns[reps / 2]) / 2;
+	double sum = 0, sq = 0;
+	for (size_t i=0; i<ns.size(); i++)
+		sum += ns[i];
+	r.mean = sum / reps;
+	for (size_t i=0; i<ns.size(); i++)
+		sq += (ns[i] - r.mean) * (ns[i] - r.mean);
+	r.stddev = reps > 1 ? sqrt(sq / (reps - 1)) : 0;
+
+	// Core cycles when the PMU is there, reference cycles of the TSC otherwise
+	if (perf.samples().back().cycles >= 0)
+	{
+		r.cyclesPerOp = cycles / reps / r.iterations;
+		r.cycles = "pmu";
+	}
+	else if (ticks > 0)
+	{
+		r.cyclesPerOp = ticks / reps / r.iterations;
+		r.cycles = "tsc";
+	}
+	else
+	{
+		r.cyclesPerOp = -1;
+		r.cycles = "none";
+	}
+	return r;
+}
+
+// One benchmark per line, which is also what readBaseline() expects
+inline std::string benchJson(const std::vector<BenchResult> &results)
+{
+	std::string out = "{\"benchmarks\": [\n";
+	char line[512];
+	for (size_t i=0; i<results.size(); i++)
+	{
+		const BenchResult &r = results[i];
+		snprintf(line, sizeof(line),
+		         "{\"name\": \"%s\", \"iterations\": %llu, \"reps\": %d, \"ns_per_op\": {\"min\": %.3f, \"median\": %.3f, "
+		         "\"mean\": %.3f, \"stddev\": %.3f, \"max\": %.3f}, \"ops_per_s\": %.1f, \"cycles_per_op\": %.1f, \"cycles\": \"%s\"}%s\n",
+		         r.name.c_str(), (unsigned long long)r.iterations, r.reps, r.min, r.median, r.mean, r.stddev, r.max,
+		         1e9 / r.median, r.cyclesPerOp, r.cycles, i+1 < results.size() ? "," : "");
+		out += line;
+	}
+	return out + "]}\n";
+}
+
+// Median ns/op by name from a file written by benchJson()
+inline bool readBaseline(const std::string &path, std::map<std::string,double> &median)
+{
+	std::ifstream in(path);
+	if (!in)
+		return false;
+	std::string line;
+	while (getline(in, line))
+	{
+		size_t n = line.find("\"name\": \""), m = line.find("\"median\": ");
+		if (n == std::string::npos || m == std::string::npos)
+			continue;
+		n += 9;
+		size_t end = line.find('"', n);
+		if (end != std::string::npos)
+			median[line.substr(n, end - n)] = atof(line.c_str() + m + 10);
+	}
+	return true;
+}
+
+#endif
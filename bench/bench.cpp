@@ -0,0 +1,171 @@
+// Microbenchmarks of the primitives and pipeline stages
+// Usage: ChainBench [--reps n] [--time ms] [--filter text] [--json file] [--baseline file] [--threshold percent]
+
+// The original primitives live in chainWallet.cpp next to its main()
+#define main chainWalletMain
+#include "chainWallet.cpp"
+#undef main
+
+#include "bench/Bench.hpp"
+#include "Secp256k1.h"
+#include "Address.h"
+#include "Hash160Index.h"
+#include "HashBackend.h"
+
+int main(int argc, char **argv)
+{
+	int reps = 10;
+	double repMs = 20, threshold = 5;
+	string filter, jsonPath, baselinePath;
+	bool usage = false;
+	for (int i=1; i<argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--reps" && i+1 < argc)
+			reps = atoi(argv[++i]);
+		else if (arg == "--time" && i+1 < argc)
+			repMs = atof(argv[++i]);
+		else if (arg == "--filter" && i+1 < argc)
+			filter = argv[++i];
+		else if (arg == "--json" && i+1 < argc)
+			jsonPath = argv[++i];
+		else if (arg == "--baseline" && i+1 < argc)
+			baselinePath = argv[++i];
+		else if (arg == "--threshold" && i+1 < argc)
+			threshold = atof(argv[++i]);
+		else
+			usage = true;
+	}
+	if (usage || reps < 1 || !(repMs > 0))
+	{
+		cout << "Usage: ChainBench [--reps n] [--time ms] [--filter text] [--json file] [--baseline file] [--threshold percent]" << endl;
+		return 1;
+	}
+
+	// Inputs
+	uint8_t buf32[32], out[64], kbuf[1024];
+	for (int i=0; i<32; i++)
+		buf32[i] = i * 7 + 1;
+	for (int i=0; i<1024; i++)
+		kbuf[i] = i;
+	string hexKey = hash2str(buf32, 32);
+	mpz_class t(hexKey, 16);
+	GF sk(t, secp256k1.P), a = sk, b = sk + 12345;
+	point g = secp256k1.G, g2 = add(g, g);
+	char privBuf[65];
+	gmp_sprintf(privBuf, "%Z064x", sk.getNum().get_mpz_t());
+	string payload = mainnetChecksum("00", hash160("02" + hexKey), false);
+	string mnemonic = toBIP39(privBuf);
+	KryptKey kk;
+	kryptKey(kk, "password");
+	vector<uint8_t> mib(1 << 20);
+
+	vector<BenchResult> results;
+	auto run = [&](const string &name, auto f)
+	{
+		if (!filter.empty() && name.find(filter) == string::npos)
+			return;
+		BenchResult r = runBench(name, reps, repMs, f);
+		results.push_back(r);
+		printf("%-28s %12.1f ns/op %14.0f ops/s %10.1f cycles/op (%s)  +-%.1f%%\n", r.name.c_str(), r.median,
+		       1e9 / r.median, r.cyclesPerOp, r.cycles, 100 * r.stddev / r.mean);
+	};
+
+	// Hashes
+	run("computeSHA256/32B", [&] { computeSHA256(buf32, 32, out); benchSink(out); });
+	run("computeSHA256/1KiB", [&] { computeSHA256(kbuf, 1024, out); benchSink(out); });
+	run("computeRIPEMD160/32B", [&] { computeRIPEMD160(buf32, 32, out); benchSink(out); });
+	run("sha512::calculate/32B", [&] { string s = sha512::calculate(buf32, 32); benchSink(s.data()); });
+	int kernel = sha256_kernel_current();
+	for (int k=0; k<sha256_kernel_count(); k++)
+		if (sha256_kernel_select(k) == 0)
+			run(string("sha256 kernel/") + sha256_kernel_name(k), [&] { computeSHA256(buf32, 32, out); benchSink(out); });
+	sha256_kernel_select(kernel);
+	for (int i=0; i<hashBackendCount(); i++)
+		if (hashBackendAt(i).available())
+			run(string("hash backend/") + hashBackendAt(i).name, [&] { hashBackendAt(i).sha256(buf32, 32, out); benchSink(out); });
+	run("hash160/33B", [&] { uint8_t pub[33] = {2}; ::hash160(pub, 33, out); benchSink(out); });
+
+	// UTXO index: batches of random probes against a million hashes, nearly all misses as in an audit
+	Hash160Index utxo;
+	// Each run takes the next 1024 of a million probes, so the Bloom blocks are not all in cache
+	vector<Hash160> probes(1 << 20);
+	vector<uint8_t> found(1024);
+	size_t next = 0;
+	for (size_t i=0; i<probes.size(); i++)
+	{
+		uint8_t h[32];
+		computeSHA256(&i, sizeof(i), h);
+		memcpy(probes[i].b, h, 20);
+	}
+	{
+		vector<Hash160> set(1000000);
+		for (size_t i=0; i<set.size(); i++)
+			computeRIPEMD160(&i, sizeof(i), set[i].b);
+		string path = "/tmp/chainbench-" + to_string(getpid()) + ".h160";
+		uint64_t unique;
+		if (writeHash160Index(set, path, unique) && utxo.open(path))
+			run("Hash160Index::probe/1024", [&]
+			{
+				utxo.probe(&probes[next], found.size(), found.data());
+				next = (next + found.size()) % probes.size();
+				benchSink(found.data());
+			});
+		unlink(path.c_str());
+	}
+
+	// Field and curve
+	run("GF::operator+", [&] { GF c = a + b; benchSink(&c); });
+	run("GF::operator*", [&] { GF c = a * b; benchSink(&c); });
+	run("GF::operator/", [&] { GF c = a / b; benchSink(&c); });
+	run("add/distinct", [&] { point r = add(g, g2); benchSink(&r); });
+	run("add/double", [&] { point r = add(g, g); benchSink(&r); });
+	run("priv2pub", [&] { point r = priv2pub(sk); benchSink(&r); });
+	run("ecPubkey", [&] { uint8_t pub[33]; ecPubkey(buf32, pub); benchSink(pub); });
+
+	// Encodings
+	run("encodeBase58Check", [&] { string s = encodeBase58Check(payload); benchSink(s.data()); });
+	run("toBIP39", [&] { string s = toBIP39(privBuf); benchSink(s.data()); });
+	run("hexEncode/32B", [&] { char hex[64]; hexEncode(buf32, 32, hex); benchSink(hex); });
+
+	// Pipeline stages after the chain
+	run("mnemonicToSeed", [&] { uint8_t seed[64]; mnemonicToSeed(mnemonic, "", seed); benchSink(seed); });
+	run("kryptApply/1MiB", [&] { kryptApply(kk, 0, mib.data(), mib.data(), mib.size()); benchSink(mib.data()); });
+
+	if (!jsonPath.empty())
+	{
+		ofstream json(jsonPath);
+		json << benchJson(results);
+		if (!json)
+		{
+			cout << "Unable to write " << jsonPath << endl;
+			return 1;
+		}
+	}
+
+	// A benchmark regresses when its median gets slower than the baseline by more than the threshold
+	int regressions = 0;
+	if (!baselinePath.empty())
+	{
+		map<string,double> base;
+		if (!readBaseline(baselinePath, base))
+		{
+			cout << "Unable to read " << baselinePath << endl;
+			return 1;
+		}
+		cout << endl;
+		for (size_t i=0; i<results.size(); i++)
+		{
+			map<string,double>::iterator it = base.find(results[i].name);
+			if (it == base.end() || it->second <= 0)
+				continue;
+			double change = 100 * (results[i].median - it->second) / it->second;
+			bool bad = change > threshold;
+			regressions += bad;
+			printf("%-28s %12.1f -> %12.1f ns/op %+7.1f%%%s\n", results[i].name.c_str(), it->second, results[i].median,
+			       change, bad ? "  REGRESSION" : "");
+		}
+		printf("%d regressions over %.1f%%\n", regressions, threshold);
+	}
+	return regressions ? 1 : 0;
+}
@@ -8,12 +8,42 @@
 #include <gmpxx.h>  // mpz_class (bignum)
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <chrono>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
 #include <inttypes.h>     // printf uint64_t
+#include <unistd.h>       // chdir()
+#include <sys/stat.h>
 #include "BIP39.hpp"
 #include "SHA256.h"
+#include "HashBackend.h"
+#include "Hex.h"
+#include "HMAC.h"
+#include "HDWallet.h"
+#include "Kryptonite.h"
+#include "KryptIndex.h"
+#include "Hash160Index.h"
+#include "Secp256k1.h"
+#include "Address.h"
+#include "Verify.h"
+#include "TimeLock.h"
+#include "VDF.h"
+#include "ChainLanes.h"
+#include "WorkUnits.h"
+#include "PerfCounters.h"
+#include "LiveStatus.h"
+#include "ChainSignals.h"
+#include "ChainEngine.h"
+#include "HashTrace.h"
+#include "CpuPlacement.h"
+#include "JobDaemon.h"
+#include "Trace.h"
+#include "Parallel.hpp"
 #include "RIPEMD160.h"
 #include "SHA512.hpp"
 #include "GaloisField.hpp"
@@ -128,15 +158,10 @@ point priv2pub(GF &sk, point *Q=NULL)
 }
 
 // Convert hash to hex string
-string hash2str(uint8_t *hash, int len)
+string hash2str(const uint8_t *hash, int len)
 {
-	char buf[3];
-	string bufStr;
-	for (int i=0; i<len; i++)
-	{
-		sprintf(buf, "%02x", hash[i]);
-		bufStr += buf;
-	}
+	string bufStr(2*len, '0');
+	hexEncode(hash, len, &bufStr[0]);
 	return bufStr;
 }
 
@@ -164,8 +189,11 @@ string getHash(string str, int function)
 	// Convert string to uint8_t array
 	int length = str.length() / 2;
 	uint8_t *source = new uint8_t[length];
-	for (int i=0; i<(int)str.length(); i+=2)
-		source[i/2] = stoul(str.substr(i,2),nullptr,16);
+	if (hexDecode(str.data(), length, source) != 0)
+	{
+		cout << "Invalid hex string: " << str << endl;
+		exit(1);
+	}
 
 	// Get hash of array
 	int lenHash = 32;
@@ -255,57 +283,19 @@ string splitXY(string key, point &pk)
 }
 
 // Hide shown parameters
-void removePwd()
+void removePwd(int lines=4)
 {
-	for (int i=0; i<4; i++)
+	for (int i=0; i<lines; i++)
 	{
         printf("\033[1A"); // Move 1 line up
         printf("\033[K");  // Erase line
 	}
 }
 
-// Kryptonite main function
-void krypt(uint8_t *source, uint8_t *destination, int len, string password)
-{
-	// Define digestLen to an unexpected value
-	int sumPass = 0;
-	for (int i=0; i<(int)password.size(); i++)
-	{
-		sumPass += password[i];
-	}
-	int digestLen = 32;
-	digestLen += sumPass % 32; // Digestlen will vary from 32 to 64 bytes
-
-	// Create digest of password and convert to byte array
-	string digestStr = sha512::calculate(password);
-	uint8_t digest[64];
-	char byte[3];
-	unsigned int hex;
-	byte[2] = 0;
-	for (int i=0; i<128; i+=2)
-	{
-		byte[0] = digestStr[i];
-		byte[1] = digestStr[i+1];
-		sscanf(byte,"%x",&hex);
-		digest[i/2] = hex;
-	}
-
-	// Xor each byte of both digest and source up to digestLen
-	// Repeat cropped digest up to income string length
-	int count = 0;
-	for (int i=0; i<len; i++)
-	{
-		destination[i] = source[i] ^ digest[count];
-		count++;
-		if (count == digestLen)
-		{
-			count = 0;
-		}
-	}
-}	
-
 // Save results
-void saveKey(string p, int b, int n, string hex, string mnemonic, string wifC, string pubC, string seg, string eta)
+// Mode specific lines go in extra, already formatted as "Label - value\n"
+// Returns false if the file could not be written.
+bool saveKey(string p, int b, int n, string hex, string mnemonic, string seed, string wifC, string pubC, string seg, string eta, string extra="")
 {
 	// Show found key on stdout
 	cout << "Public Key compressed        - " << pubC << endl;
@@ -319,30 +309,30 @@ void saveKey(string p, int b, int n, string hex, string mnemonic, string wifC, s
 	toEncrypt += "Private Key (hex)            - " + hex + " - It should be deleted" + "\n";
 	toEncrypt += "Private Key (WIF compressed) - " + wifC + " - It should be deleted" + "\n";
 	toEncrypt += "BIP39 mnemonic (HD wallet)   - " + mnemonic + " - It should be deleted" + "\n";  
+	toEncrypt += "BIP39 seed (hex)             - " + seed + " - It should be deleted" + "\n";
 	toEncrypt += "Public Key compressed        - " + pubC + "\n";
 	toEncrypt += "Public Segwit P2SH(P2WPKH)   - " + seg + "\n";
 	toEncrypt += "Time to complete             - " + eta + "\n";
+	toEncrypt += extra;
 
-	// Encrypt string
-	int length = toEncrypt.size();
-	uint8_t *source = new uint8_t[length];
-	uint8_t *destination = new uint8_t[length];
-	for (int i=0; i<length; i++)
-		source[i] = toEncrypt[i];
-	krypt(source,destination,length,p);
+	// Encrypt string in place
+	KryptKey key;
+	kryptKey(key, p);
+	uint8_t *buffer = (uint8_t*)&toEncrypt[0];
+	kryptApply(key, 0, buffer, buffer, toEncrypt.size());
 
 	// Save key on a file
+	TRACE_SPAN("write file");
 	string fileName = pubC + ".krypt";
 	ofstream file(fileName, ios::out | ios::binary);
+	file.write(toEncrypt.data(),toEncrypt.size());
+	file.close();
 	if (!file)
 	{
 		cout << "Unable to save " << fileName << endl;
-		exit(1);
+		return false;
 	}
-	file.write((char*)destination,length);
-	delete [] source;
-	delete [] destination;
-	file.close();
+	return true;
 }
 
 //  ripemd160(sha256(x))
@@ -354,121 +344,1670 @@ string hash160(const string &x)
 // Convert private key to BIP39 mnemonic
 string toBIP39(char* privBuf)
 {
-	// Create checksum
-	string sha256 = getHash(privBuf,1);
-	string checksum = sha256.substr(0,2);
-	string entropy = privBuf + checksum;
+	uint8_t entropy[32];
+	hexDecode(privBuf, 32, entropy);
+	char mnemonic[24*9];
+	size_t len = toBIP39(entropy, mnemonic);
+	return string(mnemonic, len);
+}
 
-	// Get mnemonic
-	string mnemonic;
-	mpz_t n, next11, b11;
-	mpz_init(n);
-	mpz_init(next11);
-	mpz_init(b11);
-	mpz_set_str(n,entropy.c_str(),16);
-	mpz_set_ui(b11,2047);
-	for (int i=0; i<24; i++)
+// Show account keys and addresses of a BIP39 mnemonic
+// Usage: ChainWallet hd [count] [account]
+int hdCommand(int argc, char **argv)
+{
+	int count = argc > 2 ? atoi(argv[2]) : 20;
+	int account = argc > 3 ? atoi(argv[3]) : 0;
+	if (count <= 0 || account < 0)
 	{
-		mpz_and(next11,n,b11);
-		mnemonic = getWord(mpz_get_ui(next11)) + " " + mnemonic;
-		mpz_fdiv_q_2exp(n,n,11); // shift >> 11
+		cout << "Usage: ChainWallet hd [count] [account]" << endl;
+		return 1;
 	}
-	return mnemonic;
-}
 
+	string mnemonic, passphrase;
+	cout << "Type your BIP39 mnemonic: ";
+	getline(cin,mnemonic);
+	cout << "Type your BIP39 passphrase (empty for none): ";
+	getline(cin,passphrase);
+	removePwd(2);
 
-int main(int argc, char **argv)
+	uint8_t entropy[32];
+	size_t entropyLen;
+	if (fromBIP39(mnemonic, entropy, &entropyLen) != 0)
+	{
+		cout << "Invalid mnemonic" << endl;
+		return 1;
+	}
+	uint8_t seed[64];
+	mnemonicToSeed(mnemonic, passphrase, seed);
+
+	static const char *names[3] = {"Legacy P2PKH", "Segwit P2SH(P2WPKH)", "Native segwit P2WPKH"};
+	for (int s=HD_BIP44; s<=HD_BIP84; s++)
+	{
+		HDAccount acct;
+		TRACE_SPAN_ARG("hdAccount", names[s]);
+		if (!hdAccount(seed, (HDScheme)s, account, count, acct))
+		{
+			cout << "Unable to derive " << names[s] << " account" << endl;
+			return 1;
+		}
+		cout << names[s] << " - " << acct.path << endl;
+		cout << "Account public key - " << acct.xpub << endl;
+		for (int i=0; i<count; i++)
+			cout << acct.path << "/0/" << i << " - " << acct.receive[i] << endl;
+		for (int i=0; i<count; i++)
+			cout << acct.path << "/1/" << i << " - " << acct.change[i] << endl;
+		cout << endl;
+	}
+	memset(seed, 0, sizeof(seed));
+	return 0;
+}
+
+// Encrypt or decrypt files in Kryptonite format
+// Usage: ChainWallet krypt [-o output] file...
+int kryptCommand(int argc, char **argv)
 {
-	// Ask parameters
+	string output;
+	vector<string> files;
+	for (int i=2; i<argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "-o" && i+1 < argc)
+			output = argv[++i];
+		else
+			files.push_back(arg);
+	}
+	if (files.empty() || (!output.empty() && files.size() > 1))
+	{
+		cout << "Usage: ChainWallet krypt [-o output] file..." << endl;
+		return 1;
+	}
+
+	// Keep the prompt out of stdout when it carries the data
 	string password;
-	int n, b;
-	char p;
-	cout << "Type your brain wallet password: ";
-	getline(cin,password);
-	cout << "Type the base of chain length (B^N). B = ";
-	cin >> b;
-	cout << "Type the exponent of chain length (" << b << "^N). N = ";
-	cin >> n;
-	cout << "Print intermediary hash values (y/n) ? ";
-	cin >> p;
-	removePwd();
+	if (output == "-")
+	{
+		cerr << "Type your brain wallet password: ";
+		getline(cin,password);
+	}
+	else
+	{
+		cout << "Type your brain wallet password: ";
+		getline(cin,password);
+		removePwd(1);
+	}
+	KryptKey key;
+	kryptKey(key, password);
 
-	// Get sha256 of password
-	int length = password.length();
-	uint8_t *source = new uint8_t[length];
-	for (int i=0; i<length; i++)
-		source[i] = password[i];
-	uint8_t hashBuf[32];
-	computeSHA256(source, length, hashBuf);
-	delete [] source;
+	// Without -o, name.krypt becomes name and anything else becomes name.krypt
+	int ret = 0;
+	for (size_t i=0; i<files.size(); i++)
+	{
+		string out = output;
+		if (out.empty())
+		{
+			const string ext = ".krypt";
+			if (files[i].size() > ext.size() && files[i].compare(files[i].size() - ext.size(), ext.size(), ext) == 0)
+				out = files[i].substr(0, files[i].size() - ext.size());
+			else
+				out = files[i] + ext;
+		}
+		int r = kryptFile(key, files[i], out);
+		if (r == -2)
+		{
+			cerr << out << " already exists, not replacing it" << endl;
+			ret = 1;
+		}
+		else if (r != 0)
+		{
+			cerr << "Unable to process " << files[i] << endl;
+			ret = 1;
+		}
+	}
+	return ret;
+}
+
+// Read one password per line
+bool readPasswords(const string &path, vector<string> &passwords)
+{
+	ifstream file(path);
+	if (!file)
+		return false;
+	string line;
+	while (getline(file,line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		passwords.push_back(line);
+	}
+	return true;
+}
 
-	// Define variables for loop
-	string etaStr, etaTotal;
-	mpz_class limit, j, interval, intern;
+// Index a directory of wallet files
+// Usage: ChainWallet index <dir> <passwords-file> <index-file> [threads]
+int indexCommand(int argc, char **argv)
+{
+	if (argc < 5)
+	{
+		cout << "Usage: ChainWallet index <dir> <passwords-file> <index-file> [threads]" << endl;
+		return 1;
+	}
+	vector<string> passwords;
+	if (!readPasswords(argv[3], passwords))
+	{
+		cout << "Unable to read " << argv[3] << endl;
+		return 1;
+	}
+	int threads = argc > 5 ? atoi(argv[5]) : (int)thread::hardware_concurrency();
+	IndexStats stats;
 	auto start = high_resolution_clock::now();
-	uint8_t src[32];
+	if (!buildIndex(argv[2], passwords, argv[4], threads, stats))
+	{
+		cout << "Unable to write " << argv[4] << endl;
+		return 1;
+	}
+	auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+	cout << "Files: " << stats.files << ", decrypted: " << stats.matched << ", addresses: " << stats.entries;
+	cout << ", time: " << elapsed << " ms" << endl;
+	return 0;
+}
 
-	// Calculate exponent
-	mpz_ui_pow_ui (limit.get_mpz_t(), b, n);
-	interval = limit / 1000;
+// Find the wallet file of addresses in an index
+// Usage: ChainWallet lookup <index-file> <address>...
+int lookupCommand(int argc, char **argv)
+{
+	if (argc < 4)
+	{
+		cout << "Usage: ChainWallet lookup <index-file> <address>..." << endl;
+		return 1;
+	}
+	int ret = 0;
+	for (int i=3; i<argc; i++)
+	{
+		IndexEntry e;
+		int found = lookupIndex(argv[2], argv[i], e);
+		if (found < 0)
+		{
+			cout << "Unable to read " << argv[2] << endl;
+			return 1;
+		}
+		if (found == 0)
+		{
+			cout << argv[i] << " - not found" << endl;
+			ret = 1;
+			continue;
+		}
+		cout << e.address << " - " << e.file << " - " << e.base << "^" << e.exponent << " - " << e.eta << endl;
+	}
+	return ret;
+}
+
+// Index the hash160s of a UTXO dump
+// Usage: ChainWallet utxo-index <dump> <index-file>
+int utxoIndexCommand(int argc, char **argv)
+{
+	if (argc != 4)
+	{
+		cout << "Usage: ChainWallet utxo-index <dump> <index-file>" << endl;
+		return 1;
+	}
+	Hash160Stats stats;
+	auto start = high_resolution_clock::now();
+	if (!buildHash160Index(argv[2], argv[3], stats))
+	{
+		cout << "Unable to index " << argv[2] << " into " << argv[3] << endl;
+		return 1;
+	}
+	auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+	cout << "Lines: " << stats.lines << ", with hash160: " << stats.hashes << ", unique: " << stats.unique;
+	cout << ", time: " << elapsed << " ms" << endl;
+	return 0;
+}
+
+// A public key derived for the audit and where it came from
+struct AuditKey
+{
+	uint8_t pub[33];
+	uint32_t wallet;	// Line of the mnemonic
+	int scheme;			// HDScheme, or -1 for the wallet key itself
+	uint32_t account, chain, index;
+};
+
+// Check wallets and their HD children against a UTXO index. Reads one mnemonic per line.
+// Usage: ChainWallet audit <index-file> [count] [accounts]
+int auditCommand(int argc, char **argv)
+{
+	int count = argc > 3 ? atoi(argv[3]) : 20;
+	int accounts = argc > 4 ? atoi(argv[4]) : 1;
+	if (argc < 3 || argc > 5 || count <= 0 || accounts <= 0)
+	{
+		cout << "Usage: ChainWallet audit <index-file> [count] [accounts]" << endl;
+		return 1;
+	}
+	Hash160Index index;
+	if (!index.open(argv[2]))
+	{
+		cout << "Unable to read " << argv[2] << endl;
+		return 1;
+	}
+
+	// Mnemonics in batches, so their seeds share the vector PBKDF2 and their keys one probe call
+	const size_t batch = 64;
+	static const uint32_t purposes[3] = {44, 49, 84};
+	uint64_t wallets = 0, probes = 0, hits = 0;
+	double deriveTime = 0, probeTime = 0;
+	uint32_t line = 0;
+	string text;
+	bool more = true;
+	while (more)
+	{
+		vector<string> mnemonics;
+		vector<uint32_t> lines;
+		while (mnemonics.size() < batch && (more = (bool)getline(cin, text)))
+		{
+			line++;
+			if (!text.empty() && text.back() == '\r')
+				text.pop_back();
+			if (text.empty())
+				continue;
+			uint8_t entropy[32];
+			size_t entropyLen;
+			if (fromBIP39(text, entropy, &entropyLen) != 0)
+			{
+				cout << "Line " << line << " - invalid mnemonic" << endl;
+				continue;
+			}
+			mnemonics.push_back(text);
+			lines.push_back(line);
+		}
+		if (mnemonics.empty())
+			continue;
+
+		auto t0 = high_resolution_clock::now();
+		vector<uint8_t> seeds(64 * mnemonics.size());
+		mnemonicToSeedBatch(mnemonics, "", (uint8_t (*)[64])seeds.data());
+		vector<AuditKey> keys;
+		vector<uint8_t> pubs(33 * count);
+		for (size_t w=0; w<mnemonics.size(); w++)
+		{
+			// The entropy of a ChainWallet mnemonic is the private key of the wallet
+			AuditKey k;
+			uint8_t entropy[32];
+			size_t entropyLen;
+			fromBIP39(mnemonics[w], entropy, &entropyLen);
+			k.wallet = lines[w];
+			k.scheme = -1;
+			k.account = k.chain = k.index = 0;
+			if (entropyLen == 32 && ecPubkey(entropy, k.pub))
+				keys.push_back(k);
+			memset(entropy, 0, sizeof(entropy));
+
+			ExtKey master, acct, chain;
+			if (!hdMaster(&seeds[64*w], 64, master))
+				continue;
+			for (int s=HD_BIP44; s<=HD_BIP84; s++)
+				for (int a=0; a<accounts; a++)
+				{
+					uint32_t path[3] = {purposes[s] | HD_HARDENED, 0 | HD_HARDENED, (uint32_t)a | HD_HARDENED};
+					if (!hdDerive(master, path, 3, acct))
+						continue;
+					for (uint32_t c=0; c<2; c++)
+					{
+						if (!hdChild(acct, c, chain) || !hdChildPubBatch(chain, 0, count, (uint8_t (*)[33])pubs.data()))
+							continue;
+						for (int i=0; i<count; i++)
+						{
+							memcpy(k.pub, &pubs[33*i], 33);
+							k.scheme = s;
+							k.account = a;
+							k.chain = c;
+							k.index = i;
+							keys.push_back(k);
+						}
+					}
+				}
+			memset(&master, 0, sizeof(master));
+			memset(&acct, 0, sizeof(acct));
+		}
+		memset(seeds.data(), 0, seeds.size());
+
+		// Every key as its key hash (P2PKH, P2WPKH) and the script hash of its P2SH-P2WPKH
+		vector<Hash160> hashes(2 * keys.size());
+		uint8_t script[22] = {0x00, 0x14};
+		for (size_t i=0; i<keys.size(); i++)
+		{
+			hash160(keys[i].pub, 33, hashes[2*i].b);
+			memcpy(script + 2, hashes[2*i].b, 20);
+			hash160(script, 22, hashes[2*i+1].b);
+		}
+		auto t1 = high_resolution_clock::now();
+		vector<uint8_t> found(hashes.size());
+		hits += index.probe(hashes.data(), hashes.size(), found.data());
+		auto t2 = high_resolution_clock::now();
+		deriveTime += duration<double>(t1 - t0).count();
+		probeTime += duration<double>(t2 - t1).count();
+		wallets += mnemonics.size();
+		probes += hashes.size();
+
+		for (size_t i=0; i<keys.size(); i++)
+		{
+			if (!found[2*i] && !found[2*i+1])
+				continue;
+			const AuditKey &k = keys[i];
+			string path = k.scheme < 0 ? "wallet key" : "m/" + to_string(purposes[k.scheme]) + "'/0'/" +
+			              to_string(k.account) + "'/" + to_string(k.chain) + "/" + to_string(k.index);
+			if (found[2*i])
+				cout << "Line " << k.wallet << " - " << path << " - " << addrP2PKH(k.pub) << " / " << addrP2WPKH(k.pub) << " - funded" << endl;
+			if (found[2*i+1])
+				cout << "Line " << k.wallet << " - " << path << " - " << addrP2SHP2WPKH(k.pub) << " - funded" << endl;
+		}
+	}
+	cout << "Wallets: " << wallets << ", probes: " << probes << ", funded: " << hits;
+	cout << fixed << setprecision(0) << ", derive: " << (deriveTime > 0 ? probes / 2 / deriveTime : 0) << " keys/s";
+	cout << ", probe: " << (probeTime > 0 ? probes / probeTime : 0) << "/s" << endl;
+	return 0;
+}
+
+// Check saved wallets without running the chain
+// Usage: ChainWallet verify [-p passwords-file] [-t threads] file-or-dir...
+int verifyCommand(int argc, char **argv)
+{
+	string passwordFile;
+	int threads = thread::hardware_concurrency();
+	vector<string> files;
+	for (int i=2; i<argc; i++)
+	{
+		string arg = argv[i];
+		struct stat st;
+		if (arg == "-p" && i+1 < argc)
+			passwordFile = argv[++i];
+		else if (arg == "-t" && i+1 < argc)
+			threads = atoi(argv[++i]);
+		else if (stat(arg.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+			findKryptFiles(arg, files);
+		else
+			files.push_back(arg);
+	}
+	if (files.empty())
+	{
+		cout << "Usage: ChainWallet verify [-p passwords-file] [-t threads] file-or-dir..." << endl;
+		return 1;
+	}
+
+	// Passwords come from a file or a single prompt
+	vector<string> passwords;
+	if (!passwordFile.empty())
+	{
+		if (!readPasswords(passwordFile, passwords))
+		{
+			cout << "Unable to read " << passwordFile << endl;
+			return 1;
+		}
+	}
+	else
+	{
+		string password;
+		cout << "Type your brain wallet password: ";
+		getline(cin,password);
+		removePwd(1);
+		passwords.push_back(password);
+	}
+	WalletKeys keys;
+	walletKeys(passwords, threads, keys);
+
+	auto start = high_resolution_clock::now();
+	vector<string> report(files.size());
+	vector<char> good(files.size(), 0);
+	parallelFor(files.size(), threads, [&](size_t i)
+	{
+		TRACE_SPAN_ARG("verify", files[i]);
+		WalletFile w;
+		if (!openWallet(files[i], keys, w))
+		{
+			report[i] = "FAIL " + files[i] + " - unable to decrypt";
+			return;
+		}
+		VerifyResult r = verifyWallet(files[i], w);
+		good[i] = r.ok;
+		if (!r.ok)
+			report[i] = "FAIL " + files[i] + " - " + r.error;
+		else if (!r.hasPrivate)
+			report[i] = "OK   " + files[i] + " - public data only";
+		else
+			report[i] = "OK   " + files[i];
+	});
+
+	size_t failed = 0;
+	for (size_t i=0; i<files.size(); i++)
+	{
+		cout << report[i] << endl;
+		failed += !good[i];
+	}
+	auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+	cout << files.size() - failed << " of " << files.size() << " wallets verified in " << elapsed << " ms" << endl;
+	return failed ? 1 : 0;
+}
+
+// Show rate and remaining time of a long loop. Returns false until some time has passed.
+bool showProgress(const mpz_class &done, const mpz_class &limit, high_resolution_clock::time_point start, const char *unit, string &etaTotal)
+{
+	auto end = high_resolution_clock::now();
+	auto elapsed = duration_cast<milliseconds>(end-start).count();
+	if (elapsed <= 0) // For the case you can process more than 1Gh
+		return false;
+	double rate = done.get_ui()*1000/elapsed;
+	mpz_class eta = (limit-done) / rate;
+	mpz_class etaEnd = limit / rate;
+	etaTotal = toYDHMS(etaEnd.get_ui());
+	cout << "Rate: " << rate << " " << unit << ", Remaining: " << toYDHMS(eta.get_ui()) << endl;
+	return true;
+}
+
+// Pick the fastest SHA-256 kernel for the chain, cached in CHAINWALLET_SHA256_CACHE or ~/.chainwallet-sha256
+void tuneSHA256()
+{
+	const char *cache = getenv("CHAINWALLET_SHA256_CACHE");
+	const char *home = getenv("HOME");
+	string path = cache ? cache : home ? string(home) + "/.chainwallet-sha256" : "";
+	sha256_autotune(path.empty() ? NULL : path.c_str());
+	string error;
+	if (!hashBackendFromEnvironment(error))
+		cout << error << ", using " << hashBackend->name << endl;
+}
+
+// Kernel shown in the live status
+string kernelName()
+{
+	if (hashBackendCurrent() != hashBackendFind("accelerated"))
+		return string("sha256 ") + hashBackend->name;
+	return string("sha256 ") + sha256_kernel_name(sha256_kernel_current());
+}
+
+// Cross-check the hash backends on random inputs and time their chain step
+// Usage: ChainWallet selftest [rounds]
+int selftestCommand(int argc, char **argv)
+{
+	int rounds = argc > 2 ? atoi(argv[2]) : 100000;
+	if (argc > 3 || rounds <= 0)
+	{
+		cout << "Usage: ChainWallet selftest [rounds]" << endl;
+		return 1;
+	}
+	tuneSHA256();
+	random_device rd;
+	uint64_t seed = ((uint64_t)rd() << 32) | rd();
+	cout << "Comparing SHA256, RIPEMD160 and SHA512 of " << rounds << " random inputs with the reference (seed ";
+	cout << seed << ")" << endl;
+	int failed = 0;
+	for (int i=0; i<hashBackendCount(); i++)
+	{
+		const HashBackend &b = hashBackendAt(i);
+		printf("%-12s ", b.name);
+		if (!b.available())
+		{
+			printf("not available\n");
+			continue;
+		}
+		int mismatches = hashBackendMismatches(i, rounds, seed);
+		bool usable = hashBackendUsable(i);
+		failed += mismatches != 0 || !usable;
+		printf("%s, %d mismatches, %.1f ns per chain step%s\n", usable ? "known answers right" : "FAILED", mismatches,
+		       hashBackendStepTime(i), i == hashBackendCurrent() ? " (selected)" : "");
+	}
+	return failed ? 1 : 0;
+}
+
+// Save hash number at of a chain that was stopped in a new transcript, for create -r.
+// Returns its name, or an empty string if it could not be written.
+string saveCheckpoint(const uint8_t firstHash[32], const mpz_class &at, const uint8_t hashBuf[32])
+{
+	string path = "chainwallet-" + to_string(getpid()) + ".transcript";
+	FILE *f = openTranscript(path, false);
+	if (f == NULL)
+	{
+		cout << "Unable to save the checkpoint in " << path << endl;
+		return "";
+	}
+	fprintf(f, "1 %s\n", hash2str(firstHash, 32).c_str());
+	if (at > 1)
+		gmp_fprintf(f, "%Zd %s\n", at.get_mpz_t(), hash2str(hashBuf, 32).c_str());
+	if (fclose(f) != 0)
+	{
+		cout << "Unable to save the checkpoint in " << path << endl;
+		return "";
+	}
+	return path;
+}
+
+// Hash the chain steps more times on a cw_engine from hash number index, showing the rate from time to time.
+// Returns the steps done, fewer than asked if SIGINT or SIGTERM stopped the loop.
+mpz_class runChain(uint8_t hashBuf[32], const mpz_class &index, const mpz_class &steps, bool print, string &etaTotal, TranscriptWriter *transcript=NULL,
+                   HashTraceWriter *trace=NULL)
+{
+	mpz_class j = 0, interval, intern;
+	auto start = high_resolution_clock::now();
+	auto lastVerbose = start;
+	char line[64];
+	interval = steps / 1000;
 	intern = interval;
 
-	// Run chain loop
-	cout << endl << "Generating sha256(sha256(sha256(...sha256(password)...)))" << endl;
-	cout << "If N is big, it will take a long time" << endl << endl;;
-	if (p == 'y' or p == 'Y')
-		cout << hash2str(hashBuf, 32) << endl;
-	for (j=0; j<limit-1; j++)
-	{
-		for (int i=0; i<32; i++)
-			src[i] = hashBuf[i];
-		computeSHA256(src, 32, hashBuf);
-		if (p == 'y' or p == 'Y')
-			cout << hash2str(hashBuf, 32) << endl;
-		if (j == 1000000 || (j>1000000 && j == intern))
+	// Every hash goes to the transcript, the trace and the screen when they are asked for
+	function<void(const uint8_t *)> observe = [&](const uint8_t *hash)
+	{
+		if (transcript)
+			transcript->step(hash);
+		if (trace)
+			trace->step(hash);
+		if (print)
+		{
+			hexEncode(hash, 32, line);
+			cout.write(line, 64) << '\n';
+		}
+	};
+	unique_ptr<cw_engine, void (*)(cw_engine *)> engine(cw_engine_new(), cw_engine_free);
+	if (!engine)
+		return 0;
+
+	// Other processes watch the loop through shared memory; here it is only a store every 4096 hashes
+	LiveStatus status("chain", mpz_sizeinbase(steps.get_mpz_t(), 2) > 64 ? UINT64_MAX : steps.get_ui(), kernelName().c_str());
+	if (transcript)
+		transcript->publish(&status.checkpoint);
+	string placed = placeHelperThreads();
+	if (!placed.empty())
+		cout << placed << ", going on without" << endl;
+	installChainSignals();
+	uint64_t count = 0;
+	bool stop = false;
+	while (j < steps && !stop)
+	{
+		// The engine counts in 64 bits, so a longer chain runs as several
+		mpz_class left = steps - j;
+		uint64_t segment = mpz_sizeinbase(left.get_mpz_t(), 2) > 62 ? (uint64_t)1 << 62 : left.get_ui();
+		cw_engine_resume(engine.get(), hashBuf, 1, segment + 1);
+		uint64_t done = 1;
+		int state = CW_RUNNING;
+		while (state == CW_RUNNING && !stop)
 		{
-			auto end = high_resolution_clock::now();
-			auto elapsed = duration_cast<milliseconds>(end-start).count();
-			if (elapsed > 0) // For the case you can process more than 1Gh
+			state = cwEngineStep(engine.get(), 4096, transcript || trace || print ? &observe : NULL);
+			uint64_t before = done;
+			cw_engine_state(engine.get(), hashBuf, &done);
+			mpz_class from = j;
+			j += done - before;
+			count += done - before;
+			status.done.store(count, memory_order_relaxed);
+
+			// Signals and the verbose progress are looked at once per block
+			if (chainSignals.load(memory_order_relaxed) != 0)
+			{
+				int pending = chainSignals.exchange(0);
+				if (pending & CHAIN_VERBOSE)
+					cout << "Progress every second " << (chainVerbose.load() ? "on" : "off") << endl;
+				if (pending & CHAIN_STATUS)
+				{
+					cout << "Iteration " << index + j << " of " << index + steps << ", ";
+					if (!showProgress(j, steps, start, "hash/s", etaTotal))
+						cout << endl;
+				}
+				stop = pending & CHAIN_STOP;
+			}
+			if (chainVerbose.load(memory_order_relaxed) && high_resolution_clock::now() - lastVerbose >= seconds(1))
+			{
+				lastVerbose = high_resolution_clock::now();
+				cout << "Iteration " << index + j << " of " << index + steps << ", ";
+				showProgress(j, steps, start, "hash/s", etaTotal);
+			}
+			if ((from <= 1000000 && j > 1000000) || (j > 1000000 && from <= intern && j > intern))
 			{
-				double rate = j.get_ui()*1000/elapsed;
-				mpz_class eta = (limit-j) / rate;
-				mpz_class etaEnd = limit / rate;
-				etaStr = toYDHMS(eta.get_ui());
-				etaTotal = toYDHMS(etaEnd.get_ui());
-				cout << "Rate: " << rate << " hash/s, Remaining: " << etaStr << endl;
-				intern += interval;
+				if (showProgress(j, steps, start, "hash/s", etaTotal))
+					while (intern < j)
+						intern += interval;
 			}
 		}
 	}
-	cout << endl;
+	restoreChainSignals();
+	if (print)
+		cout.flush();
+	if (trace)
+		trace->flush();
+	if (transcript)
+	{
+		if (j < steps)
+			transcript->flush(hashBuf);
+		transcript->publish(NULL);
+	}
+	return j;
+}
 
+// Derive every key and address from the end of the chain and save the wallet.
+// Returns the compressed address, or an empty string if the wallet could not be saved.
+string finishWallet(const string &password, int b, int n, const uint8_t hashBuf[32], const string &etaTotal, const string &extra="",
+                    PerfCounters *perf=NULL)
+{
 	// Create Private Key
+	TRACE_SPAN("finishWallet");
+	TRACE_STAGES(stages);
+	TRACE_NEXT(stages, "key reduction");
+	if (perf) perf->begin("private key");
 	string bufStr = hash2str(hashBuf, 32);
 	mpz_class t(bufStr,16);
 	if (t >= secp256k1.N) t = t - secp256k1.N;
 	GF sk(t,secp256k1.P);
 
 	// Convert private key to WIF (compressed)
+	TRACE_NEXT(stages, "sk2wif");
 	char privBuf[65];
 	gmp_sprintf(privBuf, "%Z064x", sk.getNum().get_mpz_t());
 	string wifC = sk2wif(privBuf,true);
 
 	// Get Public Key
+	TRACE_NEXT(stages, "priv2pub");
+	if (perf) perf->begin("public key");
 	point pk = priv2pub(sk);
 
 	// Convert public key to address (compressed)
+	TRACE_NEXT(stages, "address");
+	if (perf) perf->begin("addresses", 2);
 	char pubBuf[131];
 	gmp_sprintf(pubBuf, "04%Z064x%Z064x", pk.x.getNum().get_mpz_t(), pk.y.getNum().get_mpz_t());
 	string pubC = binary2Addr(splitXY(pubBuf,pk));
 
 	// Create Segwit P2SH(P2WPKH) address
+	TRACE_NEXT(stages, "segwit");
 	string seg = encodeBase58Check(mainnetChecksum("05",hash160("0014"+hash160(splitXY(pubBuf,pk))),false));
 
 	// Create BIP39 mnemonic
+	TRACE_NEXT(stages, "toBIP39");
+	if (perf) perf->begin("mnemonic");
 	string mnemonic = toBIP39(privBuf);
 
+	// Derive BIP39 seed (empty passphrase)
+	TRACE_NEXT(stages, "mnemonicToSeed");
+	if (perf) perf->begin("seed");
+	uint8_t seedBuf[64];
+	mnemonicToSeed(mnemonic, "", seedBuf);
+	string seed = hash2str(seedBuf, 64);
+
 	// Show all calculated info
-	saveKey(password,b,n,privBuf,mnemonic,wifC,pubC,seg,etaTotal);
+	TRACE_NEXT(stages, "saveKey");
+	if (perf) perf->begin("save");
+	bool saved = saveKey(password,b,n,privBuf,mnemonic,seed,wifC,pubC,seg,etaTotal,extra);
+	if (perf) perf->end();
+	return saved ? pubC : "";
+}
+
+// Create a wallet locked by an RSW time-lock puzzle of B^N squarings.
+// Only the modulus is kept, so recovering the keys takes the squarings one by one.
+// Usage: ChainWallet timelock
+int timelockCommand(int argc, char **argv)
+{
+	string password;
+	int n, b;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the base of the number of squarings (B^N). B = ";
+	cin >> b;
+	cout << "Type the exponent of the number of squarings (" << b << "^N). N = ";
+	cin >> n;
+	removePwd(3);
+	if (b < 2 || n < 1)
+	{
+		cout << "B must be at least 2 and N at least 1" << endl;
+		return 1;
+	}
+
+	uint8_t hashBuf[32];
+	computeSHA256((const uint8_t*)password.data(), password.size(), hashBuf);
+	mpz_class limit, modulus, solution;
+	mpz_ui_pow_ui(limit.get_mpz_t(), b, n);
+
+	// The factorization turns B^N squarings into two exponentiations
+	auto start = high_resolution_clock::now();
+	timeLockCreate(hashBuf, limit, 2048, modulus, solution);
+	auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+	cout << "Puzzle created in " << elapsed << " ms" << endl;
+
+	// Estimate the time of the recovery on this machine
+	const uint64_t sample = 100000;
+	TimeLockSquarer probe(modulus, timeLockBase(hashBuf, modulus));
+	start = high_resolution_clock::now();
+	probe.square(sample);
+	auto us = duration_cast<microseconds>(high_resolution_clock::now()-start).count();
+	mpz_class eta = limit * max<int64_t>(us, 1) / sample / 1000000;
+	string etaTotal = toYDHMS(eta.get_ui());
+	cout << "Recovery takes about " << etaTotal << " on this machine" << endl << endl;
+
+	uint8_t key[32];
+	timeLockKey(solution, modulus, key);
+	string extra = "Time-lock modulus (hex)      - " + modulus.get_str(16) + "\n";
+	string pubC = finishWallet(password,b,n,key,etaTotal,extra);
+	memset(key, 0, sizeof(key));
+	return pubC.empty() ? 1 : 0;
+}
+
+// Solve the time-lock puzzle of a wallet file and save its keys again
+// Usage: ChainWallet timelock-recover <file.krypt>
+int timelockRecoverCommand(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		cout << "Usage: ChainWallet timelock-recover <file.krypt>" << endl;
+		return 1;
+	}
+	string password;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	removePwd(1);
+
+	KryptKey kk;
+	kryptKey(kk, password);
+	WalletFile w;
+	if (!readWallet(argv[2], kk, w))
+	{
+		cout << "Unable to decrypt " << argv[2] << endl;
+		return 1;
+	}
+	mpz_class modulus;
+	int b = atoi(w.base.c_str()), n = atoi(w.exponent.c_str());
+	if (w.timeLockModulus.empty() || modulus.set_str(w.timeLockModulus, 16) != 0 || modulus < 3 ||
+	    mpz_even_p(modulus.get_mpz_t()) || b < 2 || n < 1)
+	{
+		cout << argv[2] << " is not a time-lock wallet" << endl;
+		return 1;
+	}
+
+	uint8_t hashBuf[32];
+	computeSHA256((const uint8_t*)password.data(), password.size(), hashBuf);
+	mpz_class limit, done;
+	mpz_ui_pow_ui(limit.get_mpz_t(), b, n);
+
+	// Squarings go in blocks of about a second, with the rate shown after each one
+	cout << endl << "Computing x^(2^" << b << "^" << n << ") mod n" << endl;
+	cout << "If N is big, it will take a long time" << endl << endl;
+	const unsigned long block = 1 << 19;
+	string etaTotal;
+	TimeLockSquarer sq(modulus, timeLockBase(hashBuf, modulus));
+	LiveStatus status("time-lock", limit.fits_ulong_p() ? limit.get_ui() : UINT64_MAX, "montgomery mpn");
+	auto start = high_resolution_clock::now();
+	while (done < limit)
+	{
+		mpz_class left = limit - done;
+		unsigned long count = left < block ? left.get_ui() : block;
+		sq.square(count);
+		done += count;
+		status.done.fetch_add(count, memory_order_relaxed);
+		if (done < limit)
+			showProgress(done, limit, start, "squarings/s", etaTotal);
+	}
+	cout << endl;
+
+	uint8_t key[32];
+	timeLockKey(sq.value(), modulus, key);
+	string extra = "Time-lock modulus (hex)      - " + w.timeLockModulus + "\n";
+	string pubC = finishWallet(password,b,n,key,w.eta,extra);
+	memset(key, 0, sizeof(key));
+	if (pubC.empty())
+		return 1;
+	if (pubC != w.pubC)
+	{
+		cout << "Recovered key does not match " << w.pubC << endl;
+		return 1;
+	}
+	return 0;
 }
 
+// Create a wallet from a Wesolowski VDF of B^N squarings. The proof saved with it lets
+// verify check the delay in milliseconds.
+// Usage: ChainWallet vdf
+int vdfCommand(int argc, char **argv)
+{
+	string password;
+	int n, b;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the base of the number of squarings (B^N). B = ";
+	cin >> b;
+	cout << "Type the exponent of the number of squarings (" << b << "^N). N = ";
+	cin >> n;
+	removePwd(3);
+	mpz_class limit, done;
+	if (b >= 2 && n >= 1)
+		mpz_ui_pow_ui(limit.get_mpz_t(), b, n);
+	if (limit < 1 || mpz_sizeinbase(limit.get_mpz_t(), 2) > 63)
+	{
+		cout << "B^N must be between 2 and 2^63" << endl;
+		return 1;
+	}
+
+	uint8_t hashBuf[32];
+	computeSHA256((const uint8_t*)password.data(), password.size(), hashBuf);
+	const mpz_class &modulus = vdfModulus();
+	mpz_class x = timeLockBase(hashBuf, modulus);
+
+	// Evaluation: the sequential part, keeping what the proof needs
+	cout << endl << "Computing y = x^(2^" << b << "^" << n << ") mod RSA-2048" << endl;
+	cout << "If N is big, it will take a long time" << endl << endl;
+	const unsigned long block = 1 << 19;
+	string etaTotal, etaProof;
+	VdfProver prover(x, limit.get_ui());
+	auto start = high_resolution_clock::now();
+	{
+		LiveStatus status("vdf", limit.get_ui(), "montgomery mpn");
+		while (prover.step(block))
+		{
+			done += block;
+			status.done.fetch_add(block, memory_order_relaxed);
+			showProgress(done, limit, start, "squarings/s", etaTotal);
+		}
+	}
+	mpz_class y = prover.output();
+	if (etaTotal.empty())
+		etaTotal = toYDHMS(duration_cast<seconds>(high_resolution_clock::now()-start).count());
+
+	// Proof: about B^N/10 multiplications with the powers kept on the way
+	cout << endl << "Computing the proof" << endl << endl;
+	mpz_class groups = (unsigned long)prover.groups();
+	LiveStatus status("vdf proof", prover.groups(), "montgomery mpn");
+	start = high_resolution_clock::now();
+	done = 0;
+	while (prover.prove())
+	{
+		done += 1;
+		status.done.fetch_add(1, memory_order_relaxed);
+		if (done % 64 == 0)
+			showProgress(done, groups, start, "groups/s", etaProof);
+	}
+	mpz_class proof = prover.proof();
+	cout << endl;
+
+	uint8_t key[32];
+	timeLockKey(y, modulus, key);
+	string extra = "VDF output (hex)             - " + y.get_str(16) + " - It should be deleted\n";
+	extra += "VDF proof (hex)              - " + proof.get_str(16) + "\n";
+	string pubC = finishWallet(password,b,n,key,etaTotal,extra);
+	memset(key, 0, sizeof(key));
+	return pubC.empty() ? 1 : 0;
+}
+
+// Create a wallet from K chains of B^N/K hashes run side by side
+// Usage: ChainWallet lanes [K]
+int lanesCommand(int argc, char **argv)
+{
+	int k = argc > 2 ? atoi(argv[2]) : thread::hardware_concurrency();
+	if (argc > 3 || k < 1 || k > 1024)
+	{
+		cout << "Usage: ChainWallet lanes [K]" << endl;
+		return 1;
+	}
+	string password;
+	int n, b;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the base of chain length (B^N). B = ";
+	cin >> b;
+	cout << "Type the exponent of chain length (" << b << "^N). N = ";
+	cin >> n;
+	removePwd(3);
+	mpz_class limit;
+	if (b >= 2 && n >= 1)
+		mpz_ui_pow_ui(limit.get_mpz_t(), b, n);
+	if (limit < k || mpz_sizeinbase(limit.get_mpz_t(), 2) > 63)
+	{
+		cout << "B^N must be between K and 2^63" << endl;
+		return 1;
+	}
+
+	uint8_t hashBuf[32];
+	computeSHA256((const uint8_t*)password.data(), password.size(), hashBuf);
+	tuneSHA256();
+
+	// The lanes run on their own threads, this one only shows the progress
+	cout << endl << "Generating " << k << " chains of sha256(sha256(sha256(...sha256(lane)...)))" << endl;
+	cout << "If N is big, it will take a long time" << endl << endl;
+	string etaTotal;
+	mpz_class interval = limit / 1000, intern = 1000000;
+	auto start = high_resolution_clock::now();
+	ChainLanes lanes(hashBuf, limit.get_ui(), k);
+	LiveStatus status("lanes", limit.get_ui(), kernelName().c_str());
+	while (!lanes.finished())
+	{
+		this_thread::sleep_for(milliseconds(100));
+		status.done.store(lanes.done(), memory_order_relaxed);
+		mpz_class j = (unsigned long)lanes.done();
+		if (j >= intern && j < limit && showProgress(j, limit, start, "hash/s", etaTotal))
+			intern = j + interval;
+	}
+	cout << endl;
+	if (etaTotal.empty())
+		etaTotal = toYDHMS(duration_cast<seconds>(high_resolution_clock::now()-start).count());
+
+	uint8_t key[32];
+	lanes.key(key);
+	string extra = "Chain lanes                  - " + to_string(k) + "\n";
+	string pubC = finishWallet(password,b,n,key,etaTotal,extra);
+	memset(key, 0, sizeof(key));
+	return pubC.empty() ? 1 : 0;
+}
+
+// Make the chain of a wallet longer, starting from its end state instead of the password.
+// The result is the same wallet a fresh run with the new B^N gives.
+// Usage: ChainWallet extend <file.krypt>
+int extendCommand(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		cout << "Usage: ChainWallet extend <file.krypt>" << endl;
+		return 1;
+	}
+	string password;
+	int n, b;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the new base of chain length (B^N). B = ";
+	cin >> b;
+	cout << "Type the new exponent of chain length (" << b << "^N). N = ";
+	cin >> n;
+	removePwd(3);
+
+	KryptKey kk;
+	kryptKey(kk, password);
+	WalletFile w;
+	if (!readWallet(argv[2], kk, w))
+	{
+		cout << "Unable to decrypt " << argv[2] << endl;
+		return 1;
+	}
+	if (!w.timeLockModulus.empty() || !w.vdfProof.empty() || !w.lanes.empty())
+	{
+		cout << "Only single chain wallets can be extended" << endl;
+		return 1;
+	}
+
+	// The end state, or the private key when it was not reduced mod N
+	uint8_t hashBuf[32];
+	if (!w.endState.empty())
+	{
+		if (w.endState.size() != 64 || hexDecode(w.endState.data(), 32, hashBuf) != 0)
+		{
+			cout << "Invalid chain end state" << endl;
+			return 1;
+		}
+	}
+	else
+	{
+		mpz_class t;
+		if (w.privHex.size() != 64 || t.set_str(w.privHex, 16) != 0)
+		{
+			cout << argv[2] << " has neither the chain end state nor the private key" << endl;
+			return 1;
+		}
+		mpz_class top = 1;
+		mpz_mul_2exp(top.get_mpz_t(), top.get_mpz_t(), 256);
+		if (t + secp256k1.N < top)
+		{
+			cout << "The private key may have been reduced mod N, the chain end state is needed" << endl;
+			return 1;
+		}
+		hexDecode(w.privHex.data(), 32, hashBuf);
+	}
+
+	mpz_class oldLimit, limit;
+	mpz_ui_pow_ui(oldLimit.get_mpz_t(), atoi(w.base.c_str()), atoi(w.exponent.c_str()));
+	if (b >= 2 && n >= 1)
+		mpz_ui_pow_ui(limit.get_mpz_t(), b, n);
+	if (oldLimit < 1 || limit < oldLimit)
+	{
+		cout << "The new chain must not be shorter than " << w.base << "^" << w.exponent << endl;
+		return 1;
+	}
+
+	tuneSHA256();
+	cout << endl << "Extending the chain from " << w.base << "^" << w.exponent << " to " << b << "^" << n << endl;
+	cout << "If N is big, it will take a long time" << endl << endl;
+	string etaTotal;
+	auto start = high_resolution_clock::now();
+	mpz_class steps = limit - oldLimit;
+	mpz_class ran = runChain(hashBuf, oldLimit, steps, false, etaTotal);
+	cout << endl;
+
+	// Stopped by a signal: the wallet stays as it was and the chain can go on with create -r
+	if (ran < steps)
+	{
+		uint8_t firstHash[32];
+		computeSHA256(password.data(), password.size(), firstHash);
+		mpz_class at = oldLimit + ran;
+		string path = saveCheckpoint(firstHash, at, hashBuf);
+		if (path.empty())
+			return 1;
+		cout << "Stopped at hash " << at << " of " << limit << ", " << argv[2] << " is unchanged" << endl;
+		cout << "Resume with: ChainWallet create -r " << path << endl;
+		return 1;
+	}
+
+	// Time of a fresh run at the rate just measured
+	auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+	if (steps > 0)
+	{
+		mpz_class total = limit * (unsigned long)elapsed / steps / 1000;
+		etaTotal = toYDHMS(total.get_ui());
+	}
+	else
+		etaTotal = w.eta;
+
+	string extra = "Chain end state (hex)        - " + hash2str(hashBuf, 32) + " - It should be deleted\n";
+	if (finishWallet(password,b,n,hashBuf,etaTotal,extra).empty())
+		return 1;
+	return 0;
+}
+
+// Cut a chain transcript into work units in a spool directory
+// Usage: ChainWallet units <transcript> <spool> [checkpoints per unit]
+int unitsCommand(int argc, char **argv)
+{
+	int per = argc > 4 ? atoi(argv[4]) : 1;
+	if (argc < 4 || argc > 5 || per < 1)
+	{
+		cout << "Usage: ChainWallet units <transcript> <spool> [checkpoints per unit]" << endl;
+		return 1;
+	}
+	long count = exportUnits(argv[2], argv[3], per);
+	if (count < 0)
+	{
+		cout << "Unable to export " << argv[2] << " to " << argv[3] << endl;
+		return 1;
+	}
+	cout << count << " work units written to " << argv[3] << endl;
+	return 0;
+}
+
+// Verify work units from a spool directory or a socket until none is left
+// Usage: ChainWallet worker <spool-or-socket>
+int workerCommand(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		cout << "Usage: ChainWallet worker <spool-or-socket>" << endl;
+		return 1;
+	}
+	string source = argv[2];
+	tuneSHA256();
+	struct stat st;
+	bool socket = stat(source.c_str(), &st) == 0 && S_ISSOCK(st.st_mode);
+	long done = 0, failed = 0;
+	WorkUnit unit;
+	if (!socket)
+		requeueStaleUnits(source, 0);	// Claims of dead workers on this host
+	while (socket ? requestUnit(source, unit) : claimUnit(source, unit))
+	{
+		uint8_t got[32];
+		auto start = high_resolution_clock::now();
+		bool ok = runUnit(unit, got);
+		auto elapsed = duration_cast<milliseconds>(high_resolution_clock::now()-start).count();
+		if (!(socket ? reportUnit(source, unit, ok, got) : finishUnit(source, unit, ok, got)))
+		{
+			cout << "Unable to store the result of " << unit.name << endl;
+			return 1;
+		}
+		cout << unit.name << (ok ? " ok   - " : " FAIL - ") << unit.end - unit.start << " hashes in " << elapsed << " ms" << endl;
+		done++;
+		failed += !ok;
+	}
+	cout << done << " units verified, " << failed << " failed" << endl;
+	return failed ? 1 : 0;
+}
+
+// Hand out the units of a spool to workers on a Unix socket
+// Usage: ChainWallet serve-units <spool> <socket> [claim timeout in seconds]
+int serveUnitsCommand(int argc, char **argv)
+{
+	int timeout = argc > 4 ? atoi(argv[4]) : 3600;
+	if (argc < 4 || argc > 5 || timeout < 0)
+	{
+		cout << "Usage: ChainWallet serve-units <spool> <socket> [claim timeout in seconds]" << endl;
+		return 1;
+	}
+	if (!serveUnits(argv[2], argv[3], timeout))
+	{
+		cout << "Unable to listen on " << argv[3] << endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Confirm that every unit of a spool passed and that they form one chain
+// Usage: ChainWallet merge <spool>
+int mergeCommand(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		cout << "Usage: ChainWallet merge <spool>" << endl;
+		return 1;
+	}
+	MergeReport r;
+	bool ok = mergeUnits(argv[2], r);
+	for (size_t i=0; i<r.problems.size(); i++)
+		cout << r.problems[i] << endl;
+	cout << r.ok << " of " << r.units << " units passed, " << r.bad << " failed, " << r.pending << " pending, " << r.gaps << " gaps" << endl;
+	if (ok)
+		cout << "Chain verified from hash " << r.first << " to hash " << r.last << endl;
+	return ok ? 0 : 1;
+}
+
+// Dump the hashes of a binary trace as "index hash" lines
+// Usage: ChainWallet trace <file> [from [to]]
+int traceCommand(int argc, char **argv)
+{
+	HashTraceReader reader;
+	if (argc < 3 || argc > 5)
+	{
+		cout << "Usage: ChainWallet trace <file> [from [to]]" << endl;
+		return 1;
+	}
+	if (!reader.open(argv[2]))
+	{
+		cout << "Unable to read the trace " << argv[2] << endl;
+		return 1;
+	}
+
+	// Without a range only the records are shown
+	uint64_t from = argc > 3 ? strtoull(argv[3], NULL, 10) : reader.first();
+	uint64_t to = argc > 4 ? strtoull(argv[4], NULL, 10) : argc > 3 ? from : reader.last();
+	uint64_t step = argc > 3 ? 1 : reader.every();
+	if (from < reader.first() || to > reader.last() || from > to)
+	{
+		cout << argv[2] << " holds hashes " << reader.first() << " to " << reader.last() << ", every " << reader.every() << endl;
+		return 1;
+	}
+	char line[96];
+	uint8_t hash[32];
+	for (uint64_t i=from; ; i+=step)
+	{
+		int len = snprintf(line, sizeof(line), "%" PRIu64 " ", i);
+		if (!reader.hash(i, hash))
+		{
+			cout << "Unable to read hash " << i << endl;
+			return 1;
+		}
+		hexEncode(hash, 32, line + len);
+		line[len + 64] = '\n';
+		cout.write(line, len + 65);
+		if (to - i < step)
+			break;
+	}
+	return 0;
+}
+
+// Show the live status of running chains, or save it in Prometheus text format
+// Usage: ChainWallet status [-p file] [pid...]
+int statusCommand(int argc, char **argv)
+{
+	string promFile;
+	vector<int> pids;
+	for (int i=2; i<argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "-p" && i+1 < argc)
+			promFile = argv[++i];
+		else if (atoi(argv[i]) > 0)
+			pids.push_back(atoi(argv[i]));
+		else
+		{
+			cout << "Usage: ChainWallet status [-p file] [pid...]" << endl;
+			return 1;
+		}
+	}
+	if (pids.empty())
+		pids = liveStatusPids();
+
+	vector<LiveStatusBlock> found;
+	for (size_t i=0; i<pids.size(); i++)
+	{
+		LiveStatusBlock s;
+		if (readLiveStatus(pids[i], s))
+			found.push_back(s);
+		else
+			cout << "No status for process " << pids[i] << endl;
+	}
+
+	if (!promFile.empty())
+	{
+		// Written aside and renamed, so a scraper never reads half a file
+		string tmp = promFile + ".tmp";
+		ofstream out(tmp);
+		out << liveStatusPrometheus(found);
+		out.close();
+		if (!out || rename(tmp.c_str(), promFile.c_str()) != 0)
+		{
+			cout << "Unable to write " << promFile << endl;
+			return 1;
+		}
+		return 0;
+	}
+	for (size_t i=0; i<found.size(); i++)
+	{
+		const LiveStatusBlock &s = found[i];
+		printf("%d %s (%s) - %" PRIu64 " of %" PRIu64 " (%.2f%%)\n", s.pid, s.mode, s.kernel, s.done, s.total,
+		       s.total ? 100.0 * s.done / s.total : 0);
+		printf("  Rate: %.0f/s (1s) %.0f/s (10s) %.0f/s (60s), Remaining: %s\n", s.rate1, s.rate10, s.rate60,
+		       toYDHMS(s.eta).c_str());
+		if (s.checkpoint)
+			printf("  Last checkpoint: %" PRIu64 ", %.0f s ago\n", s.checkpoint, s.checkpointAge);
+		if (s.migrations != UINT64_MAX)
+			printf("  CPU: %d, Migrations: %" PRIu64 ", Preemptions: %" PRIu64 "\n", s.cpu, s.migrations, s.preemptions);
+		else
+			printf("  CPU: %d, Preemptions: %" PRIu64 "\n", s.cpu, s.preemptions);
+	}
+	if (found.empty())
+		cout << "No running chains" << endl;
+	return found.empty() && !pids.empty() ? 1 : 0;
+}
+
+// Create a wallet from the password chain, optionally writing checkpoints for distributed verification
+// and showing hardware counters of the chain and of the steps after it
+// Usage: ChainWallet [create [-t transcript] [-e every] [-c]]
+int createCommand(int argc, char **argv)
+{
+	string transcriptPath, resumePath, tracePath;
+	uint64_t every = 1 << 20, traceEvery = 1;
+	bool counters = false;
+	CpuPlacement placement;
+	for (int i=2; i<argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "-P" || arg == "-S" || arg == "-s" || arg == "-n" || arg == "-m")
+		{
+			if (!parsePlacementOption(argc, argv, i, placement))
+				every = 0;
+		}
+		else if (arg == "-c")
+			counters = true;
+		else if (arg == "-t" && i+1 < argc)
+			transcriptPath = argv[++i];
+		else if (arg == "-r" && i+1 < argc)
+			resumePath = argv[++i];
+		else if (arg == "-e" && i+1 < argc)
+			every = strtoull(argv[++i], NULL, 10);
+		else if (arg == "-b" && i+1 < argc)
+			tracePath = argv[++i];
+		else if (arg == "-k" && i+1 < argc)
+			traceEvery = strtoull(argv[++i], NULL, 10);
+		else
+			every = 0;
+	}
+	if (every == 0 || traceEvery == 0)
+	{
+		cout << "Usage: ChainWallet create [-t transcript | -r transcript] [-e every] [-b trace] [-k every] [-c]" << endl;
+		cout << "                          [-P cpu|auto] [-S] [-s fifo[:priority]|batch|other] [-n nice] [-m]" << endl;
+		return 1;
+	}
+
+	// A stopped run goes on from the last checkpoint of its transcript, adding to it
+	uint64_t index = 1;
+	uint8_t firstHash[32], resumeHash[32];
+	if (!resumePath.empty())
+	{
+		if (!readTranscriptEnds(resumePath, firstHash, index, resumeHash))
+		{
+			cout << "Unable to resume from " << resumePath << endl;
+			return 1;
+		}
+		transcriptPath = resumePath;
+	}
+	unique_ptr<FILE, int (*)(FILE *)> transcriptFile(NULL, fclose);
+	if (!transcriptPath.empty())
+		transcriptFile.reset(openTranscript(transcriptPath, !resumePath.empty()));
+	if (!transcriptPath.empty() && !transcriptFile)
+	{
+		cout << "Unable to write " << transcriptPath << endl;
+		return 1;
+	}
+
+	// Ask parameters
+	string password;
+	int n, b;
+	char p;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the base of chain length (B^N). B = ";
+	cin >> b;
+	cout << "Type the exponent of chain length (" << b << "^N). N = ";
+	cin >> n;
+	cout << "Print intermediary hash values (y/n) ? ";
+	cin >> p;
+	removePwd();
+
+	// Get sha256 of password
+	int length = password.length();
+	uint8_t *source = new uint8_t[length];
+	for (int i=0; i<length; i++)
+		source[i] = password[i];
+	uint8_t hashBuf[32];
+	computeSHA256(source, length, hashBuf);
+	delete [] source;
+
+	// Calculate exponent
+	mpz_class limit;
+	mpz_ui_pow_ui (limit.get_mpz_t(), b, n);
+	if (!resumePath.empty())
+	{
+		if (memcmp(firstHash, hashBuf, 32) != 0 || limit < index)
+		{
+			cout << resumePath << " is not the start of this chain" << endl;
+			return 1;
+		}
+		cout << endl << "Resuming at hash " << index << endl;
+		memcpy(hashBuf, resumeHash, 32);
+	}
+	else
+		memcpy(firstHash, hashBuf, 32);
+	tuneSHA256();
+
+	// Run chain loop
+	cout << endl << "Generating sha256(sha256(sha256(...sha256(password)...)))" << endl;
+	cout << "If N is big, it will take a long time" << endl << endl;;
+	bool print = p == 'y' or p == 'Y';
+	if (print)
+	{
+		char line[64];
+		hexEncode(hashBuf, 32, line);
+		cout.write(line, 64) << endl;
+	}
+	string etaTotal;
+	PerfCounters perf;
+	if (counters)
+		perf.begin("chain", mpz_sizeinbase(limit.get_mpz_t(), 2) > 63 ? 0 : limit.get_ui() - 1, "hash");
+	mpz_class steps = limit - index, ran;
+
+	// This thread runs the chain; the helper threads started below are moved off its core by runChain()
+	string placed = applyPlacement(placement);
+	if (!placed.empty())
+	{
+		cout << placed << endl;
+		return 1;
+	}
+	if (placement.cpu >= 0)
+		cout << "Hashing on CPU " << placement.cpu << endl;
+
+	// Checkpoints and trace records stop before the last hash, which is the private key
+	uint64_t last = mpz_sizeinbase(limit.get_mpz_t(), 2) > 63 ? UINT64_MAX : limit.get_ui();
+	unique_ptr<HashTraceWriter> trace;
+	if (!tracePath.empty())
+	{
+		trace.reset(new HashTraceWriter(tracePath, traceEvery, index, last, hashBuf));
+		if (!trace->ok())
+		{
+			cout << "Unable to create " << tracePath << " (it must not exist yet)" << endl;
+			return 1;
+		}
+	}
+	if (transcriptFile)
+	{
+		TranscriptWriter transcript(transcriptFile.get(), every, index, last, hashBuf, resumePath.empty());
+		ran = runChain(hashBuf, index, steps, print, etaTotal, &transcript, trace.get());
+		transcriptFile.reset();
+	}
+	else
+		ran = runChain(hashBuf, index, steps, print, etaTotal, NULL, trace.get());
+	cout << endl;
+	if (trace)
+	{
+		bool written = trace->ok();
+		trace.reset();
+		if (!written)
+			cout << "Unable to write all of " << tracePath << endl;
+	}
+
+	// Stopped by a signal: without a transcript the checkpoint goes to a new one
+	if (ran < steps)
+	{
+		mpz_class at = ran + index;
+		if (transcriptPath.empty() && (transcriptPath = saveCheckpoint(firstHash, at, hashBuf)).empty())
+			return 1;
+		cout << "Stopped at hash " << at << " of " << limit << endl;
+		cout << "Resume with: ChainWallet create -r " << transcriptPath << endl;
+		return 1;
+	}
+
+	string extra = "Chain end state (hex)        - " + hash2str(hashBuf, 32) + " - It should be deleted\n";
+	if (finishWallet(password,b,n,hashBuf,etaTotal,extra,counters ? &perf : NULL).empty())
+		return 1;
+	if (counters)
+		cout << endl << perf.report();
+	return 0;
+}
+
+// Save the wallet of a job finished by the daemon. An empty address tells it the save failed.
+string finishJob(const ChainJob &job, const uint8_t end[32])
+{
+	string extra = "Chain end state (hex)        - " + hash2str(end, 32) + " - It should be deleted\n";
+	return finishWallet(job.password, job.b, job.n, end, toYDHMS((uint64_t)job.seconds), extra);
+}
+
+// Run chain jobs submitted on dir/socket. Wallets are saved in dir.
+// Usage: ChainWallet daemon <dir> [workers]
+int daemonCommand(int argc, char **argv)
+{
+	int workers = argc > 3 ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+	if (argc < 3 || argc > 4 || workers < 1)
+	{
+		cout << "Usage: ChainWallet daemon <dir> [workers]" << endl;
+		return 1;
+	}
+
+	// Job files hold passwords
+	umask(077);
+	mkdir(argv[2], 0700);
+	if (chdir(argv[2]) != 0)
+	{
+		cout << "Unable to use " << argv[2] << endl;
+		return 1;
+	}
+	tuneSHA256();
+	JobDaemon daemon(".", workers, finishJob);
+	if (!daemon.run())
+	{
+		cout << "Unable to listen on " << argv[2] << "/socket" << endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Print the events of a job until it ends
+bool watchJob(const string &socketPath, uint64_t id)
+{
+	return jobRequest(socketPath, id ? "WATCH " + to_string(id) : "WATCH", [](const string &line)
+	{
+		uint64_t j, done, total;
+		double rate, eta;
+		if (sscanf(line.c_str(), "PROGRESS %" SCNu64 " %" SCNu64 " %" SCNu64 " %lf %lf", &j, &done, &total, &rate, &eta) == 5)
+			cout << "Job " << j << ": " << done << " of " << total << " hashes, " << rate << " hash/s, remaining " <<
+			        (eta >= 0 ? toYDHMS((uint64_t)eta) : string("unknown")) << endl;
+		else
+			cout << line << endl;
+		return true;
+	});
+}
+
+// Queue a wallet on a daemon
+// Usage: ChainWallet submit <socket> [-p priority] [-d hours] [-w]
+int submitCommand(int argc, char **argv)
+{
+	int priority = 0;
+	int64_t deadline = 0;
+	bool watch = false, usage = argc < 3;
+	for (int i=3; i<argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "-w")
+			watch = true;
+		else if (arg == "-p" && i+1 < argc)
+			priority = atoi(argv[++i]);
+		else if (arg == "-d" && i+1 < argc)
+			deadline = time(NULL) + (int64_t)(atof(argv[++i]) * 3600);
+		else
+			usage = true;
+	}
+	if (usage)
+	{
+		cout << "Usage: ChainWallet submit <socket> [-p priority] [-d hours] [-w]" << endl;
+		return 1;
+	}
+
+	// Ask parameters
+	string password;
+	int n, b;
+	cout << "Type your brain wallet password: ";
+	getline(cin,password);
+	cout << "Type the base of chain length (B^N). B = ";
+	cin >> b;
+	cout << "Type the exponent of chain length (" << b << "^N). N = ";
+	cin >> n;
+	removePwd(3);
+
+	string hex = password.empty() ? "-" : hash2str((const uint8_t *)password.data(), password.size());
+	string request = "SUBMIT " + to_string(priority) + " " + to_string(deadline) + " " + to_string(b) + " " + to_string(n) + " " + hex;
+	uint64_t id = 0;
+	jobRequest(argv[2], request, [&id](const string &line)
+	{
+		sscanf(line.c_str(), "QUEUED %" SCNu64, &id);
+		return false;
+	});
+	if (id == 0)
+	{
+		cout << "The daemon on " << argv[2] << " did not take the job" << endl;
+		return 1;
+	}
+	cout << "Job " << id << " queued" << endl;
+	if (watch)
+		watchJob(argv[2], id);
+	return 0;
+}
+
+// List, watch or cancel the jobs of a daemon, or stop it
+// Usage: ChainWallet jobs <socket> [watch [id] | cancel <id> | shutdown]
+int jobsCommand(int argc, char **argv)
+{
+	string action = argc > 3 ? argv[3] : "list";
+	uint64_t id = argc > 4 ? strtoull(argv[4], NULL, 10) : 0;
+	if (argc < 3 || argc > 5 || (action == "cancel" && id == 0) ||
+	    (action != "list" && action != "watch" && action != "cancel" && action != "shutdown"))
+	{
+		cout << "Usage: ChainWallet jobs <socket> [watch [id] | cancel <id> | shutdown]" << endl;
+		return 1;
+	}
+	string socketPath = argv[2];
+	if (action == "watch")
+		return watchJob(socketPath, id) ? 0 : 1;
+	string request = action == "list" ? "LIST" : action == "cancel" ? "CANCEL " + to_string(id) : "SHUTDOWN";
+	bool ok = false;
+	bool sent = jobRequest(socketPath, request, [&ok](const string &line)
+	{
+		uint64_t j, done, total;
+		int priority;
+		int64_t deadline;
+		char status[16];
+		if (sscanf(line.c_str(), "JOB %" SCNu64 " %15s %d %" SCNd64 " %" SCNu64 " %" SCNu64, &j, status, &priority, &deadline, &done, &total) == 6)
+		{
+			cout << "Job " << j << " " << status << ", priority " << priority << ", " << done << " of " << total << " hashes";
+			if (deadline > 0)
+				cout << ", deadline in " << (deadline > time(NULL) ? toYDHMS(deadline - time(NULL)) : string("the past"));
+			cout << endl;
+		}
+		ok = line == "OK" || line == "END";
+		return !ok;
+	});
+	if (!sent || !ok)
+	{
+		cout << (sent ? "The daemon refused " : "No daemon on ") << (sent ? request : socketPath) << endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Run a command given on the command line
+int runCommand(int argc, char **argv)
+{
+	string cmd = argv[1];
+	if (cmd == "hd")
+		return hdCommand(argc, argv);
+	if (cmd == "krypt")
+		return kryptCommand(argc, argv);
+	if (cmd == "index")
+		return indexCommand(argc, argv);
+	if (cmd == "lookup")
+		return lookupCommand(argc, argv);
+	if (cmd == "selftest")
+		return selftestCommand(argc, argv);
+	if (cmd == "utxo-index")
+		return utxoIndexCommand(argc, argv);
+	if (cmd == "audit")
+		return auditCommand(argc, argv);
+	if (cmd == "verify")
+		return verifyCommand(argc, argv);
+	if (cmd == "timelock")
+		return timelockCommand(argc, argv);
+	if (cmd == "timelock-recover")
+		return timelockRecoverCommand(argc, argv);
+	if (cmd == "vdf")
+		return vdfCommand(argc, argv);
+	if (cmd == "lanes")
+		return lanesCommand(argc, argv);
+	if (cmd == "extend")
+		return extendCommand(argc, argv);
+	if (cmd == "create")
+		return createCommand(argc, argv);
+	if (cmd == "units")
+		return unitsCommand(argc, argv);
+	if (cmd == "worker")
+		return workerCommand(argc, argv);
+	if (cmd == "serve-units")
+		return serveUnitsCommand(argc, argv);
+	if (cmd == "merge")
+		return mergeCommand(argc, argv);
+	if (cmd == "status")
+		return statusCommand(argc, argv);
+	if (cmd == "trace")
+		return traceCommand(argc, argv);
+	if (cmd == "daemon")
+		return daemonCommand(argc, argv);
+	if (cmd == "submit")
+		return submitCommand(argc, argv);
+	if (cmd == "jobs")
+		return jobsCommand(argc, argv);
+	cout << "Usage: ChainWallet                                  create a wallet interactively" << endl;
+	cout << "       ChainWallet hd [count] [account]             show HD account keys and addresses of a mnemonic" << endl;
+	cout << "       ChainWallet krypt [-o output] file...        encrypt or decrypt files in Kryptonite format" << endl;
+	cout << "       ChainWallet index <dir> <passwords> <index>  index a directory of wallet files" << endl;
+	cout << "       ChainWallet lookup <index> <address>...      find the wallet file of an address" << endl;
+	cout << "       ChainWallet verify [-p passwords] file...    check saved wallets without the chain" << endl;
+	cout << "       ChainWallet selftest [rounds]                cross-check and time the hash backends" << endl;
+	cout << "       ChainWallet utxo-index <dump> <index>        index the addresses of a UTXO dump for audits" << endl;
+	cout << "       ChainWallet audit <index> [n] [accounts]     check mnemonics from stdin and n HD children of each for funds" << endl;
+	cout << "       ChainWallet timelock                         create a wallet locked by B^N modular squarings" << endl;
+	cout << "       ChainWallet timelock-recover <file.krypt>    solve the time-lock of a wallet and save its keys" << endl;
+	cout << "       ChainWallet vdf                              create a wallet with a proof of B^N squarings" << endl;
+	cout << "       ChainWallet lanes [K]                        create a wallet from K chains run on K threads" << endl;
+	cout << "       ChainWallet extend <file.krypt>              make the chain of a wallet longer" << endl;
+	cout << "       ChainWallet create [-t file] [-e n] [-c]     create a wallet, saving checkpoints every n hashes" << endl;
+	cout << "       ChainWallet create -r file [-e n] [-c]       go on with a stopped run from its last checkpoint" << endl;
+	cout << "       ChainWallet create [-b file] [-k n]          write every n-th hash of the chain to a binary trace" << endl;
+	cout << "       ChainWallet create [-P n] [-S] [-s p] [-m]   pin the hash thread (-S: keep its SMT sibling free)," << endl;
+	cout << "                                                    schedule it with -s fifo|batch or -n nice, mlock with -m" << endl;
+	cout << "       ChainWallet trace <file> [from [to]]         show the hashes of a binary trace" << endl;
+	cout << "       ChainWallet units <transcript> <spool> [n]   cut a transcript into work units of n checkpoints" << endl;
+	cout << "       ChainWallet worker <spool-or-socket>         verify work units until none is left" << endl;
+	cout << "       ChainWallet serve-units <spool> <socket> [t] hand out work units on a Unix socket" << endl;
+	cout << "                                                    requeue claims older than t seconds (default 3600)" << endl;
+	cout << "       ChainWallet merge <spool>                    confirm that all work units passed and join up" << endl;
+	cout << "       ChainWallet status [-p file] [pid...]        show running chains or save them for Prometheus" << endl;
+	cout << "       ChainWallet daemon <dir> [workers]           run queued chain jobs, saving wallets in dir" << endl;
+	cout << "       ChainWallet submit <socket> [options]        queue a wallet: -p priority, -d deadline in hours, -w watch" << endl;
+	cout << "       ChainWallet jobs <socket> [action] [id]      list jobs, or watch, cancel or shutdown" << endl;
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	// Commands
+	if (argc > 1)
+		return runCommand(argc, argv);
+	return createCommand(argc, argv);
+}
@@ -0,0 +1,122 @@
+#ifndef CHAINWALLET_H
+
+#define CHAINWALLET_H
+
+// C API of libchainwallet (make lib builds libchainwallet.a and libchainwallet.so).
+//
+// A chain engine hashes sha256(sha256(...sha256(password)...)) B^N times in bounded steps, so the
+// caller decides where the work runs and can interleave it with its own. An engine allocates nothing
+// after cw_engine_new and can be started again any number of times. Each engine is driven by one
+// thread at a time; cw_engine_poll and cw_engine_cancel may be called from any thread while it steps.
+// Different engines are independent.
+//
+// Functions returning int give CW_OK (0) or a negative CW_E* code unless stated otherwise.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define CW_API __attribute__((visibility("default")))
+#else
+#define CW_API
+#endif
+
+#define CW_OK			0
+#define CW_EINVAL		-1	// Bad argument
+#define CW_ERANGE		-2	// Chain longer than 2^64 hashes
+#define CW_EBUSY		-3	// Another thread is stepping the engine
+#define CW_ESTATE		-4	// Not allowed in the engine's current state
+#define CW_ESPACE		-5	// Output buffer too small
+#define CW_EIO			-6	// File could not be read or written
+#define CW_EEXIST		-7	// Output file exists and is not the input
+
+// Engine states
+#define CW_IDLE			0
+#define CW_RUNNING		1
+#define CW_FINISHED		2
+#define CW_CANCELLED	3
+
+// Address encodings of a compressed public key
+#define CW_ADDR_P2PKH		0	// 1...
+#define CW_ADDR_P2SH_P2WPKH	1	// 3...
+#define CW_ADDR_P2WPKH		2	// bc1q...
+
+typedef struct cw_engine cw_engine;
+typedef struct cw_krypt cw_krypt;
+
+typedef struct
+{
+	int state;			// CW_IDLE, CW_RUNNING, CW_FINISHED or CW_CANCELLED
+	uint64_t done;		// Hashes in the chain so far, counting sha256(password)
+	uint64_t total;		// Hashes in the whole chain (B^N)
+} cw_progress;
+
+// Everything saved in a wallet file, as text
+typedef struct
+{
+	char privateKey[65];		// Hex, the chain end reduced modulo the curve order
+	char wif[53];				// Compressed WIF
+	char publicKey[67];			// Compressed, hex
+	char p2pkh[36];
+	char p2shP2wpkh[36];
+	char p2wpkh[64];
+	char mnemonic[24*9];		// BIP39, 24 words
+	uint8_t seed[64];			// BIP39 seed with an empty passphrase
+} cw_keys;
+
+// Library version, e.g. "1.0"
+CW_API const char *cw_version(void);
+
+// Pick the fastest SHA-256 kernel for this CPU, remembered in cacheFile (may be NULL).
+// Process wide: call it before any engine runs. Returns the name of the kernel in use.
+CW_API const char *cw_sha256_autotune(const char *cacheFile);
+
+// Engines
+CW_API cw_engine *cw_engine_new(void);
+CW_API void cw_engine_free(cw_engine *engine);
+
+// Begin the chain of a password with B^N hashes. The first hash is taken here, so done is 1.
+CW_API int cw_engine_start(cw_engine *engine, const void *password, size_t len, unsigned b, unsigned n);
+
+// Continue a chain from a saved state: state is hash number done of a chain of total hashes
+CW_API int cw_engine_resume(cw_engine *engine, const uint8_t state[32], uint64_t done, uint64_t total);
+
+// Hash at most maxHashes more (0 means until the end). Returns the state afterwards:
+// CW_RUNNING if hashes are left, CW_FINISHED, CW_CANCELLED, or a negative error.
+CW_API int cw_engine_step(cw_engine *engine, uint64_t maxHashes);
+
+// Progress of the engine. Returns its state. Safe while another thread steps.
+CW_API int cw_engine_poll(const cw_engine *engine, cw_progress *progress);
+
+// Make a running step return CW_CANCELLED within a few thousand hashes. Safe from any thread.
+CW_API void cw_engine_cancel(cw_engine *engine);
+
+// Current hash of the chain and its number, e.g. for a checkpoint. Fails with CW_EBUSY while stepping.
+CW_API int cw_engine_state(cw_engine *engine, uint8_t state[32], uint64_t *done);
+
+// Keys and addresses of a chain end state
+CW_API int cw_derive_keys(const uint8_t state[32], cw_keys *keys);
+
+// Encode a 33 byte compressed public key as an address of the given type into out (size bytes)
+CW_API int cw_address(const uint8_t pub[33], int type, char *out, size_t size);
+
+// Kryptonite, the format of the wallet files. Encryption and decryption are the same operation.
+CW_API cw_krypt *cw_krypt_new(const void *password, size_t len);
+CW_API void cw_krypt_free(cw_krypt *key);
+
+// XOR len bytes that sit at offset in the stream. source and destination may be the same buffer.
+CW_API void cw_krypt_apply(const cw_krypt *key, uint64_t offset, const void *source, void *destination, size_t len);
+
+// Whole file; output "-" is stdout and may be the input file, in place. An existing output that is
+// another file is never replaced (CW_EEXIST).
+CW_API int cw_krypt_file(const cw_krypt *key, const char *input, const char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif